@@ -0,0 +1,100 @@
+/*@copyright
+
+Copyright (c) 2012 Aiguo Fei
+All rights reserved.
+
+Permission to use and re-distribute this code in source and binary forms
+with or without modifications is therefore granted provided that
+the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Information regarding where to obtain the original source code must be
+      included with the redistrbution.
+
+*NO WARRANTY*
+THIS CODE OR PROGRAM IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S)
+"AS IS" WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE. THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S) MUST NOT BE
+HELD RESPONSIBLE FOR ANY DAMAGE OR UNDESIRED EFFECT CAUSED DIRECTLY OR
+INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
+
+*/
+
+
+/* b_allsp.cpp
+
+  benchmark: all pairs shortest paths (hop count) on the AS graphs,
+  floyd_warshall_allsp( ) vs. dijkstra_allsp( ) on 1, 2, 4, ... threads
+  up to the number of hardware threads. Run from this directory.
+
+*/
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <thread>
+
+#include "afl/util_tl.hpp"
+
+#include "afgraph/graph.h"
+#include "afgraph/shortest_path.h"
+#include "research/import_asconnect.h"
+
+#include "bench_util.h"
+
+using namespace std;
+using namespace afg;
+
+typedef CGraph<int, int> GT;
+typedef afl::runit_p<int> FW;
+
+int main()
+{
+	const char *files[] = { "ASconnlist.19980105.txt", "ASconnlist.20000101.txt" };
+	int nhw = ( int )std::thread::hardware_concurrency();
+	for( int f = 0; f < 2; ++f ) {
+		string fname = string( "../../net_topology/" ) + files[f];
+		ifstream fs( fname.c_str() );
+		if( !fs ) {
+			cout << "failed to open " << fname << ", run from the bench/afgraph directory." << endl;
+			return 1;
+		}
+		GT gra( 16, -1 );
+		import_asconnect( gra, fs );
+		gra.pack();
+		int n = gra.range();
+		cout << files[f] << ": " << n << " nodes" << endl;
+
+		vector<int> vp0, vd0;
+		// O(n^3): only on the smaller graph; w_infty + w_infty must not
+		// overflow for floyd_warshall_allsp( )
+		if( f == 0 ) {
+			CbTimer tm;
+			floyd_warshall_allsp( gra, FW(), 1 << 20, vp0, vd0 );
+			cout << "  floyd_warshall_allsp: " << tm.ms() << " ms" << endl;
+		}
+		double t1 = 0;
+		for( int nt = 1; nt <= ( nhw > 1 ? nhw : 1 ); nt *= 2 ) {
+			vector<int> vp, vd;
+			afl::thread_pool pool( nt );
+			CbTimer tm;
+			dijkstra_allsp( gra, FW(), 1 << 20, vp, vd, pool );
+			double t = tm.ms();
+			if( nt == 1 ) {
+				t1 = t;
+			}
+			cout << "  dijkstra_allsp, " << nt << " threads: " << t << " ms, speedup "
+				 << t1 / t;
+			if( !vp0.empty() ) {
+				cout << ( vp == vp0 && vd == vd0 ? ", same" : ", DIFFERENT" );
+			}
+			cout << endl;
+		}
+	}
+	return 0;
+}
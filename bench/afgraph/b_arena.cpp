@@ -0,0 +1,201 @@
+/*@copyright
+
+Copyright (c) 2012 Aiguo Fei
+All rights reserved.
+
+Permission to use and re-distribute this code in source and binary forms
+with or without modifications is therefore granted provided that
+the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Information regarding where to obtain the original source code must be
+      included with the redistrbution.
+
+*NO WARRANTY*
+THIS CODE OR PROGRAM IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S)
+"AS IS" WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE. THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S) MUST NOT BE
+HELD RESPONSIBLE FOR ANY DAMAGE OR UNDESIRED EFFECT CAUSED DIRECTLY OR
+INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
+
+*/
+
+
+
+/* b_arena.cpp
+
+  benchmark: building many short-lived shortest path trees on ts100-0.alt
+  with the default allocator vs. an afl::arena (reset after each tree).
+  Shortest paths from every source are computed once up front, so the
+  timings are those of building (and destroying) the trees.
+  Run from this directory.
+
+*/
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <cstdlib>
+#include <new>
+
+#include "afl/arena.hpp"
+#include "afl/util_tl.hpp"
+
+#include "afgraph/graph.h"
+#include "afgraph/rtree.h"
+#include "afgraph/vertex.h"
+#include "afgraph/shortest_path.h"
+#include "afgraph/tree_util.h"
+#include "research/import_gitalt.h"
+
+#include "bench_util.h"
+
+using namespace std;
+using namespace afg;
+
+// count calls to operator new
+static long g_nNews = 0;
+
+void *operator new( size_t n )
+{
+	++g_nNews;
+	void *p = malloc( n ? n : 1 );
+	if( !p ) {
+		throw std::bad_alloc();
+	}
+	return p;
+}
+
+// out of line: inlined into the containers, free( ) of a pointer from
+// operator new reads as a mismatch to GCC (-Wmismatched-new-delete)
+#if defined(__GNUC__)
+#define B_NOINLINE __attribute__(( noinline ))
+#else
+#define B_NOINLINE
+#endif
+
+B_NOINLINE void operator delete( void *p ) noexcept
+{
+	free( p );
+}
+
+// the sized form, used from C++14 on
+B_NOINLINE void operator delete( void *p, size_t ) noexcept
+{
+	free( p );
+}
+
+typedef CGraph<tsVertex, int> GT;
+typedef afl::arena_allocator<char> AT;
+
+// preds and dists from every source
+struct sp_all {
+	vector< vector<int> > vpred;
+	vector< vector<int> > vdist;
+};
+
+template<class TreeT>
+long build_s( const sp_all &sp, int ntrees, afl::arena *par,
+			  const typename TreeT::allocator_type &a )
+{
+	long sum = 0;
+	int n = ( int )sp.vpred.size();
+	for( int k = 0; k < ntrees; ++k ) {
+		{
+			TreeT tr( n, -1, 0.25, std::equal_to<int>(),
+					  a );
+			pred2tree_s( sp.vpred[k % n], sp.vdist[k % n], tr );
+			sum += tr.size();
+		}
+		if( par ) {
+			par->reset();
+		}
+	}
+	return sum;
+}
+
+template<class TreeT>
+long build_full( const GT &gra, const sp_all &sp, int ntrees, afl::arena *par,
+				 const typename TreeT::allocator_type &a )
+{
+	long sum = 0;
+	int n = ( int )sp.vpred.size();
+	for( int k = 0; k < ntrees; ++k ) {
+		{
+			TreeT tr( n, tsVertex(), 0.25, std::equal_to<tsVertex>(),
+					  a );
+			pred2tree( gra, sp.vpred[k % n], tr );
+			sum += tr.size();
+		}
+		if( par ) {
+			par->reset();
+		}
+	}
+	return sum;
+}
+
+template<class F>
+void run( const char *name, F f )
+{
+	long n0 = g_nNews;
+	CbTimer tm;
+	long sum = f();
+	double t = tm.ms();
+	cout << "  " << name << ": " << t << " ms, " << g_nNews - n0
+		 << " allocations (check " << sum << ")" << endl;
+}
+
+int main()
+{
+	const int ntrees = 10000;
+	GT gra( 100, tsVertex() );
+	ifstream fs( "../../test/research/ts100-0.alt" );
+	if( !fs || !import_gitalt_ts( gra, fs ) ) {
+		cout << "failed to read ../../test/research/ts100-0.alt, run from the bench/afgraph directory." << endl;
+		return 1;
+	}
+	gra.pack();
+
+	sp_all sp;
+	sp.vpred.resize( gra.range() );
+	sp.vdist.resize( gra.range() );
+	for( int s = 0; s < gra.range(); ++s ) {
+		dijkstra( gra, s, afl::pointer2value<int>(), 1 << 30, sp.vpred[s], sp.vdist[s] );
+	}
+	cout << "ts100-0.alt: " << gra.size() << " nodes, " << ntrees << " trees" << endl;
+
+	afl::arena ar;
+	typedef CrTree<int, int> ST;
+	typedef CrTree<int, int, std::equal_to<int>, no_hash, elist_policy, AT> AST;
+	typedef CrTree<int, int, std::equal_to<int>, no_hash, evector_policy> SVT;
+	typedef CrTree<int, int, std::equal_to<int>, no_hash, evector_policy, AT> ASVT;
+	typedef CrTree<tsVertex, int> FT;
+	typedef CrTree<tsVertex, int, std::equal_to<tsVertex>, no_hash, elist_policy, AT> AFT;
+
+	cout << "simple trees (pred2tree_s):" << endl;
+	run( "list, std::allocator  ", [&]() {
+		return build_s<ST>( sp, ntrees, NULL, std::allocator<char>() );
+	} );
+	run( "list, arena           ", [&]() {
+		return build_s<AST>( sp, ntrees, &ar, AT( &ar ) );
+	} );
+	run( "vector, std::allocator", [&]() {
+		return build_s<SVT>( sp, ntrees, NULL, std::allocator<char>() );
+	} );
+	run( "vector, arena         ", [&]() {
+		return build_s<ASVT>( sp, ntrees, &ar, AT( &ar ) );
+	} );
+	cout << "full trees (pred2tree):" << endl;
+	run( "list, std::allocator  ", [&]() {
+		return build_full<FT>( gra, sp, ntrees, NULL, std::allocator<char>() );
+	} );
+	run( "list, arena           ", [&]() {
+		return build_full<AFT>( gra, sp, ntrees, &ar, AT( &ar ) );
+	} );
+	cout << "arena: " << ar.n_blocks() << " blocks, " << ar.capacity() << " bytes" << endl;
+	return 0;
+}
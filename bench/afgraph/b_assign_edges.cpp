@@ -0,0 +1,82 @@
+/*@copyright
+
+Copyright (c) 2012 Aiguo Fei
+All rights reserved.
+
+Permission to use and re-distribute this code in source and binary forms
+with or without modifications is therefore granted provided that
+the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Information regarding where to obtain the original source code must be
+      included with the redistrbution.
+
+*NO WARRANTY*
+THIS CODE OR PROGRAM IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S)
+"AS IS" WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE. THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S) MUST NOT BE
+HELD RESPONSIBLE FOR ANY DAMAGE OR UNDESIRED EFFECT CAUSED DIRECTLY OR
+INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
+
+*/
+
+
+
+/* b_assign_edges.cpp
+
+  benchmark: loading edges one by one with insert_e_byi( ) versus
+  CGraph::assign_edges( ), on random edge lists with duplicates.
+
+*/
+
+#include <iostream>
+#include <vector>
+
+#include "afgraph/graph.h"
+
+#include "bench_util.h"
+
+using namespace std;
+using namespace afg;
+
+int main()
+{
+	typedef CGraph<int, int> GT;
+	// nodes, edges (average degree grows)
+	const int sizes[][2] = { { 10000, 100000 }, { 10000, 400000 }, { 50000, 1000000 } };
+	for( int s = 0; s < 3; ++s ) {
+		int n = sizes[s][0], m = sizes[s][1];
+		CbRand rnd( 31 );
+		vector< CeTuple<int> > vte;
+		vte.reserve( m );
+		for( int k = 0; k < m; ++k ) {
+			vte.push_back( CeTuple<int>( rnd.next( n ), rnd.next( n ), 1 + rnd.next( 100 ) ) );
+		}
+		GT g1( n, -1 ), g2( n, -1 );
+		for( int i = 0; i < n; ++i ) {
+			g1.insert_v_ati( i, i );
+			g2.insert_v_ati( i, i );
+		}
+		CbTimer tm;
+		for( size_t k = 0; k < vte.size(); ++k ) {
+			g1.insert_e_byi( vte[k].from, vte[k].to, vte[k].edge );
+		}
+		double t1 = tm.ms();
+		tm.start();
+		int ne = g2.assign_edges( vte.begin(), vte.end() );
+		double t2 = tm.ms();
+		int ne1 = 0;
+		for( int i = 0; i < n; ++i ) {
+			ne1 += g1[i].out_degree();
+		}
+		cout << n << " nodes, " << m << " tuples, " << ne << " edges: insert_e_byi "
+			 << t1 << " ms, assign_edges " << t2 << " ms, speedup " << t1 / t2
+			 << ( ne == ne1 ? "" : " (MISMATCH)" ) << endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,112 @@
+/*@copyright
+
+Copyright (c) 2012 Aiguo Fei
+All rights reserved.
+
+Permission to use and re-distribute this code in source and binary forms
+with or without modifications is therefore granted provided that
+the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Information regarding where to obtain the original source code must be
+      included with the redistrbution.
+
+*NO WARRANTY*
+THIS CODE OR PROGRAM IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S)
+"AS IS" WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE. THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S) MUST NOT BE
+HELD RESPONSIBLE FOR ANY DAMAGE OR UNDESIRED EFFECT CAUSED DIRECTLY OR
+INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
+
+*/
+
+
+/* b_astar.cpp
+
+  benchmark: A* (astar( )) vs. dijkstra_t( ) full and early exit search
+  on random pairs of a large grid (Manhattan and Euclidean heuristics)
+  and of a Waxman graph (Euclidean heuristic, edge weight = distance).
+  Reports time and nodes settled per query.
+
+*/
+
+#include <iostream>
+#include <cstddef>
+
+#include "afl/util_tl.hpp"
+
+#include "afgraph/graph.h"
+#include "afgraph/vertex.h"
+#include "afgraph/graph_gen.h"
+#include "afgraph/shortest_path.h"
+#include "afgraph/astar.h"
+
+#include "bench_util.h"
+
+using namespace std;
+using namespace afg;
+
+// hash for xyVertex<int>, so that grid_graph_gen( ) finds vertices fast
+struct xy_hash {
+	size_t operator()( const xyVertex<int> &v ) const {
+		return ( size_t )v.x() * 1000003u + ( size_t )v.y();
+	}
+};
+
+template<class GraphT, class WeightT>
+void run( const char *name, const GraphT &g, WeightT w_infty, int npairs )
+{
+	typedef afl::pointer2value<WeightT> FW;
+	const char *names[] = { "full", "early exit", "A*, Euclidean", "A*, Manhattan" };
+	int n = g.range();
+	cout << name << ": " << n << " nodes, " << npairs << " pairs" << endl;
+	double dsum0 = 0;
+	for( int m = 0; m < 4; ++m ) {
+		CbRand rnd( 7 );
+		double dsum = 0;
+		long nset = 0;
+		CPath lp;
+		CbTimer tm;
+		for( int k = 0; k < npairs; ++k ) {
+			int s = rnd.next( n ), t = rnd.next( n ), ns = 0;
+			switch( m ) {
+			case 0:
+				dsum += dijkstra_t( g, s, t, FW(), w_infty, lp, sp_options(), &ns );
+				break;
+			case 1:
+				dsum += dijkstra_t( g, s, t, FW(), w_infty, lp, sp_options::sp_early_exit, &ns );
+				break;
+			case 2:
+				dsum += astar( g, s, t, FW(), w_infty, euclid_heuristic<WeightT>(), lp, &ns );
+				break;
+			default:
+				dsum += astar( g, s, t, FW(), w_infty, manhattan_heuristic<WeightT>(), lp, &ns );
+			}
+			nset += ns;
+		}
+		double t = tm.ms();
+		if( m == 0 ) {
+			dsum0 = dsum;
+		}
+		// Manhattan distance overestimates on the Waxman graph: not admissible
+		bool exact = dsum - dsum0 < 1e-6 * dsum0 && dsum0 - dsum < 1e-6 * dsum0;
+		cout << "  " << names[m] << ": " << t / npairs << " ms/query, "
+			 << nset / npairs << " settled/query" << ( exact ? "" : ", DIFFERENT" ) << endl;
+	}
+}
+
+int main()
+{
+	CGraph<xyVertex<int>, int, std::equal_to<xyVertex<int> >, xy_hash> grid( 300 * 300 );
+	grid_graph_gen( grid, 300, 300 );
+	run( "grid 300x300", grid, 1 << 30, 200 );
+
+	CGraph<xyVertex<int>, double> bmw( 800 );
+	bmw_graph_gen( bmw, 1000, 800, 10, 0.05, 0.3 );
+	run( "Waxman, sparse", bmw, 1e30, 500 );
+	return 0;
+}
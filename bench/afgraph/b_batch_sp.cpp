@@ -0,0 +1,111 @@
+/*@copyright
+
+Copyright (c) 2012 Aiguo Fei
+All rights reserved.
+
+Permission to use and re-distribute this code in source and binary forms
+with or without modifications is therefore granted provided that
+the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Information regarding where to obtain the original source code must be
+      included with the redistrbution.
+
+*NO WARRANTY*
+THIS CODE OR PROGRAM IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S)
+"AS IS" WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE. THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S) MUST NOT BE
+HELD RESPONSIBLE FOR ANY DAMAGE OR UNDESIRED EFFECT CAUSED DIRECTLY OR
+INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
+
+*/
+
+
+
+/* b_batch_sp.cpp
+
+  benchmark: a batch of (source, destination) pairs, 20 sources with 1000
+  random destinations each, on a random graph of 100000 nodes: one
+  dijkstra_t( ) per pair (full search, and early exit with a workspace;
+  timed on the first pairs only) against dijkstra_batch( ), which
+  searches once per source, on one thread and on all.
+
+*/
+
+#include <iostream>
+#include <vector>
+#include <utility>
+
+#include "afl/util_tl.hpp"
+
+#include "afgraph/graph.h"
+#include "afgraph/shortest_path.h"
+
+#include "bench_util.h"
+
+using namespace std;
+using namespace afg;
+
+typedef CGraph<int, int> GT;
+typedef afl::pointer2value<int> FW;
+
+int main()
+{
+	const int n = 100000, nsrc = 20, ndst = 1000, nsample = 50;
+	GT gra( n, -1 );
+	bench_random_graph( gra, n, 4 * n, 100 );
+	CbRand rnd( 5 );
+	vector<int> vsrc( nsrc );
+	for( int i = 0; i < nsrc; ++i ) {
+		vsrc[i] = rnd.next( n );
+	}
+	// sources interleaved, as queries come in
+	vector< pair<int, int> > pairs;
+	for( int k = 0; k < nsrc * ndst; ++k ) {
+		pairs.push_back( make_pair( vsrc[rnd.next( nsrc )], rnd.next( n ) ) );
+	}
+	int np = ( int )pairs.size();
+	cout << "random graph, " << n << " nodes, " << 4 * n << " edges, " << np
+		 << " pairs from " << nsrc << " sources" << endl;
+
+	vector<int> vd0( nsample );
+	for( int m = 0; m < 2; ++m ) {
+		CSPWorkspace<int> ws;
+		CPath lp;
+		CbTimer tm;
+		for( int q = 0; q < nsample; ++q ) {
+			int d = m == 0 ? dijkstra_t( gra, pairs[q].first, pairs[q].second, FW(), 1 << 30, lp )
+					: dijkstra_t( gra, pairs[q].first, pairs[q].second, FW(), 1 << 30, lp, ws,
+								  sp_options::sp_early_exit );
+			if( m == 0 ) {
+				vd0[q] = d;
+			} else if( d != vd0[q] ) {
+				cout << "  DIFFERENT at pair " << q << endl;
+			}
+		}
+		double t = tm.ms() / nsample;
+		cout << "  dijkstra_t" << ( m == 0 ? "" : ", early exit" ) << ": " << t
+			 << " ms/pair, " << t * np << " ms for all (estimated)" << endl;
+	}
+
+	const int nts[] = { 1, 0 };
+	for( int m = 0; m < 2; ++m ) {
+		afl::thread_pool pool( nts[m] );
+		vector<CPath> vp;
+		vector<int> vd;
+		CbTimer tm;
+		int nfound = dijkstra_batch( gra, FW(), 1 << 30, pairs, vp, vd, pool );
+		double t = tm.ms();
+		bool same = true;
+		for( int q = 0; q < nsample; ++q ) {
+			same = same && vd[q] == vd0[q];
+		}
+		cout << "  dijkstra_batch, " << pool.size() << " threads: " << t << " ms, "
+			 << nfound << " paths" << ( same ? "" : ", DIFFERENT" ) << endl;
+	}
+	return 0;
+}
@@ -0,0 +1,162 @@
+/*@copyright
+
+Copyright (c) 2012 Aiguo Fei
+All rights reserved.
+
+Permission to use and re-distribute this code in source and binary forms
+with or without modifications is therefore granted provided that
+the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Information regarding where to obtain the original source code must be
+      included with the redistrbution.
+
+*NO WARRANTY*
+THIS CODE OR PROGRAM IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S)
+"AS IS" WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE. THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S) MUST NOT BE
+HELD RESPONSIBLE FOR ANY DAMAGE OR UNDESIRED EFFECT CAUSED DIRECTLY OR
+INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
+
+*/
+
+
+
+
+/* b_bfs_sp.cpp
+
+  benchmark: shortest paths by hop count (afl::runit_p) from random
+  sources, by Dijkstra with Dial's buckets (what dijkstra( ) did before),
+  by breadth-first search with top-down steps only (bfs_sp( ) on a graph
+  without in-edge index) and by direction-optimizing search (CspBfs,
+  in-edges from the in-edge index or from a transposed copy), on the AS
+  graph of 2000/01/01 and on scale-free (preferential attachment)
+  graphs. Run from this directory.
+
+*/
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "afl/util_tl.hpp"
+
+#include "afgraph/graph.h"
+#include "afgraph/shortest_path.h"
+#include "afgraph/bfs_sp.h"
+#include "research/import_asconnect.h"
+
+#include "bench_util.h"
+
+using namespace std;
+using namespace afg;
+
+typedef afl::runit_p<int> FW;
+
+// scale-free graph: each new node links (both ways) to k nodes picked
+// with probability proportional to their degree (Barabasi-Albert)
+template<class GraphT>
+void scale_free_graph( GraphT &gra, int n, int k )
+{
+	CbRand rnd( 17 );
+	gra.clear();
+	gra.reserve( n );
+	// each node once per link end
+	vector<int> vends;
+	for( int i = 0; i < n; ++i ) {
+		gra.insert_v_ati( i, i );
+		int nl = i < k ? i : k;
+		for( int l = 0; l < nl; ++l ) {
+			int j = vends.empty() ? rnd.next( i ) : vends[rnd.next( ( int )vends.size() )];
+			if( j != i && gra.get_edge_byi( i, j ) == NULL ) {
+				gra.insert_e_byi( i, j, 1 );
+				gra.insert_e_byi( j, i, 1 );
+				vends.push_back( i );
+				vends.push_back( j );
+			}
+		}
+	}
+}
+
+template<class GraphT>
+void run( GraphT &gra, int nsrc )
+{
+	int n = gra.range();
+	vector<int> vs;
+	CbRand rnd( 5 );
+	for( int k = 0; k < nsrc; ++k ) {
+		vs.push_back( rnd.next( n ) );
+	}
+	vector<int> p0, d0, p, d;
+	long long sum0 = 0;
+	CbTimer tm;
+	for( int k = 0; k < nsrc; ++k ) {
+		dijkstra_dial( gra, vs[k], FW(), 1 << 30, p0, d0, 1 );
+		for( int i = 0; i < n; ++i ) {
+			sum0 += d0[i];
+		}
+	}
+	double t0 = tm.ms() / nsrc;
+	cout << "  dijkstra_dial: " << t0 << " ms" << endl;
+
+	const char *names[] = { "bfs_sp, top-down only", "CspBfs, transposed copy",
+							"CspBfs, in-edge index"
+						  };
+	for( int m = 0; m < 3; ++m ) {
+		if( m == 2 ) {
+			gra.enable_in_index();
+		}
+		tm.start();
+		CspBfs<GraphT> bfs( gra, m == 1 );
+		double tb = tm.ms();
+		long long sum = 0;
+		int nlevel = 0, nup = 0;
+		tm.start();
+		for( int k = 0; k < nsrc; ++k ) {
+			bfs.run( vs[k], 1 << 30, p, d );
+			nlevel += bfs.levels();
+			nup += bfs.bottom_up_levels();
+			for( int i = 0; i < n; ++i ) {
+				sum += d[i];
+			}
+		}
+		double t = tm.ms() / nsrc;
+		cout << "  " << names[m] << ": " << t << " ms, speedup " << t0 / t;
+		if( m == 1 ) {
+			cout << " (copy made in " << tb << " ms)";
+		}
+		cout << ", " << nup << " of " << nlevel << " levels bottom-up"
+			 << ( sum == sum0 ? "" : ", DIFFERENT" ) << endl;
+	}
+	gra.enable_in_index( false );
+}
+
+int main()
+{
+	{
+		const char *file = "../../net_topology/ASconnlist.20000101.txt";
+		ifstream fs( file );
+		if( !fs ) {
+			cout << "failed to open " << file << ", run from the bench/afgraph directory." << endl;
+			return 1;
+		}
+		CGraph<int, int> gra( 16, -1 );
+		import_asconnect( gra, fs );
+		gra.pack();
+		cout << "ASconnlist.20000101: " << gra.range() << " nodes, 200 sources" << endl;
+		run( gra, 200 );
+	}
+	const int ns[] = { 100000, 1000000 };
+	for( int k = 0; k < 2; ++k ) {
+		CGraph<int, int, std::equal_to<int>, no_hash, evector_policy> gra( ns[k], -1 );
+		scale_free_graph( gra, ns[k], 8 );
+		cout << "scale-free, " << ns[k] << " nodes, 8 links per new node, 20 sources" << endl;
+		run( gra, 20 );
+	}
+	return 0;
+}
@@ -0,0 +1,122 @@
+/*@copyright
+
+Copyright (c) 2012 Aiguo Fei
+All rights reserved.
+
+Permission to use and re-distribute this code in source and binary forms
+with or without modifications is therefore granted provided that
+the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Information regarding where to obtain the original source code must be
+      included with the redistrbution.
+
+*NO WARRANTY*
+THIS CODE OR PROGRAM IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S)
+"AS IS" WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE. THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S) MUST NOT BE
+HELD RESPONSIBLE FOR ANY DAMAGE OR UNDESIRED EFFECT CAUSED DIRECTLY OR
+INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
+
+*/
+
+
+/* b_ch_index.cpp
+
+  benchmark: point to point queries (hop count) on the AS graphs by a
+  contraction hierarchy (ch_index.h) vs. dijkstra_t( ) with early exit
+  and a workspace: preprocessing time and size, saving and loading the
+  index, and time per query (with the path unpacked). Run from this
+  directory.
+
+*/
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "afl/util_tl.hpp"
+
+#include "afgraph/graph.h"
+#include "afgraph/shortest_path.h"
+#include "afgraph/ch_index.h"
+#include "research/import_asconnect.h"
+
+#include "bench_util.h"
+
+using namespace std;
+using namespace afg;
+
+typedef CGraph<int, int> GT;
+typedef afl::runit_p<int> FW;
+
+int main()
+{
+	const char *files[] = { "ASconnlist.19980105.txt", "ASconnlist.19990112.txt",
+							"ASconnlist.20000101.txt"
+						  };
+	const int nq = 100000;
+	for( int f = 0; f < 3; ++f ) {
+		string fname = string( "../../net_topology/" ) + files[f];
+		ifstream fs( fname.c_str() );
+		if( !fs ) {
+			cout << "failed to open " << fname << ", run from the bench/afgraph directory." << endl;
+			return 1;
+		}
+		GT gra( 16, -1 );
+		import_asconnect( gra, fs );
+		gra.pack();
+		int n = gra.range();
+		cout << files[f] << ": " << n << " nodes" << endl;
+
+		CbTimer tm;
+		CchIndex<int> idx;
+		idx.build( gra, FW(), 1 << 30 );
+		cout << "  build: " << tm.ms() << " ms, " << idx.size_e() << " edges" << endl;
+		stringstream ss;
+		tm.start();
+		idx.save( ss );
+		double tsave = tm.ms();
+		CchIndex<int> idx2;
+		tm.start();
+		idx2.load( ss );
+		cout << "  save: " << tsave << " ms, load: " << tm.ms() << " ms, "
+			 << ss.str().size() / 1024 << " KB" << endl;
+
+		CbRand rnd( 7 );
+		vector<int> vs( nq ), vt( nq );
+		for( int k = 0; k < nq; ++k ) {
+			vs[k] = rnd.next( n );
+			vt[k] = rnd.next( n );
+		}
+		CchQuery<int> q( idx2 );
+		CPath lp;
+		// lengths of the first nd paths, to compare
+		const int nd = nq / 10;
+		long dsum0 = 0, dsum1 = 0, nhop = 0;
+		tm.start();
+		for( int k = 0; k < nq; ++k ) {
+			int d = q.query( vs[k], vt[k], lp );
+			dsum1 += k < nd ? d : 0;
+			nhop += ( long )lp.size();
+		}
+		double t1 = tm.ms() * 1000 / nq;
+		CSPWorkspace<int> ws;
+		tm.start();
+		for( int k = 0; k < nd; ++k ) {
+			dsum0 += dijkstra_t( gra, vs[k], vt[k], FW(), 1 << 30, lp, ws,
+								 sp_options::sp_early_exit );
+		}
+		double t0 = tm.ms() * 1000 / nd;
+		cout << "  query: dijkstra_t " << t0 << " us, hierarchy " << t1 << " us ("
+			 << nhop / nq << " nodes per path), speedup " << t0 / t1
+			 << ( dsum0 == dsum1 ? "" : ", DIFFERENT" ) << endl;
+	}
+	return 0;
+}
@@ -0,0 +1,122 @@
+/*@copyright
+
+Copyright (c) 2012 Aiguo Fei
+All rights reserved.
+
+Permission to use and re-distribute this code in source and binary forms
+with or without modifications is therefore granted provided that
+the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Information regarding where to obtain the original source code must be
+      included with the redistrbution.
+
+*NO WARRANTY*
+THIS CODE OR PROGRAM IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S)
+"AS IS" WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE. THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S) MUST NOT BE
+HELD RESPONSIBLE FOR ANY DAMAGE OR UNDESIRED EFFECT CAUSED DIRECTLY OR
+INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
+
+*/
+
+
+
+/* b_csr_graph.cpp
+
+  benchmark: CGraph (list adjacency) vs. its CcsrGraph snapshot,
+  on the AS graph of 2000/01/01 and on a random graph of 100k edges.
+  Run from this directory.
+
+*/
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+
+#include "afl/util_tl.hpp"
+
+#include "afgraph/graph.h"
+#include "afgraph/csr_graph.h"
+#include "afgraph/graph_alg.h"
+#include "afgraph/shortest_path.h"
+#include "research/import_asconnect.h"
+
+#include "bench_util.h"
+
+using namespace std;
+using namespace afg;
+
+template<class GT>
+double time_scan( const GT &gra, int nrep, long &cost )
+{
+	CbTimer tm;
+	cost = 0;
+	for( int r = 0; r < nrep; ++r ) {
+		cost += graph_cost( gra, afl::pointer2value<int>() );
+	}
+	return tm.ms();
+}
+
+template<class GT>
+double time_dijkstra( const GT &gra, int nsrc, vector<int> &vpred, vector<int> &vdist )
+{
+	CbTimer tm;
+	for( int s = 0; s < nsrc; ++s ) {
+		dijkstra( gra, s * ( gra.range() / nsrc ), afl::pointer2value<int>(),
+				  1 << 30, vpred, vdist );
+	}
+	return tm.ms();
+}
+
+template<class GT>
+void compare( const char *name, const GT &gra, int nscan, int nsrc )
+{
+	typedef CcsrGraph<typename GT::VDT, typename GT::EDT> CT;
+	CbTimer tm;
+	CT csr( gra );
+	double tf = tm.ms();
+
+	long c1, c2;
+	double ts1 = time_scan( gra, nscan, c1 );
+	double ts2 = time_scan( csr, nscan, c2 );
+
+	int n = gra.range();
+	vector<int> vp1( n ), vd1( n ), vp2( n ), vd2( n );
+	double td1 = time_dijkstra( gra, nsrc, vp1, vd1 );
+	double td2 = time_dijkstra( csr, nsrc, vp2, vd2 );
+
+	cout << name << ": " << gra.size() << " nodes, " << csr.n_edges() << " edges" << endl
+		 << "  freeze:                 " << tf << " ms" << endl
+		 << "  edge scan x" << nscan << ":  CGraph " << ts1 << " ms, CcsrGraph "
+		 << ts2 << " ms, speedup " << ts1 / ts2 << ( c1 == c2 ? "" : " (MISMATCH)" ) << endl
+		 << "  dijkstra x" << nsrc << ":     CGraph " << td1 << " ms, CcsrGraph "
+		 << td2 << " ms, speedup " << td1 / td2
+		 << ( vp1 == vp2 && vd1 == vd2 ? "" : " (MISMATCH)" ) << endl;
+}
+
+int main()
+{
+	typedef CGraph<int, int> GT;
+
+	GT gasc( 6500, -1 );
+	ifstream fs( "../../net_topology/ASconnlist.20000101.txt" );
+	if( !fs ) {
+		cout << "failed to open ../../net_topology/ASconnlist.20000101.txt, "
+			 "run from the bench/afgraph directory." << endl;
+		return 1;
+	}
+	import_asconnect( gasc, fs );
+	gasc.pack();
+	compare( "AS graph 2000/01/01", gasc, 200, 20 );
+
+	GT grnd( 1, -1 );
+	bench_random_graph( grnd, 20000, 100000, 100 );
+	compare( "random graph", grnd, 50, 2 );
+
+	return 0;
+}
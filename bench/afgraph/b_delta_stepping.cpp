@@ -0,0 +1,107 @@
+/*@copyright
+
+Copyright (c) 2012 Aiguo Fei
+All rights reserved.
+
+Permission to use and re-distribute this code in source and binary forms
+with or without modifications is therefore granted provided that
+the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Information regarding where to obtain the original source code must be
+      included with the redistrbution.
+
+*NO WARRANTY*
+THIS CODE OR PROGRAM IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S)
+"AS IS" WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE. THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S) MUST NOT BE
+HELD RESPONSIBLE FOR ANY DAMAGE OR UNDESIRED EFFECT CAUSED DIRECTLY OR
+INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
+
+*/
+
+
+/* b_delta_stepping.cpp
+
+  benchmark: delta_stepping( ) vs. dijkstra( ) from one source, on a
+  random graph of 1M nodes and 8M edges (weights within [1, 100]) and a
+  1000x1000 grid (unit weights), for several delta, on 1, 2, 4, ...
+  threads up to the number of hardware threads. Times include building
+  the edge rows; relaxations which improved a distance are counted.
+
+*/
+
+#include <iostream>
+#include <vector>
+#include <thread>
+
+#include "afl/util_tl.hpp"
+
+#include "afgraph/graph.h"
+#include "afgraph/vertex.h"
+#include "afgraph/graph_gen.h"
+#include "afgraph/shortest_path.h"
+#include "afgraph/delta_stepping.h"
+
+#include "bench_util.h"
+
+using namespace std;
+using namespace afg;
+
+// hash for xyVertex<int>, so that grid_graph_gen( ) finds vertices fast
+struct xy_hash {
+	size_t operator()( const xyVertex<int> &v ) const {
+		return ( size_t )v.x() * 1000003u + ( size_t )v.y();
+	}
+};
+
+template<class GraphT>
+void run( const GraphT &gra, const int *deltas, int ndelta )
+{
+	typedef afl::pointer2value<int> FW;
+	int nhw = ( int )std::thread::hardware_concurrency();
+	vector<int> vp0, vd0;
+	CbTimer tm;
+	dijkstra( gra, 0, FW(), 1 << 30, vp0, vd0 );
+	double t0 = tm.ms();
+	cout << "  dijkstra: " << t0 << " ms" << endl;
+	for( int k = 0; k < ndelta; ++k ) {
+		for( int nt = 1; nt <= ( nhw > 1 ? nhw : 1 ); nt *= 2 ) {
+			vector<int> vp, vd;
+			afl::thread_pool pool( nt );
+			long long nrelax = 0;
+			tm.start();
+			delta_stepping( gra, 0, FW(), 1 << 30, vp, vd, deltas[k], pool, &nrelax );
+			double t = tm.ms();
+			cout << "  delta " << deltas[k] << ", " << nt << " threads: " << t
+				 << " ms, speedup " << t0 / t << ", relaxations " << nrelax
+				 << ( vd == vd0 ? "" : ", DIFFERENT" ) << endl;
+		}
+	}
+}
+
+int main()
+{
+	{
+		const int n = 1000000;
+		CGraph<int, int, std::equal_to<int>, no_hash, evector_policy> gra( n, -1 );
+		bench_random_graph( gra, n, 8 * n, 100 );
+		cout << "random graph, " << n << " nodes, " << 8 * n << " edges "
+			 << "(delta 0: 100 / 8 = 12):" << endl;
+		const int deltas[] = { 0, 3, 50, 200 };
+		run( gra, deltas, 4 );
+	}
+	{
+		const int nside = 1000;
+		CGraph<xyVertex<int>, int, std::equal_to<xyVertex<int> >, xy_hash> grid( nside * nside );
+		grid_graph_gen( grid, nside, nside );
+		cout << "grid " << nside << "x" << nside << " (delta 0: 1):" << endl;
+		const int deltas[] = { 0, 8, 64 };
+		run( grid, deltas, 3 );
+	}
+	return 0;
+}
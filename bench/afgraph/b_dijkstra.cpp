@@ -0,0 +1,116 @@
+/*@copyright
+
+Copyright (c) 2012 Aiguo Fei
+All rights reserved.
+
+Permission to use and re-distribute this code in source and binary forms
+with or without modifications is therefore granted provided that
+the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Information regarding where to obtain the original source code must be
+      included with the redistrbution.
+
+*NO WARRANTY*
+THIS CODE OR PROGRAM IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S)
+"AS IS" WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE. THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S) MUST NOT BE
+HELD RESPONSIBLE FOR ANY DAMAGE OR UNDESIRED EFFECT CAUSED DIRECTLY OR
+INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
+
+*/
+
+
+/* b_dijkstra.cpp
+
+  benchmark: the priority queues of dijkstra( ) on random graphs of 1k to
+  1M vertices, 4 edges per vertex, weights within [1, 100] and hop count
+  (runit_p): indexed 4-ary heap, Dial's buckets, radix heap, and the
+  original sorted_list (dijkstra_sl( ), quadratic in the queue length,
+  only run up to 10k vertices). Results are checked to match.
+
+*/
+
+#include <iostream>
+#include <vector>
+
+#include "afl/util_tl.hpp"
+
+#include "afgraph/graph.h"
+#include "afgraph/shortest_path.h"
+
+#include "bench_util.h"
+
+using namespace std;
+using namespace afg;
+
+typedef CGraph<int, int, std::equal_to<int>, no_hash, evector_policy> GT;
+
+enum { HEAP, DIAL, RADIX, AUTO, SLIST };
+
+template<class Fun>
+double run( const GT &gra, Fun f, int q, int nsrc, vector<int> &vpred, vector<int> &vdist )
+{
+	int n = gra.range();
+	CbTimer tm;
+	for( int s = 0; s < nsrc; ++s ) {
+		int ns = s * ( n / nsrc );
+		switch( q ) {
+		case HEAP:
+			dijkstra_heap( gra, ns, f, 1 << 30, vpred, vdist );
+			break;
+		case DIAL:
+			dijkstra_dial( gra, ns, f, 1 << 30, vpred, vdist, 100 );
+			break;
+		case RADIX:
+			dijkstra_radix( gra, ns, f, 1 << 30, vpred, vdist );
+			break;
+		case AUTO:
+			dijkstra( gra, ns, f, 1 << 30, vpred, vdist );
+			break;
+		default:
+			dijkstra_sl( gra, ns, f, 1 << 30, vpred, vdist );
+		}
+	}
+	return tm.ms() / nsrc;
+}
+
+template<class Fun>
+void measure( const GT &gra, Fun f, int nsrc )
+{
+	const char *names[] = { "heap", "dial", "radix", "dijkstra( )", "sorted_list" };
+	int n = gra.range();
+	vector<int> vp0, vd0, vpred, vdist;
+	double th = run( gra, f, HEAP, nsrc, vp0, vd0 );
+	cout << " " << names[HEAP] << " " << th << " ms";
+	for( int q = DIAL; q <= SLIST; ++q ) {
+		if( q == SLIST && n > 10000 ) {
+			break;
+		}
+		double t = run( gra, f, q, nsrc, vpred, vdist );
+		cout << ", " << names[q] << " " << t << " ms (x" << th / t << ( vpred == vp0
+				&& vdist == vd0 ? ")" : ", DIFFERENT)" );
+	}
+	cout << endl;
+}
+
+int main()
+{
+	int sizes[] = { 1000, 10000, 100000, 1000000 };
+	for( int k = 0; k < 4; ++k ) {
+		int n = sizes[k];
+		GT gra( n, -1 );
+		bench_random_graph( gra, n, 4 * n, 100 );
+		int nsrc = k < 2 ? 10 : 3;
+		cout << n << " vertices, " << 4 * n << " edges, per source:" << endl;
+		cout << "  weights:";
+		measure( gra, afl::pointer2value<int>(), nsrc );
+		cout << "  hops:   ";
+		measure( gra, afl::runit_p<int>(), nsrc );
+	}
+	return 0;
+}
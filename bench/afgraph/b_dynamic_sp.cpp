@@ -0,0 +1,132 @@
+/*@copyright
+
+Copyright (c) 2012 Aiguo Fei
+All rights reserved.
+
+Permission to use and re-distribute this code in source and binary forms
+with or without modifications is therefore granted provided that
+the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Information regarding where to obtain the original source code must be
+      included with the redistrbution.
+
+*NO WARRANTY*
+THIS CODE OR PROGRAM IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S)
+"AS IS" WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE. THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S) MUST NOT BE
+HELD RESPONSIBLE FOR ANY DAMAGE OR UNDESIRED EFFECT CAUSED DIRECTLY OR
+INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
+
+*/
+
+
+
+
+/* b_dynamic_sp.cpp
+
+  benchmark: shortest paths from one source kept up to date by
+  CspDynamic under random edge changes (edges of the shortest path tree
+  made heavier or removed and put back, new edges), vs. a new dijkstra( )
+  run after each, on a random graph of 200K nodes and 1.6M edges (weights
+  within [1, 100]) and a 500x500 grid (unit weights).
+
+*/
+
+#include <iostream>
+#include <vector>
+
+#include "afl/util_tl.hpp"
+
+#include "afgraph/graph.h"
+#include "afgraph/vertex.h"
+#include "afgraph/graph_gen.h"
+#include "afgraph/shortest_path.h"
+#include "afgraph/dynamic_sp.h"
+
+#include "bench_util.h"
+
+using namespace std;
+using namespace afg;
+
+// hash for xyVertex<int>, so that grid_graph_gen( ) finds vertices fast
+struct xy_hash {
+	size_t operator()( const xyVertex<int> &v ) const {
+		return ( size_t )v.x() * 1000003u + ( size_t )v.y();
+	}
+};
+
+template<class GraphT>
+void run( GraphT &gra, int maxw )
+{
+	typedef afl::pointer2value<int> FW;
+	const int nchange = 3000;
+	int n = gra.range();
+	vector<int> vp0, vd0;
+	CbTimer tm;
+	dijkstra( gra, 0, FW(), 1 << 30, vp0, vd0 );
+	double t0 = tm.ms();
+	cout << "  dijkstra: " << t0 << " ms" << endl;
+	tm.start();
+	CspDynamic<GraphT, FW> dsp( gra, 0, FW(), 1 << 30 );
+	cout << "  CspDynamic (in-edge index, dijkstra): " << tm.ms() << " ms" << endl;
+	const char *names[] = { "tree edge heavier", "tree edge removed and put back",
+							"new edge"
+						  };
+	for( int op = 0; op < 3; ++op ) {
+		CbRand rnd( 7 + op );
+		long long ntouched = 0;
+		int nc = 0;
+		tm.start();
+		for( int k = 0; k < nchange; ++k ) {
+			int j = rnd.next( n ), i = dsp.pred()[j];
+			if( op == 2 ) {
+				i = rnd.next( n );
+				dsp.insert_edge( i, j, 1 + rnd.next( maxw ) );
+			} else if( i >= 0 ) {
+				int w = *gra.get_edge_byi( i, j );
+				if( op == 0 ) {
+					dsp.update_edge( i, j, w + 1 + rnd.next( maxw ) );
+				} else {
+					dsp.remove_edge( i, j );
+					ntouched += dsp.changed().size();
+					++nc;
+					dsp.insert_edge( i, j, w );
+				}
+			}
+			ntouched += dsp.changed().size();
+			++nc;
+		}
+		double t = tm.ms();
+		cout << "  " << names[op] << ": " << t * 1000 / nc << " us/change, "
+			 << ( double )ntouched / nc << " nodes changed/change, "
+			 << t0 * nc / t << "x faster than dijkstra( )" << endl;
+	}
+	vector<int> vp, vd;
+	dijkstra( gra, 0, FW(), 1 << 30, vp, vd );
+	cout << "  distances " << ( vd == dsp.dist() ? "the same" : "DIFFERENT" )
+		 << " as dijkstra( ) after the changes" << endl;
+}
+
+int main()
+{
+	{
+		const int n = 200000;
+		CGraph<int, int> gra( n, -1 );
+		bench_random_graph( gra, n, 8 * n, 100 );
+		cout << "random graph, " << n << " nodes, " << 8 * n << " edges:" << endl;
+		run( gra, 100 );
+	}
+	{
+		const int nside = 500;
+		CGraph<xyVertex<int>, int, std::equal_to<xyVertex<int> >, xy_hash> grid( nside * nside );
+		grid_graph_gen( grid, nside, nside );
+		cout << "grid " << nside << "x" << nside << ":" << endl;
+		run( grid, 1 );
+	}
+	return 0;
+}
@@ -0,0 +1,145 @@
+/*@copyright
+
+Copyright (c) 2012 Aiguo Fei
+All rights reserved.
+
+Permission to use and re-distribute this code in source and binary forms
+with or without modifications is therefore granted provided that
+the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Information regarding where to obtain the original source code must be
+      included with the redistrbution.
+
+*NO WARRANTY*
+THIS CODE OR PROGRAM IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S)
+"AS IS" WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE. THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S) MUST NOT BE
+HELD RESPONSIBLE FOR ANY DAMAGE OR UNDESIRED EFFECT CAUSED DIRECTLY OR
+INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
+
+*/
+
+
+
+/* b_edge_storage.cpp
+
+  benchmark: memory use and edge traversal speed of CGraph with
+  the different edge container policies (elist_policy, evector_policy,
+  esmall_policy<N>), on the MBone and AS graphs.
+  Run from this directory.
+
+*/
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cstdlib>
+#include <new>
+
+#include "afl/util_tl.hpp"
+
+#include "afgraph/graph.h"
+#include "afgraph/graph_alg.h"
+#include "afgraph/graph_input.h"
+#include "research/import_asconnect.h"
+
+#include "bench_util.h"
+
+using namespace std;
+using namespace afg;
+
+// count bytes currently allocated with operator new
+static long g_nLiveBytes = 0;
+
+void *operator new( size_t n )
+{
+	size_t *p = ( size_t * )malloc( n + 16 );
+	if( !p ) {
+		throw std::bad_alloc();
+	}
+	*p = n;
+	g_nLiveBytes += n;
+	return ( char * )p + 16;
+}
+
+void operator delete( void *pv ) throw()
+{
+	if( pv ) {
+		size_t *p = ( size_t * )(( char * )pv - 16 );
+		g_nLiveBytes -= *p;
+		free( p );
+	}
+}
+
+// loaders for the two file formats
+struct vve_loader {
+	template<class GT>
+	void operator()( GT &gra, std::istream &is ) const {
+		input_gra_vve<GT, typename GT::VDT>( gra, is );
+	}
+};
+
+struct asconnect_loader {
+	template<class GT>
+	void operator()( GT &gra, std::istream &is ) const {
+		import_asconnect( gra, is );
+	}
+};
+
+template<class GT, class LoaderT>
+void measure( const char *name, const string &fname, int nrep,
+			  const typename GT::VDT &vdef, LoaderT fload )
+{
+	ifstream fs( fname.c_str() );
+	if( !fs ) {
+		cout << "failed to open " << fname << ", run from the bench/afgraph directory." << endl;
+		exit( 1 );
+	}
+	long nb0 = g_nLiveBytes;
+	GT *pg = new GT( 16, vdef );
+	fload( *pg, fs );
+	pg->pack();
+	long nbytes = g_nLiveBytes - nb0;
+
+	int ne = 0;
+	for( int i = 0; i < pg->range(); ++i ) {
+		ne += ( *pg )[i].out_degree();
+	}
+
+	CbTimer tm;
+	long cost = 0;
+	for( int r = 0; r < nrep; ++r ) {
+		cost += graph_cost( *pg, afl::pointer2value<int>() );
+	}
+	double ts = tm.ms();
+
+	cout << "  " << name << ": " << nbytes << " bytes ("
+		 << ( double )nbytes / ne << " per edge), scan x" << nrep << " "
+		 << ts << " ms (cost " << cost << ")" << endl;
+	delete pg;
+}
+
+template<class VDT, class LoaderT>
+void run( const string &fname, int nrep, const VDT &vdef, LoaderT fload )
+{
+	typedef std::equal_to<VDT> EQ;
+	cout << fname << endl;
+	measure< CGraph<VDT, int, EQ, no_hash, elist_policy> >( "list    ", fname, nrep, vdef, fload );
+	measure< CGraph<VDT, int, EQ, no_hash, evector_policy> >( "vector  ", fname, nrep, vdef, fload );
+	measure< CGraph<VDT, int, EQ, no_hash, esmall_policy<2> > >( "small<2>", fname, nrep, vdef, fload );
+	measure< CGraph<VDT, int, EQ, no_hash, esmall_policy<4> > >( "small<4>", fname, nrep, vdef, fload );
+	measure< CGraph<VDT, int, EQ, no_hash, esmall_policy<8> > >( "small<8>", fname, nrep, vdef, fload );
+}
+
+int main()
+{
+	run<string>( "../../test/afgraph/mbone-all-199405.vve", 20000, "null", vve_loader() );
+	run<int>( "../../net_topology/ASconnlist.19980105.txt", 500, -1, asconnect_loader() );
+	run<int>( "../../net_topology/ASconnlist.20000101.txt", 500, -1, asconnect_loader() );
+	return 0;
+}
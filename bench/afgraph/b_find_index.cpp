@@ -0,0 +1,105 @@
+/*@copyright
+
+Copyright (c) 2012 Aiguo Fei
+All rights reserved.
+
+Permission to use and re-distribute this code in source and binary forms
+with or without modifications is therefore granted provided that
+the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Information regarding where to obtain the original source code must be
+      included with the redistrbution.
+
+*NO WARRANTY*
+THIS CODE OR PROGRAM IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S)
+"AS IS" WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE. THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S) MUST NOT BE
+HELD RESPONSIBLE FOR ANY DAMAGE OR UNDESIRED EFFECT CAUSED DIRECTLY OR
+INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
+
+*/
+
+
+
+/* b_find_index.cpp
+
+  benchmark: loading the AS graphs (value-based insert_v/insert_2e)
+  into a CGraph with and without a hash index on vertex data.
+  Run from this directory.
+
+*/
+
+#include <iostream>
+#include <fstream>
+#include <string>
+
+#include "afgraph/graph.h"
+#include "research/import_asconnect.h"
+
+#include "bench_util.h"
+
+using namespace std;
+using namespace afg;
+
+template<class GT>
+double time_load( const string &fname, GT &gra )
+{
+	ifstream fs( fname.c_str() );
+	if( !fs ) {
+		cout << "failed to open " << fname << ", run from the bench/afgraph directory." << endl;
+		return -1;
+	}
+	CbTimer tm;
+	import_asconnect( gra, fs );
+	return tm.ms();
+}
+
+template<class GT>
+double time_lookup( const GT &gra, long &nfound )
+{
+	CbTimer tm;
+	nfound = 0;
+	for( int r = 0; r < 10; ++r ) {
+		for( int v = 0; v < 15000; ++v ) {
+			if( gra.find_index( v ) >= 0 ) {
+				++nfound;
+			}
+		}
+	}
+	return tm.ms();
+}
+
+int main()
+{
+	typedef CGraph<int, int> LGT;
+	typedef CGraph<int, int, std::equal_to<int>, std::hash<int> > HGT;
+
+	const char *files[] = { "ASconnlist.19980105.txt", "ASconnlist.19990112.txt",
+							"ASconnlist.20000101.txt"
+						  };
+	for( int f = 0; f < 3; ++f ) {
+		string fname = string( "../../net_topology/" ) + files[f];
+		LGT lg( 1000, -1 );
+		HGT hg( 1000, -1 );
+		double tl = time_load( fname, lg );
+		double th = time_load( fname, hg );
+		if( tl < 0 || th < 0 ) {
+			return 1;
+		}
+		long nl, nh;
+		double fl = time_lookup( lg, nl );
+		double fh = time_lookup( hg, nh );
+		cout << files[f] << ": " << lg.size() << " nodes" << endl
+			 << "  import:         linear " << tl << " ms, hashed " << th
+			 << " ms, speedup " << tl / th << endl
+			 << "  150k find_index: linear " << fl << " ms, hashed " << fh
+			 << " ms, speedup " << fl / fh << ( nl == nh ? "" : " (MISMATCH)" ) << endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,90 @@
+/*@copyright
+
+Copyright (c) 2012 Aiguo Fei
+All rights reserved.
+
+Permission to use and re-distribute this code in source and binary forms
+with or without modifications is therefore granted provided that
+the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Information regarding where to obtain the original source code must be
+      included with the redistrbution.
+
+*NO WARRANTY*
+THIS CODE OR PROGRAM IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S)
+"AS IS" WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE. THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S) MUST NOT BE
+HELD RESPONSIBLE FOR ANY DAMAGE OR UNDESIRED EFFECT CAUSED DIRECTLY OR
+INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
+
+*/
+
+
+/* b_floyd.cpp
+
+  benchmark: floyd_warshall_allsp( ) vs. floyd_warshall_blocked( ) (on 1
+  thread and on all hardware threads) on random graphs of 500, 2000 and
+  5000 nodes, integer and double weights. At 5000 nodes the plain version
+  takes minutes.
+
+*/
+
+#include <iostream>
+#include <vector>
+#include <thread>
+
+#include "afl/util_tl.hpp"
+
+#include "afgraph/graph.h"
+#include "afgraph/shortest_path.h"
+
+#include "bench_util.h"
+
+using namespace std;
+using namespace afg;
+
+template<class WeightT>
+void run( int n )
+{
+	typedef CGraph<int, WeightT> GT;
+	typedef afl::pointer2value<WeightT> FW;
+	GT gra( n, -1 );
+	bench_random_graph( gra, n, 8 * n, 100 );
+	int nhw = ( int )std::thread::hardware_concurrency();
+	const WeightT w_infty = ( WeightT )( 1 << 28 );
+
+	vector<int> vp0, vp;
+	vector<WeightT> vd0, vd;
+	CbTimer tm;
+	floyd_warshall_allsp( gra, FW(), w_infty, vp0, vd0 );
+	double t0 = tm.ms();
+	cout << "  floyd_warshall_allsp: " << t0 << " ms" << endl;
+	for( int nt = 1; ; nt = nhw ) {
+		afl::thread_pool pool( nt );
+		tm.start();
+		floyd_warshall_blocked( gra, FW(), w_infty, vp, vd, pool );
+		double t = tm.ms();
+		cout << "  floyd_warshall_blocked, " << nt << " threads: " << t << " ms, speedup "
+			 << t0 / t << ( vd == vd0 ? "" : ", DIFFERENT" ) << endl;
+		if( nt >= nhw ) {
+			break;
+		}
+	}
+}
+
+int main()
+{
+	const int ns[] = { 500, 2000, 5000 };
+	for( int k = 0; k < 3; ++k ) {
+		cout << ns[k] << " nodes, int:" << endl;
+		run<int>( ns[k] );
+		cout << ns[k] << " nodes, double:" << endl;
+		run<double>( ns[k] );
+	}
+	return 0;
+}
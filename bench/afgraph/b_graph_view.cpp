@@ -0,0 +1,108 @@
+/*@copyright
+
+Copyright (c) 2012 Aiguo Fei
+All rights reserved.
+
+Permission to use and re-distribute this code in source and binary forms
+with or without modifications is therefore granted provided that
+the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Information regarding where to obtain the original source code must be
+      included with the redistrbution.
+
+*NO WARRANTY*
+THIS CODE OR PROGRAM IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S)
+"AS IS" WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE. THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S) MUST NOT BE
+HELD RESPONSIBLE FOR ANY DAMAGE OR UNDESIRED EFFECT CAUSED DIRECTLY OR
+INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
+
+*/
+
+
+
+/* b_graph_view.cpp
+
+  benchmark: per-edge cost of algorithm inner loops on a random graph of
+  100k edges, with virtual access (the graph passed as an IGraph reference,
+  as every call went before graph_view.h) and with static access (the
+  CGraph itself, through graph_view<CGraph>).
+
+*/
+
+#include <iostream>
+#include <vector>
+
+#include "afl/util_tl.hpp"
+
+#include "afgraph/graph.h"
+#include "afgraph/graph_alg.h"
+#include "afgraph/shortest_path.h"
+
+#include "bench_util.h"
+
+using namespace std;
+using namespace afg;
+
+template<class GT>
+double time_scan( const GT &gra, int nrep, long &cost )
+{
+	CbTimer tm;
+	cost = 0;
+	for( int r = 0; r < nrep; ++r ) {
+		cost += graph_cost( gra, afl::pointer2value<int>() );
+	}
+	return tm.ms();
+}
+
+template<class GT>
+double time_dijkstra( const GT &gra, int nsrc, long &dsum )
+{
+	vector<int> vpred, vdist;
+	CbTimer tm;
+	dsum = 0;
+	for( int s = 0; s < nsrc; ++s ) {
+		dijkstra( gra, s * ( gra.range() / nsrc ), afl::pointer2value<int>(),
+				  1 << 30, vpred, vdist );
+		dsum += vdist[gra.range() - 1];
+	}
+	return tm.ms();
+}
+
+template<class GT>
+void compare( const char *name, int n, int m, int nscan, int nsrc )
+{
+	typedef typename GT::igraph_base_type IGT;
+	GT gra( n, -1 );
+	bench_random_graph( gra, n, m, 100 );
+	const IGT &igra = gra;
+
+	long c1, c2, d1, d2;
+	double ts1 = time_scan( igra, nscan, c1 );
+	double ts2 = time_scan( gra, nscan, c2 );
+	double td1 = time_dijkstra( igra, nsrc, d1 );
+	double td2 = time_dijkstra( gra, nsrc, d2 );
+	double ne = ( double )m;
+	cout << name << ", " << n << " nodes, " << m << " edges" << endl
+		 << "  edge scan: virtual " << ts1 * 1e6 / ( ne * nscan ) << " ns/edge, static "
+		 << ts2 * 1e6 / ( ne * nscan ) << " ns/edge, speedup " << ts1 / ts2
+		 << ( c1 == c2 ? "" : " (MISMATCH)" ) << endl
+		 << "  dijkstra:  virtual " << td1 * 1e6 / ( ne * nsrc ) << " ns/edge, static "
+		 << td2 * 1e6 / ( ne * nsrc ) << " ns/edge, speedup " << td1 / td2
+		 << ( d1 == d2 ? "" : " (MISMATCH)" ) << endl;
+}
+
+int main()
+{
+	const int n = 25000, m = 100000, nscan = 200, nsrc = 3;
+	compare< CGraph<int, int> >( "list edges", n, m, nscan, nsrc );
+	compare< CGraph<int, int, std::equal_to<int>, no_hash, evector_policy> >(
+		"vector edges", n, m, nscan, nsrc );
+
+	return 0;
+}
@@ -0,0 +1,139 @@
+/*@copyright
+
+Copyright (c) 2012 Aiguo Fei
+All rights reserved.
+
+Permission to use and re-distribute this code in source and binary forms
+with or without modifications is therefore granted provided that
+the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Information regarding where to obtain the original source code must be
+      included with the redistrbution.
+
+*NO WARRANTY*
+THIS CODE OR PROGRAM IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S)
+"AS IS" WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE. THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S) MUST NOT BE
+HELD RESPONSIBLE FOR ANY DAMAGE OR UNDESIRED EFFECT CAUSED DIRECTLY OR
+INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
+
+*/
+
+
+
+
+/* b_ksp.cpp
+
+  benchmark: k shortest paths from one source to all destinations by
+  CkthSP and by CkspEppstein on a random graph of 400 nodes and on the
+  AS graph of 2000/01/01 (hop count; CkthSP on all threads), and k
+  shortest loopless paths between random pairs of it by CkspYen. Run from this directory.
+
+*/
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+
+#include "afl/util_tl.hpp"
+
+#include "afgraph/graph.h"
+#include "afgraph/kthsp.h"
+#include "afgraph/ksp.h"
+#include "research/import_asconnect.h"
+
+#include "bench_util.h"
+
+using namespace std;
+using namespace afg;
+
+typedef CGraph<int, int> GT;
+
+// k rounds of ksp, the length of all paths added up
+template<class KspT>
+long long run( KspT &ksp, int n, int k, double &tfirst, double &tnext )
+{
+	CbTimer tm;
+	ksp.get_first();
+	tfirst = tm.ms();
+	tm.start();
+	for( int i = 1; i < k; ++i ) {
+		ksp.get_next();
+	}
+	tnext = tm.ms() / ( k > 1 ? k - 1 : 1 );
+	long long sum = 0;
+	CPath lp;
+	for( int t = 0; t < n; ++t ) {
+		for( int i = 1; i <= k; ++i ) {
+			sum += ksp.get_path( t, i, lp );
+		}
+	}
+	return sum;
+}
+
+int main()
+{
+	{
+		const int n = 400, k = 10;
+		GT gra( n, -1 );
+		bench_random_graph( gra, n, 4 * n, 100 );
+		cout << "random graph, " << n << " nodes, " << 4 * n << " edges, k " << k << endl;
+		typedef afl::pointer2value<int> FW;
+		double tf0, tn0, tf1, tn1;
+		CkthSP<GT, FW> k0( gra, 0, k, FW(), 1 << 30, 0 );
+		run( k0, n, k, tf0, tn0 );
+		CkspEppstein<GT, FW> k1( gra, 0, k, FW(), 1 << 30 );
+		run( k1, n, k, tf1, tn1 );
+		cout << "  CkthSP: get_first " << tf0 << " ms, get_next " << tn0 << " ms" << endl;
+		cout << "  CkspEppstein: get_first " << tf1 << " ms, get_next " << tn1
+			 << " ms, " << tn0 / tn1 << "x faster" << endl;
+	}
+	const char *file = "../../net_topology/ASconnlist.20000101.txt";
+	ifstream fs( file );
+	if( !fs ) {
+		cout << "failed to open " << file << ", run from the bench/afgraph directory." << endl;
+		return 1;
+	}
+	GT gra( 16, -1 );
+	import_asconnect( gra, fs );
+	gra.pack();
+	int n = gra.range();
+	typedef afl::runit_p<int> FW;
+	const int ks[] = { 10, 100, 1000 };
+	for( int m = 0; m < 3; ++m ) {
+		double tf, tn;
+		cout << "ASconnlist.20000101, " << n << " nodes, k " << ks[m] << endl;
+		{
+			CkthSP<GT, FW> k0( gra, 0, ks[m], FW(), 1 << 30, 0 );
+			run( k0, n, ks[m], tf, tn );
+			cout << "  CkthSP: get_first " << tf << " ms, get_next " << tn << " ms" << endl;
+		}
+		CkspEppstein<GT, FW> ksp( gra, 0, ks[m], FW(), 1 << 30 );
+		run( ksp, n, ks[m], tf, tn );
+		cout << "  CkspEppstein: get_first " << tf << " ms, get_next " << tn << " ms" << endl;
+	}
+	const int npair = 100, k = 10;
+	CbRand rnd( 3 );
+	long long npath = 0;
+	CbTimer tm;
+	for( int q = 0; q < npair; ++q ) {
+		int s = rnd.next( n ), t = rnd.next( n );
+		CkspYen<GT, FW> yen( gra, s, t, k, FW(), 1 << 30 );
+		yen.get_first();
+		for( int i = 1; i < k; ++i ) {
+			yen.get_next();
+		}
+		CPath lp;
+		for( int i = 1; i <= k; ++i ) {
+			npath += yen.get_path( t, i, lp ) < ( 1 << 30 );
+		}
+	}
+	cout << "  CkspYen, " << npair << " random pairs, k " << k << ": "
+		 << tm.ms() / npair << " ms/pair, " << npath << " paths" << endl;
+	return 0;
+}
@@ -0,0 +1,116 @@
+/*@copyright
+
+Copyright (c) 2012 Aiguo Fei
+All rights reserved.
+
+Permission to use and re-distribute this code in source and binary forms
+with or without modifications is therefore granted provided that
+the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Information regarding where to obtain the original source code must be
+      included with the redistrbution.
+
+*NO WARRANTY*
+THIS CODE OR PROGRAM IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S)
+"AS IS" WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE. THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S) MUST NOT BE
+HELD RESPONSIBLE FOR ANY DAMAGE OR UNDESIRED EFFECT CAUSED DIRECTLY OR
+INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
+
+*/
+
+
+/* b_p2p.cpp
+
+  benchmark: point to point queries (dijkstra_t( )) on the AS graphs:
+  full single source search, early exit, and bidirectional search over
+  the in-edge index, over a transposed copy made per query, and over one
+  made once (CspReverse). Hop count (runit_p) on random pairs.
+  Run from this directory.
+
+*/
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+
+#include "afl/util_tl.hpp"
+
+#include "afgraph/graph.h"
+#include "afgraph/shortest_path.h"
+#include "research/import_asconnect.h"
+
+#include "bench_util.h"
+
+using namespace std;
+using namespace afg;
+
+typedef CGraph<int, int> GT;
+typedef afl::runit_p<int> FW;
+
+int main()
+{
+	const char *files[] = { "ASconnlist.19980105.txt", "ASconnlist.20000101.txt" };
+	const int npairs = 1000;
+	for( int f = 0; f < 2; ++f ) {
+		string fname = string( "../../net_topology/" ) + files[f];
+		ifstream fs( fname.c_str() );
+		if( !fs ) {
+			cout << "failed to open " << fname << ", run from the bench/afgraph directory." << endl;
+			return 1;
+		}
+		GT gra( 16, -1 );
+		import_asconnect( gra, fs );
+		gra.pack();
+		GT grai( gra );
+		grai.enable_in_index();
+		CspReverse<GT, FW> rev( gra, FW() );
+		int n = gra.range();
+		cout << files[f] << ": " << n << " nodes, " << npairs << " pairs" << endl;
+
+		const char *names[] = { "full", "early exit", "bidir, in-edge index",
+								"bidir, transposed per query", "bidir, transposed once"
+							  };
+		long dsum0 = 0;
+		for( int m = 0; m < 5; ++m ) {
+			CbRand rnd( 7 );
+			long dsum = 0, nset = 0;
+			CPath lp;
+			CbTimer tm;
+			for( int k = 0; k < npairs; ++k ) {
+				int s = rnd.next( n ), t = rnd.next( n ), ns = 0;
+				switch( m ) {
+				case 0:
+					dsum += dijkstra_t( gra, s, t, FW(), 1 << 30, lp, sp_options(), &ns );
+					break;
+				case 1:
+					dsum += dijkstra_t( gra, s, t, FW(), 1 << 30, lp, sp_options::sp_early_exit, &ns );
+					break;
+				case 2:
+					dsum += dijkstra_t( grai, s, t, FW(), 1 << 30, lp, sp_options::sp_bidirectional, &ns );
+					break;
+				case 3:
+					dsum += dijkstra_t( gra, s, t, FW(), 1 << 30, lp, sp_options::sp_bidirectional, &ns );
+					break;
+				default:
+					dsum += dijkstra_bidir( gra, s, t, FW(), 1 << 30, lp, rev, &ns );
+				}
+				nset += ns;
+			}
+			double t = tm.ms();
+			if( m == 0 ) {
+				dsum0 = dsum;
+			}
+			cout << "  " << names[m] << ": " << t / npairs << " ms/query, "
+				 << nset / npairs << " settled/query" << ( dsum == dsum0 ? "" : ", DIFFERENT" ) << endl;
+		}
+	}
+	return 0;
+}
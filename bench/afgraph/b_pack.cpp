@@ -0,0 +1,70 @@
+/*@copyright
+
+Copyright (c) 2012 Aiguo Fei
+All rights reserved.
+
+Permission to use and re-distribute this code in source and binary forms
+with or without modifications is therefore granted provided that
+the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Information regarding where to obtain the original source code must be
+      included with the redistrbution.
+
+*NO WARRANTY*
+THIS CODE OR PROGRAM IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S)
+"AS IS" WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE. THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S) MUST NOT BE
+HELD RESPONSIBLE FOR ANY DAMAGE OR UNDESIRED EFFECT CAUSED DIRECTLY OR
+INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
+
+*/
+
+
+
+/* b_pack.cpp
+
+  benchmark: CGraph::pack( ) on fragmented random graphs, a fraction
+  of the vertices removed at random before packing.
+
+*/
+
+#include <iostream>
+#include <vector>
+
+#include "afgraph/graph.h"
+
+#include "bench_util.h"
+
+using namespace std;
+using namespace afg;
+
+int main()
+{
+	typedef CGraph<int, int> GT;
+	const int sizes[] = { 10000, 50000, 200000 };
+	for( int s = 0; s < 3; ++s ) {
+		int n = sizes[s], m = 4 * n;
+		GT gra( n, -1 );
+		bench_random_graph( gra, n, m, 100 );
+		// the in-edge index makes the removals fast, it's not used by pack
+		gra.enable_in_index();
+		CbRand rnd( 7 );
+		for( int k = 0; k < n / 5; ++k ) {
+			gra.remove_v_byi( rnd.next( n ) );
+		}
+		gra.enable_in_index( false );
+		vector<int> vremap;
+		CbTimer tm;
+		int nch = gra.pack( 0, &vremap );
+		double tp = tm.ms();
+		cout << n << " nodes, " << m << " edges, " << gra.size()
+			 << " left: pack " << tp << " ms, " << nch << " index changes" << endl;
+	}
+
+	return 0;
+}
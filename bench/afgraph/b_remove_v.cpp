@@ -0,0 +1,83 @@
+/*@copyright
+
+Copyright (c) 2012 Aiguo Fei
+All rights reserved.
+
+Permission to use and re-distribute this code in source and binary forms
+with or without modifications is therefore granted provided that
+the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Information regarding where to obtain the original source code must be
+      included with the redistrbution.
+
+*NO WARRANTY*
+THIS CODE OR PROGRAM IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S)
+"AS IS" WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE. THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S) MUST NOT BE
+HELD RESPONSIBLE FOR ANY DAMAGE OR UNDESIRED EFFECT CAUSED DIRECTLY OR
+INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
+
+*/
+
+
+
+/* b_remove_v.cpp
+
+  benchmark: removing vertices from a random graph with and without
+  the in-edge index (CGraph::enable_in_index).
+
+*/
+
+#include <iostream>
+#include <vector>
+
+#include "afgraph/graph.h"
+
+#include "bench_util.h"
+
+using namespace std;
+using namespace afg;
+
+typedef CGraph<int, int> GT;
+
+// remove nrm random vertices, return time in ms
+double time_remove( GT &gra, int nrm, unsigned long long seed )
+{
+	CbRand rnd( seed );
+	CbTimer tm;
+	for( int k = 0; k < nrm; ++k ) {
+		gra.remove_v_byi( rnd.next( gra.range() ) );
+	}
+	return tm.ms();
+}
+
+int main()
+{
+	const int sizes[][2] = { { 2000, 8000 }, { 10000, 40000 }, { 40000, 160000 } };
+	for( int s = 0; s < 3; ++s ) {
+		int n = sizes[s][0], m = sizes[s][1], nrm = 1000;
+		GT g1( n, -1 ), g2( n, -1 );
+		bench_random_graph( g1, n, m, 100 );
+		bench_random_graph( g2, n, m, 100 );
+		CbTimer tm;
+		g2.enable_in_index();
+		double tb = tm.ms();
+		double t1 = time_remove( g1, nrm, 99 );
+		double t2 = time_remove( g2, nrm, 99 );
+		bool bsame = ( g1.size() == g2.size() );
+		for( int i = 0; bsame && i < n; ++i ) {
+			bsame = g1[i].out_degree() == g2[i].out_degree();
+		}
+		cout << n << " nodes, " << m << " edges, remove " << nrm << " nodes: "
+			 << "scan " << t1 << " ms, indexed " << t2 << " ms (+" << tb
+			 << " ms to build the index), speedup " << t1 / ( t2 + tb )
+			 << ( bsame ? "" : " (MISMATCH)" ) << endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,157 @@
+/*@copyright
+
+Copyright (c) 2012 Aiguo Fei
+All rights reserved.
+
+Permission to use and re-distribute this code in source and binary forms
+with or without modifications is therefore granted provided that
+the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Information regarding where to obtain the original source code must be
+      included with the redistrbution.
+
+*NO WARRANTY*
+THIS CODE OR PROGRAM IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S)
+"AS IS" WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE. THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S) MUST NOT BE
+HELD RESPONSIBLE FOR ANY DAMAGE OR UNDESIRED EFFECT CAUSED DIRECTLY OR
+INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
+
+*/
+
+
+
+/* b_ugraph.cpp
+
+  benchmark: CuGraph (one record per link) vs. a symmetric CGraph
+  (two edges per link) on the AS graphs: memory, bulk weight update,
+  edge scan and dijkstra.
+  Run from this directory.
+
+*/
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <new>
+
+#include "afl/util_tl.hpp"
+
+#include "afgraph/graph.h"
+#include "afgraph/ugraph.h"
+#include "afgraph/graph_alg.h"
+#include "afgraph/shortest_path.h"
+#include "research/import_asconnect.h"
+
+#include "bench_util.h"
+
+using namespace std;
+using namespace afg;
+
+// count bytes currently allocated with operator new
+static long g_nLiveBytes = 0;
+
+void *operator new( size_t n )
+{
+	size_t *p = ( size_t * )malloc( n + 16 );
+	if( !p ) {
+		throw std::bad_alloc();
+	}
+	*p = n;
+	g_nLiveBytes += n;
+	return ( char * )p + 16;
+}
+
+void operator delete( void *pv ) throw()
+{
+	if( pv ) {
+		size_t *p = ( size_t * )(( char * )pv - 16 );
+		g_nLiveBytes -= *p;
+		free( p );
+	}
+}
+
+// set every link (both directions for a CGraph) to a new weight
+template<class VDT, class EDT>
+void reweight( CGraph<VDT, EDT> &gra, int r )
+{
+	for( int i = 0; i < gra.range(); ++i ) {
+		for( typename CGraph<VDT, EDT>::e_iterator it = gra.e_begin( i );
+			 it != gra.e_end( i ); ++it ) {
+			int j = ( *it ).to();
+			( *it ).edge_d() = 1 + (( i < j ? i * 7 + j : j * 7 + i ) + r ) % 13;
+		}
+	}
+}
+
+template<class VDT, class EDT>
+void reweight( CuGraph<VDT, EDT> &gra, int r )
+{
+	for( int k = 0; k < gra.n_links(); ++k ) {
+		CuLink<EDT> &l = gra.link( k );
+		int i = l.u < l.v ? l.u : l.v, j = l.u < l.v ? l.v : l.u;
+		l.edge = 1 + ( i * 7 + j + r ) % 13;
+	}
+}
+
+template<class GT>
+void measure( const char *name, const string &fname, int nrep, int nsrc )
+{
+	ifstream fs( fname.c_str() );
+	if( !fs ) {
+		cout << "failed to open " << fname << ", run from the bench/afgraph directory." << endl;
+		exit( 1 );
+	}
+	long nb0 = g_nLiveBytes;
+	GT *pg = new GT( 16, -1 );
+	import_asconnect( *pg, fs );
+	pg->pack();
+	long nbytes = g_nLiveBytes - nb0;
+
+	CbTimer tm;
+	for( int r = 0; r < nrep; ++r ) {
+		reweight( *pg, r );
+	}
+	double tw = tm.ms();
+	tm.start();
+	long cost = 0;
+	for( int r = 0; r < nrep; ++r ) {
+		cost += graph_cost( *pg, afl::pointer2value<int>() );
+	}
+	double ts = tm.ms();
+	vector<int> vpred, vdist;
+	long dsum = 0;
+	tm.start();
+	for( int s = 0; s < nsrc; ++s ) {
+		dijkstra( *pg, s * ( pg->range() / nsrc ), afl::pointer2value<int>(),
+				  1 << 30, vpred, vdist );
+		for( size_t i = 0; i < vdist.size(); ++i ) {
+			dsum += vdist[i];
+		}
+	}
+	double td = tm.ms();
+
+	cout << "  " << name << ": " << nbytes << " bytes, reweight x" << nrep << " "
+		 << tw << " ms, scan x" << nrep << " " << ts << " ms (cost " << cost
+		 << "), dijkstra x" << nsrc << " " << td << " ms (sum " << dsum << ")" << endl;
+	delete pg;
+}
+
+int main()
+{
+	const char *files[] = { "ASconnlist.19980105.txt", "ASconnlist.20000101.txt" };
+	for( int f = 0; f < 2; ++f ) {
+		string fname = string( "../../net_topology/" ) + files[f];
+		cout << files[f] << endl;
+		measure< CGraph<int, int> >( "CGraph ", fname, 200, 5 );
+		measure< CuGraph<int, int> >( "CuGraph", fname, 200, 5 );
+	}
+	return 0;
+}
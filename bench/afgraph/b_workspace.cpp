@@ -0,0 +1,110 @@
+/*@copyright
+
+Copyright (c) 2012 Aiguo Fei
+All rights reserved.
+
+Permission to use and re-distribute this code in source and binary forms
+with or without modifications is therefore granted provided that
+the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Information regarding where to obtain the original source code must be
+      included with the redistrbution.
+
+*NO WARRANTY*
+THIS CODE OR PROGRAM IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S)
+"AS IS" WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE. THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S) MUST NOT BE
+HELD RESPONSIBLE FOR ANY DAMAGE OR UNDESIRED EFFECT CAUSED DIRECTLY OR
+INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
+
+*/
+
+
+/* b_workspace.cpp
+
+  benchmark: many local point to point queries (nodes a few hops apart)
+  on a large grid, with new vectors for each query and with a reused
+  workspace (CSPWorkspace), which resets only the entries the previous
+  query touched.
+
+*/
+
+#include <iostream>
+#include <cstddef>
+
+#include "afl/util_tl.hpp"
+
+#include "afgraph/graph.h"
+#include "afgraph/vertex.h"
+#include "afgraph/graph_gen.h"
+#include "afgraph/shortest_path.h"
+
+#include "bench_util.h"
+
+using namespace std;
+using namespace afg;
+
+// hash for xyVertex<int>, so that grid_graph_gen( ) finds vertices fast
+struct xy_hash {
+	size_t operator()( const xyVertex<int> &v ) const {
+		return ( size_t )v.x() * 1000003u + ( size_t )v.y();
+	}
+};
+
+typedef CGraph<xyVertex<int>, int, std::equal_to<xyVertex<int> >, xy_hash> GT;
+typedef afl::pointer2value<int> FW;
+
+int main()
+{
+	const int nside = 700, nq = 2000;
+	GT grid( nside * nside );
+	grid_graph_gen( grid, nside, nside );
+	int n = grid.range();
+	CspReverse<GT, FW> rev( grid, FW() );
+	cout << "grid " << nside << "x" << nside << ": " << n << " nodes, "
+		 << nq << " queries to a node within 10 steps" << endl;
+
+	const char *names[] = { "early exit", "early exit, workspace",
+							"bidirectional", "bidirectional, workspace"
+						  };
+	long dsum0 = 0;
+	for( int m = 0; m < 4; ++m ) {
+		CbRand rnd( 3 );
+		CSPWorkspace<int> ws;
+		CPath lp;
+		long dsum = 0, nset = 0;
+		CbTimer tm;
+		for( int k = 0; k < nq; ++k ) {
+			int s = rnd.next( n );
+			int t = s + ( rnd.next( 11 ) - 5 ) * nside + rnd.next( 11 ) - 5;
+			t = t < 0 ? 0 : ( t >= n ? n - 1 : t );
+			int ns = 0;
+			switch( m ) {
+			case 0:
+				dsum += dijkstra_t( grid, s, t, FW(), 1 << 30, lp, sp_options::sp_early_exit, &ns );
+				break;
+			case 1:
+				dsum += dijkstra_t( grid, s, t, FW(), 1 << 30, lp, ws, sp_options::sp_early_exit, &ns );
+				break;
+			case 2:
+				dsum += dijkstra_bidir( grid, s, t, FW(), 1 << 30, lp, rev, &ns );
+				break;
+			default:
+				dsum += dijkstra_bidir( grid, s, t, FW(), 1 << 30, lp, rev, ws, &ns );
+			}
+			nset += ns;
+		}
+		double t = tm.ms();
+		if( m == 0 ) {
+			dsum0 = dsum;
+		}
+		cout << "  " << names[m] << ": " << t / nq << " ms/query, "
+			 << nset / nq << " settled/query" << ( dsum == dsum0 ? "" : ", DIFFERENT" ) << endl;
+	}
+	return 0;
+}
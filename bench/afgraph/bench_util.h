@@ -0,0 +1,107 @@
+/*@copyright
+
+Copyright (c) 2012 Aiguo Fei
+All rights reserved.
+
+Permission to use and re-distribute this code in source and binary forms
+with or without modifications is therefore granted provided that
+the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Information regarding where to obtain the original source code must be
+      included with the redistrbution.
+
+*NO WARRANTY*
+THIS CODE OR PROGRAM IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S)
+"AS IS" WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE. THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S) MUST NOT BE
+HELD RESPONSIBLE FOR ANY DAMAGE OR UNDESIRED EFFECT CAUSED DIRECTLY OR
+INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
+
+*/
+
+
+
+/* bench_util.h
+
+  helpers shared by the benchmark programs:
+  a wall-clock timer and a reproducible random graph generator.
+
+*/
+
+#ifndef _AFG_BENCH_UTIL_H_
+#define _AFG_BENCH_UTIL_H_
+
+#include <chrono>
+
+/// wall-clock timer, reports milliseconds
+class CbTimer
+{
+	std::chrono::steady_clock::time_point m_t0;
+
+public:
+	CbTimer(): m_t0( std::chrono::steady_clock::now() )
+	{ }
+
+	/// restart the timer
+	void start( void ) {
+		m_t0 = std::chrono::steady_clock::now();
+	}
+
+	/// milliseconds since the last start
+	double ms( void ) const {
+		return std::chrono::duration<double, std::milli>(
+				   std::chrono::steady_clock::now() - m_t0 ).count();
+	}
+};
+
+/// small linear congruential generator, same sequence on every platform
+class CbRand
+{
+	unsigned long long m_s;
+
+public:
+	explicit CbRand( unsigned long long seed = 12345 ): m_s( seed )
+	{ }
+
+	/// a random integer within [0, n-1]
+	int next( int n ) {
+		m_s = m_s * 6364136223846793005ULL + 1442695040888963407ULL;
+		return ( int )(( m_s >> 33 ) % ( unsigned long long )n );
+	}
+};
+
+/** generate a random directed graph with integer vertices 0..n-1.
+  Vertex i has index i. First a random spanning tree is made
+  (so every node is reachable from 0), then edges are added at random
+  until there are m edges; weights are within [1, maxw].
+*/
+template<class GT>
+void bench_random_graph( GT &gra, int n, int m, int maxw,
+						 unsigned long long seed = 12345 )
+{
+	CbRand rnd( seed );
+	gra.clear();
+	gra.reserve( n );
+	int i;
+	for( i = 0; i < n; ++i ) {
+		gra.insert_v_ati( i, i );
+	}
+	int ne = 0;
+	for( i = 1; i < n && ne < m; ++i, ++ne ) {
+		gra.insert_e_byi( rnd.next( i ), i, 1 + rnd.next( maxw ) );
+	}
+	while( ne < m ) {
+		int u = rnd.next( n ), v = rnd.next( n );
+		if( u != v && gra.get_edge_byi( u, v ) == NULL ) {
+			gra.insert_e_byi( u, v, 1 + rnd.next( maxw ) );
+			++ne;
+		}
+	}
+}
+
+#endif
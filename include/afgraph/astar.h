@@ -0,0 +1,193 @@
+/*@copyright
+
+Copyright (c) 2012 Aiguo Fei
+All rights reserved.
+
+Permission to use and re-distribute this code in source and binary forms
+with or without modifications is therefore granted provided that
+the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Information regarding where to obtain the original source code must be
+      included with the redistrbution.
+
+*NO WARRANTY*
+THIS CODE OR PROGRAM IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S)
+"AS IS" WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE. THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S) MUST NOT BE
+HELD RESPONSIBLE FOR ANY DAMAGE OR UNDESIRED EFFECT CAUSED DIRECTLY OR
+INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
+
+*/
+
+
+
+/**@file astar.h
+
+  A* point to point shortest path search with a heuristic,
+  e.g. straight-line distance on graphs with x,y coordinates.
+
+*/
+
+#ifndef _AFG_ASTAR_H_
+#define _AFG_ASTAR_H_
+
+#include <vector>
+#include <cmath>
+
+#include "afl/indexed_heap.hpp"
+#include "path.h"
+#include "graph_view.h"
+
+namespace afg
+{
+
+/**@addtogroup gspalg
+*/
+/**@{*/
+
+/**@name A* heuristics.
+  A heuristic h( v, t ) estimates the path length from a vertex with data
+  v to the destination with data t; for A* to find shortest paths it must
+  never overestimate (be admissible). scale converts coordinate units to
+  edge weight units. Integer results are rounded down.
+*/
+//@{
+/// straight-line distance, for vertex data with x( ) and y( )
+template<class WeightT = double>
+struct euclid_heuristic {
+	typedef WeightT result_type;
+
+	double m_dScale;
+
+	explicit euclid_heuristic( double scale = 1.0 ): m_dScale( scale )
+	{ }
+
+	template<class VDT>
+	WeightT operator()( const VDT &v, const VDT &t ) const {
+		double dx = ( double )v.x() - ( double )t.x();
+		double dy = ( double )v.y() - ( double )t.y();
+		return ( WeightT )( m_dScale * std::sqrt( dx * dx + dy * dy ) );
+	}
+};
+
+/// Manhattan (grid) distance, for vertex data with x( ) and y( )
+template<class WeightT = int>
+struct manhattan_heuristic {
+	typedef WeightT result_type;
+
+	double m_dScale;
+
+	explicit manhattan_heuristic( double scale = 1.0 ): m_dScale( scale )
+	{ }
+
+	template<class VDT>
+	WeightT operator()( const VDT &v, const VDT &t ) const {
+		double dx = std::fabs(( double )v.x() - ( double )t.x() );
+		double dy = std::fabs(( double )v.y() - ( double )t.y() );
+		return ( WeightT )( m_dScale * ( dx + dy ) );
+	}
+};
+
+/// no estimate: A* searches as Dijkstra's algorithm
+template<class WeightT>
+struct zero_heuristic {
+	typedef WeightT result_type;
+
+	template<class VDT>
+	WeightT operator()( const VDT &, const VDT & ) const {
+		return ( WeightT )0;
+	}
+};
+//@}
+
+/** A* search for a shortest path from nsource to ndst.
+    Nodes come out of the queue by path length so far plus the estimate
+    h( v, t ) of the rest; the closer the estimate, the fewer nodes are
+    settled. With an admissible h the path is a shortest one (a node is
+    searched again if a shorter path to it is found later, so h need not
+    be consistent); with h always 0 it is Dijkstra's algorithm stopped at
+    ndst.
+    @param graph graph on which to find the path, no negative weighted edge.
+    @param f_weight edge weight function, pass pointer
+    @param w_infty an upper bound value of weight which should be larger
+      than the path length of any valid path
+    @param h heuristic, called as h( graph[i].vertex_d( ), graph[ndst].vertex_d( ) )
+    @param lp result path
+    @param pnsettled if not NULL, to store the number of nodes settled
+    @return path length, w_infty if no path found.
+    @see dijkstra_t euclid_heuristic manhattan_heuristic
+*/
+template< class GraphT, class Fun, class Heuristic >
+typename Fun::result_type astar( const GraphT &graph, int nsource, int ndst,
+								 Fun f_weight, typename Fun::result_type w_infty,
+								 Heuristic h, CPath &lp, int *pnsettled = NULL )
+{
+	typedef graph_view<GraphT> GV;
+	typedef typename Fun::result_type WeightT;
+	lp.clear();
+	if( pnsettled ) {
+		*pnsettled = 0;
+	}
+	if( !GV::is_valid( graph, nsource ) || !GV::is_valid( graph, ndst ) ) {
+		return w_infty;
+	}
+
+	int n = GV::range( graph );
+	// path length from nsource, estimate to ndst (if vhdone)
+	std::vector<WeightT> vg( n, w_infty ), vh( n );
+	std::vector<char> vhdone( n, 0 );
+	std::vector<int> vpred( n, -1 );
+	afl::indexed_heap<WeightT> pq( n );
+
+	const typename GraphT::VDT &vdst = graph[ndst].vertex_d();
+	vg[nsource] = ( WeightT )0;
+	vh[nsource] = h( graph[nsource].vertex_d(), vdst );
+	vhdone[nsource] = 1;
+	pq.push( nsource, vh[nsource] );
+
+	int nvertex, nto, nsettled = 0;
+	WeightT w;
+	typename GV::const_e_iterator ite, iend;
+	while( !pq.empty() ) {
+		nvertex = pq.top();
+		pq.pop();
+		++nsettled;
+		if( nvertex == ndst ) {
+			break;
+		}
+		iend = GV::e_end( graph, nvertex );
+		for( ite = GV::e_begin( graph, nvertex ); ite != iend; ++ite ) {
+			nto = GV::to( ite );
+			w = vg[nvertex] + f_weight( &( GV::edge_d( ite ) ) );
+			if( w < vg[nto] ) {
+				vg[nto] = w;
+				vpred[nto] = nvertex;
+				if( !vhdone[nto] ) {
+					vh[nto] = h( graph[nto].vertex_d(), vdst );
+					vhdone[nto] = 1;
+				}
+				pq.push( nto, w + vh[nto] );
+			}
+		}
+	}
+
+	if( pnsettled ) {
+		*pnsettled = nsettled;
+	}
+	if( !( vg[ndst] < w_infty ) || !pred2path( vpred, nsource, ndst, lp ) ) {
+		lp.clear();
+		return w_infty;
+	}
+	return vg[ndst];
+}
+
+/**@}*/
+
+} // end of namespace afg
+
+#endif
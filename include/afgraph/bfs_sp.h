@@ -0,0 +1,347 @@
+/*@copyright
+
+Copyright (c) 2012 Aiguo Fei
+All rights reserved.
+
+Permission to use and re-distribute this code in source and binary forms
+with or without modifications is therefore granted provided that
+the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Information regarding where to obtain the original source code must be
+      included with the redistrbution.
+
+*NO WARRANTY*
+THIS CODE OR PROGRAM IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S)
+"AS IS" WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE. THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S) MUST NOT BE
+HELD RESPONSIBLE FOR ANY DAMAGE OR UNDESIRED EFFECT CAUSED DIRECTLY OR
+INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
+
+*/
+
+
+
+
+/**@file bfs_sp.h
+
+  shortest paths by hop count (all edges of weight 1) by breadth-first
+  search, switching between top-down and bottom-up steps (after Beamer,
+  Asanovic and Patterson, "direction-optimizing" search).
+  dijkstra( ) uses it for the weight function afl::runit_p.
+
+*/
+
+#ifndef _AFG_BFS_SP_H_
+#define _AFG_BFS_SP_H_
+
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+
+#include "afl/util_tl.hpp"
+#include "graph_view.h"
+
+namespace afg
+{
+
+/**@addtogroup gspalg
+*/
+/**@{*/
+
+/// is_unit_weight<Fun>::value is true if Fun gives weight 1 to every edge
+template<class Fun>
+struct is_unit_weight: public std::false_type {
+};
+
+template<class T>
+struct is_unit_weight< afl::runit_p<T> >: public std::true_type {
+};
+
+/** breadth-first search for shortest paths by hop count.
+    A top-down step goes through the out-edges of the nodes of the
+    frontier (the last level found); a bottom-up step goes through the
+    nodes not reached yet and looks for an in-edge from the frontier,
+    stopping at the first one. Bottom-up steps are taken while the
+    frontier is large: from when the out-edges of the frontier are more
+    than 1/alpha of the in-edges of the nodes not reached, until the
+    frontier is shrinking and has fewer than 1/beta of the nodes (see
+    set_switch( ), 14 and 24 by default).
+
+    In-edges are those of the in-edge index of a CGraph if it is kept
+    (see CGraph::enable_in_index( )); otherwise a transposed copy of the
+    graph (edge sources only, in compressed rows) is made, O(V+E) time
+    and memory, unless top-down steps only are asked for. The graph
+    must not be changed while a CspBfs of it is in use.
+
+    pred and dist are as dijkstra( ) gives them for afl::runit_p: with
+    top-down steps only they are exactly the same, as each level is gone
+    through in the order dijkstra( ) settles it; a node reached by a
+    bottom-up step may have another predecessor on the same level.
+    @see bfs_sp dijkstra
+*/
+template<class GraphT>
+class CspBfs
+{
+protected:
+	typedef graph_view<GraphT> GV;
+
+	const GraphT &m_Graph;
+	// true if in-edges are those of the in-edge index of the graph
+	bool m_bIndex;
+	// true if bottom-up steps can be taken
+	bool m_bUp;
+	// transposed copy: in-edges of j are from m_vSrc[m_vOff[j]..m_vOff[j+1]-1]
+	std::vector<int> m_vOff;
+	std::vector<int> m_vSrc;
+	int m_nAlpha, m_nBeta;
+	std::vector<int> m_vFront, m_vNext;
+	std::vector<unsigned char> m_vInFront;
+	int m_nLevels, m_nUpLevels;
+
+public:
+	/** constructor.
+	    @param btranspose if the graph keeps no in-edge index: true to
+	      make a transposed copy of it, false for top-down steps only.
+	*/
+	explicit CspBfs( const GraphT &g, bool btranspose = true )
+		: m_Graph( g ), m_bIndex( has_index( g, is_cgraph<GraphT>() ) ),
+		  m_bUp( m_bIndex || btranspose ), m_nAlpha( 14 ), m_nBeta( 24 ),
+		  m_nLevels( 0 ), m_nUpLevels( 0 ) {
+		if( m_bUp && !m_bIndex ) {
+			transpose();
+		}
+	}
+
+	/// true if bottom-up steps can be taken
+	bool bottom_up( void ) const {
+		return m_bUp;
+	}
+
+	/** set when to switch between top-down and bottom-up steps,
+	    alpha and beta as in the class description.
+	*/
+	void set_switch( int alpha, int beta ) {
+		m_nAlpha = alpha;
+		m_nBeta = beta;
+	}
+
+	/// top-down steps only from now on, even over an in-edge index: the
+	/// pred of dijkstra( ) exactly
+	void set_top_down( void ) {
+		m_bUp = false;
+	}
+
+	/// levels (steps) of the last search
+	int levels( void ) const {
+		return m_nLevels;
+	}
+
+	/// levels of the last search found by bottom-up steps
+	int bottom_up_levels( void ) const {
+		return m_nUpLevels;
+	}
+
+	/** shortest paths by hop count from nsource.
+	    @param w_infty distance of nodes not reached; levels at or beyond
+	      it are not searched.
+	    @param pred predecessors as dijkstra( ) gives, resized to
+	      graph.range( ) if smaller.
+	    @param dist hop counts, resized to graph.range( ) if smaller.
+	    @return false if nsource is not a valid node.
+	*/
+	template<class DistT>
+	bool run( int nsource, DistT w_infty, std::vector<int>& pred,
+			  std::vector<DistT>& dist ) {
+		m_nLevels = m_nUpLevels = 0;
+		if( !GV::is_valid( m_Graph, nsource ) ) {
+			return false;
+		}
+		int n = GV::range( m_Graph );
+		if(( int )pred.size() < n ) {
+			pred.resize( n );
+		}
+		if(( int )dist.size() < n ) {
+			dist.resize( n );
+		}
+		std::fill( pred.begin(), pred.begin() + n, -1 );
+		std::fill( dist.begin(), dist.begin() + n, w_infty );
+		dist[nsource] = ( DistT )0;
+		m_vFront.assign( 1, nsource );
+		// in-edges of the nodes not reached
+		long long nunreached = 0;
+		if( m_bUp ) {
+			m_vInFront.assign( n, 0 );
+			nunreached = in_edges() - in_degree( nsource );
+		}
+		bool bup = false;
+		size_t nlast = 0;
+		DistT d = ( DistT )0;
+		typename GV::const_e_iterator ite, iend;
+		while( !m_vFront.empty() ) {
+			d = d + ( DistT )1;
+			if( !( d < w_infty ) ) {
+				break;
+			}
+			++m_nLevels;
+			if( m_bUp && !bup ) {
+				long long nfront = 0;
+				for( size_t k = 0; k < m_vFront.size(); ++k ) {
+					nfront += GV::out_degree( m_Graph, m_vFront[k] );
+				}
+				bup = nfront * m_nAlpha > nunreached && m_vFront.size() > nlast;
+			} else if( bup ) {
+				bup = !(( long long )m_vFront.size() * m_nBeta < n && m_vFront.size() < nlast );
+			}
+			m_vNext.clear();
+			if( bup ) {
+				++m_nUpLevels;
+				for( size_t k = 0; k < m_vFront.size(); ++k ) {
+					m_vInFront[m_vFront[k]] = 1;
+				}
+				for( int v = 0; v < n; ++v ) {
+					if( dist[v] == w_infty && GV::is_valid( m_Graph, v ) ) {
+						int p = parent( v, is_cgraph<GraphT>() );
+						if( p >= 0 ) {
+							dist[v] = d;
+							pred[v] = p;
+							m_vNext.push_back( v );
+							nunreached -= in_degree( v );
+						}
+					}
+				}
+				for( size_t k = 0; k < m_vFront.size(); ++k ) {
+					m_vInFront[m_vFront[k]] = 0;
+				}
+			} else {
+				for( size_t k = 0; k < m_vFront.size(); ++k ) {
+					int u = m_vFront[k];
+					iend = GV::e_end( m_Graph, u );
+					for( ite = GV::e_begin( m_Graph, u ); ite != iend; ++ite ) {
+						int v = GV::to( ite );
+						if( dist[v] == w_infty ) {
+							dist[v] = d;
+							pred[v] = u;
+							m_vNext.push_back( v );
+						}
+					}
+				}
+				if( m_bUp ) {
+					for( size_t k = 0; k < m_vNext.size(); ++k ) {
+						nunreached -= in_degree( m_vNext[k] );
+					}
+				}
+				// dijkstra( ) settles the nodes of a level last found first
+				std::reverse( m_vNext.begin(), m_vNext.end() );
+			}
+			nlast = m_vFront.size();
+			m_vFront.swap( m_vNext );
+		}
+		return true;
+	}
+
+protected:
+	static bool has_index( const GraphT &g, std::true_type ) {
+		return g.has_in_index();
+	}
+
+	static bool has_index( const GraphT &, std::false_type ) {
+		return false;
+	}
+
+	int in_degree( int j ) const {
+		return m_bIndex ? index_degree( j, is_cgraph<GraphT>() )
+			   : m_vOff[j + 1] - m_vOff[j];
+	}
+
+	int index_degree( int j, std::true_type ) const {
+		return m_Graph.in_degree( j );
+	}
+
+	int index_degree( int, std::false_type ) const {
+		return 0;
+	}
+
+	long long in_edges( void ) const {
+		if( !m_bIndex ) {
+			return ( long long )m_vSrc.size();
+		}
+		long long ne = 0;
+		for( int j = 0; j < GV::range( m_Graph ); ++j ) {
+			ne += in_degree( j );
+		}
+		return ne;
+	}
+
+	// first node of the frontier with an edge to v, -1 if none
+	int parent( int v, std::true_type ) const {
+		if( !m_bIndex ) {
+			return parent( v, std::false_type() );
+		}
+		typename GraphT::in_iterator it, iend = m_Graph.in_end( v );
+		for( it = m_Graph.in_begin( v ); it != iend; ++it ) {
+			if( m_vInFront[*it] ) {
+				return *it;
+			}
+		}
+		return -1;
+	}
+
+	int parent( int v, std::false_type ) const {
+		for( int k = m_vOff[v]; k < m_vOff[v + 1]; ++k ) {
+			if( m_vInFront[m_vSrc[k]] ) {
+				return m_vSrc[k];
+			}
+		}
+		return -1;
+	}
+
+	void transpose( void ) {
+		int n = GV::range( m_Graph );
+		typename GV::const_e_iterator ite, iend;
+		m_vOff.assign( n + 1, 0 );
+		int i;
+		for( i = 0; i < n; ++i ) {
+			iend = GV::e_end( m_Graph, i );
+			for( ite = GV::e_begin( m_Graph, i ); ite != iend; ++ite ) {
+				++m_vOff[GV::to( ite ) + 1];
+			}
+		}
+		for( i = 0; i < n; ++i ) {
+			m_vOff[i + 1] += m_vOff[i];
+		}
+		m_vSrc.resize( m_vOff[n] );
+		std::vector<int> vpos( m_vOff.begin(), m_vOff.end() - 1 );
+		for( i = 0; i < n; ++i ) {
+			iend = GV::e_end( m_Graph, i );
+			for( ite = GV::e_begin( m_Graph, i ); ite != iend; ++ite ) {
+				m_vSrc[vpos[GV::to( ite )]++] = i;
+			}
+		}
+	}
+};
+
+/** shortest paths by hop count from nsource, by breadth-first search
+    (see CspBfs): bottom-up steps too if the graph keeps an in-edge
+    index, top-down steps only (and exactly the pred of dijkstra( ))
+    otherwise. For many searches of the same graph, keep a CspBfs.
+    @return false if nsource is not a valid node.
+    @see CspBfs dijkstra
+*/
+template<class GraphT, class DistT>
+bool bfs_sp( const GraphT &graph, int nsource, DistT w_infty,
+			 std::vector<int>& pred, std::vector<DistT>& dist )
+{
+	CspBfs<GraphT> bfs( graph, false );
+	return bfs.run( nsource, w_infty, pred, dist );
+}
+
+/**@}*/
+
+} // end of namespace afg
+
+#endif
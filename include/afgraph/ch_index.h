@@ -0,0 +1,767 @@
+/*@copyright
+
+Copyright (c) 2012 Aiguo Fei
+All rights reserved.
+
+Permission to use and re-distribute this code in source and binary forms
+with or without modifications is therefore granted provided that
+the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Information regarding where to obtain the original source code must be
+      included with the redistrbution.
+
+*NO WARRANTY*
+THIS CODE OR PROGRAM IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S)
+"AS IS" WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE. THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S) MUST NOT BE
+HELD RESPONSIBLE FOR ANY DAMAGE OR UNDESIRED EFFECT CAUSED DIRECTLY OR
+INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
+
+*/
+
+
+
+
+/**@file ch_index.h
+
+  Contraction hierarchy (Geisberger et al.) for repeated point to point
+  shortest path queries on a fixed graph: CchIndex is built once, can be
+  saved to and loaded from a file, and CchQuery answers queries by two
+  small searches instead of a Dijkstra search over the whole graph.
+
+*/
+
+#ifndef _AFG_CH_INDEX_H_
+#define _AFG_CH_INDEX_H_
+
+#include <iostream>
+#include <vector>
+#include <queue>
+#include <functional>
+#include <utility>
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+#include "afl/indexed_heap.hpp"
+#include "path.h"
+#include "graph_view.h"
+
+namespace afg
+{
+
+/**@addtogroup gspalg
+*/
+/**@{*/
+
+/** contraction hierarchy of a directed graph with non-negative weights.
+    Nodes are contracted one by one, least important first (by the
+    number of shortcuts a contraction adds less the edges it removes,
+    plus its contracted neighbors): removing v, for each path u->v->x
+    with no other path as short (a witness, looked for by a search of at
+    most witness_limit nodes), a shortcut u->x is added. Each node then
+    keeps its edges to nodes contracted later (up) and those from them
+    (down); a shortest path goes up from the source and down to the
+    target, so a query only searches up from both ends. Shortcuts remember
+    the node they skip, to unpack them to edges of the graph.
+    Parallel edges count as the lightest of them, self loops are left
+    out. Index i of the graph is node i of the hierarchy.
+    @see CchQuery
+*/
+template<class WeightT>
+class CchIndex
+{
+	template<class W> friend class CchQuery;
+
+public:
+	/// weight type
+	typedef WeightT WT;
+
+protected:
+	// an edge during contraction: to (or from) v, skipping mid (-1 if an
+	// edge of the graph)
+	struct arc {
+		int v;
+		int mid;
+		WeightT w;
+	};
+
+	/**@name data members */
+	//@{
+	/// number of nodes (range of the graph)
+	int m_nSize;
+	/// distance of no path
+	WeightT m_wInfty;
+	/// order of contraction of each node
+	std::vector<int> m_vRank;
+	/// up edges of v (to x contracted after v): [m_vUpOff[v], m_vUpOff[v+1])
+	std::vector<int> m_vUpOff, m_vUpTo, m_vUpMid;
+	std::vector<WeightT> m_vUpW;
+	/// down edges into v (from u contracted after v): [m_vDnOff[v], m_vDnOff[v+1])
+	std::vector<int> m_vDnOff, m_vDnFrom, m_vDnMid;
+	std::vector<WeightT> m_vDnW;
+	//@}
+
+public:
+	/// constructor, an empty index
+	CchIndex(): m_nSize( 0 ), m_wInfty( WeightT() ) {
+		m_vUpOff.assign( 1, 0 );
+		m_vDnOff.assign( 1, 0 );
+	}
+
+	/// number of nodes
+	int size( void ) const {
+		return m_nSize;
+	}
+
+	/// distance returned when there is no path
+	WeightT w_infty( void ) const {
+		return m_wInfty;
+	}
+
+	/// edges of the hierarchy, those of the graph kept and shortcuts
+	int size_e( void ) const {
+		return ( int )( m_vUpTo.size() + m_vDnFrom.size() );
+	}
+
+	/// order in which node i was contracted
+	int rank( int i ) const {
+		return m_vRank[i];
+	}
+
+	/** build the hierarchy of a graph.
+	    @param f_weight edge weight function, pass pointer; no negative weight
+	    @param w_infty larger than the length of any path
+	    @param witness_limit nodes a witness search settles at most; the
+	      smaller, the faster to build, the more shortcuts
+	    @return false if an edge points to an out of range index
+	*/
+	template< class GraphT, class Fun >
+	bool build( const GraphT &graph, Fun f_weight, WeightT w_infty,
+				int witness_limit = 500 ) {
+		typedef graph_view<GraphT> GV;
+		int n = GV::range( graph );
+		m_nSize = 0;
+		m_wInfty = w_infty;
+		std::vector<std::vector<arc> > vout( n ), vin( n );
+		// position in vout[i] of the edge to j from the current node i
+		std::vector<int> vpos( n, -1 );
+		typename GV::const_e_iterator ite, iend;
+		for( int i = 0; i < n; ++i ) {
+			iend = GV::e_end( graph, i );
+			for( ite = GV::e_begin( graph, i ); ite != iend; ++ite ) {
+				int j = GV::to( ite );
+				if( j < 0 || j >= n ) {
+					return false;
+				}
+				WeightT w = f_weight( &( GV::edge_d( ite ) ) );
+				if( j == i ) {
+					continue;
+				}
+				int k = vpos[j];
+				if( k >= 0 && k < ( int )vout[i].size() && vout[i][k].v == j ) {
+					if( w < vout[i][k].w ) {
+						vout[i][k].w = w;
+					}
+				} else {
+					vpos[j] = ( int )vout[i].size();
+					arc a = { j, -1, w };
+					vout[i].push_back( a );
+				}
+			}
+		}
+		for( int i = 0; i < n; ++i ) {
+			for( size_t k = 0; k < vout[i].size(); ++k ) {
+				arc a = { i, -1, vout[i][k].w };
+				vin[vout[i][k].v].push_back( a );
+			}
+		}
+
+		contract_all( vout, vin, witness_limit );
+		m_nSize = n;
+		return true;
+	}
+
+	/** write the index to os (binary), to be read back by load( ) on
+	    a machine of the same byte order.
+	    @return false if writing failed
+	*/
+	bool save( std::ostream &os ) const {
+		os.write( s_magic(), 8 );
+		int hdr[2] = { ( int )sizeof( WeightT ), m_nSize };
+		os.write(( const char * )hdr, sizeof( hdr ) );
+		os.write(( const char * )&m_wInfty, sizeof( WeightT ) );
+		write_v( os, m_vRank );
+		write_v( os, m_vUpOff );
+		write_v( os, m_vUpTo );
+		write_v( os, m_vUpMid );
+		write_v( os, m_vUpW );
+		write_v( os, m_vDnOff );
+		write_v( os, m_vDnFrom );
+		write_v( os, m_vDnMid );
+		write_v( os, m_vDnW );
+		return ( bool )os;
+	}
+
+	/** read an index written by save( ).
+	    @return false if is does not hold one (of this weight type), the
+	      index is then empty
+	*/
+	bool load( std::istream &is ) {
+		char magic[8];
+		int hdr[2] = { 0, 0 };
+		is.read( magic, 8 );
+		is.read(( char * )hdr, sizeof( hdr ) );
+		is.read(( char * )&m_wInfty, sizeof( WeightT ) );
+		bool ok = is && std::memcmp( magic, s_magic(), 8 ) == 0
+				  && hdr[0] == ( int )sizeof( WeightT ) && hdr[1] >= 0;
+		m_nSize = hdr[1];
+		ok = ok && read_v( is, m_vRank ) && read_v( is, m_vUpOff )
+			 && read_v( is, m_vUpTo ) && read_v( is, m_vUpMid )
+			 && read_v( is, m_vUpW ) && read_v( is, m_vDnOff )
+			 && read_v( is, m_vDnFrom ) && read_v( is, m_vDnMid )
+			 && read_v( is, m_vDnW ) && consistent();
+		if( !ok ) {
+			CchIndex<WeightT> tmp;
+			swap( tmp );
+		}
+		return ok;
+	}
+
+	/// exchange contents with another index
+	void swap( CchIndex<WeightT> &rhs ) {
+		std::swap( m_nSize, rhs.m_nSize );
+		std::swap( m_wInfty, rhs.m_wInfty );
+		m_vRank.swap( rhs.m_vRank );
+		m_vUpOff.swap( rhs.m_vUpOff );
+		m_vUpTo.swap( rhs.m_vUpTo );
+		m_vUpMid.swap( rhs.m_vUpMid );
+		m_vUpW.swap( rhs.m_vUpW );
+		m_vDnOff.swap( rhs.m_vDnOff );
+		m_vDnFrom.swap( rhs.m_vDnFrom );
+		m_vDnMid.swap( rhs.m_vDnMid );
+		m_vDnW.swap( rhs.m_vDnW );
+	}
+
+protected:
+	static const char *s_magic( void ) {
+		return "AFGCH01\n";
+	}
+
+	template<class T>
+	static void write_v( std::ostream &os, const std::vector<T> &v ) {
+		long long len = ( long long )v.size();
+		os.write(( const char * )&len, sizeof( len ) );
+		if( len > 0 ) {
+			os.write(( const char * )&v[0], ( std::streamsize )( len * sizeof( T ) ) );
+		}
+	}
+
+	// read in parts, so that a bad length fails at the end of the data
+	// instead of allocating it
+	template<class T>
+	static bool read_v( std::istream &is, std::vector<T> &v ) {
+		long long len = -1;
+		is.read(( char * )&len, sizeof( len ) );
+		v.clear();
+		if( !is || len < 0 ) {
+			return false;
+		}
+		const size_t part = 1 << 16;
+		while( is && v.size() < ( size_t )len ) {
+			size_t k = v.size(), m = std::min( part, ( size_t )len - k );
+			v.resize( k + m );
+			is.read(( char * )&v[k], ( std::streamsize )( m * sizeof( T ) ) );
+		}
+		return ( bool )is;
+	}
+
+	// a loaded index as build( ) makes it: sizes and indices within range,
+	// ranks an order of the nodes, edges going up in rank, and the two
+	// edges of each shortcut there, through a node of lower rank (which
+	// CchQuery::unpack( ) counts on)
+	bool consistent( void ) const {
+		size_t n = ( size_t )m_nSize;
+		if( m_vRank.size() != n || m_vUpOff.size() != n + 1 || m_vDnOff.size() != n + 1
+				|| m_vUpOff[0] != 0 || m_vDnOff[0] != 0
+				|| m_vUpOff[n] != ( int )m_vUpTo.size() || m_vDnOff[n] != ( int )m_vDnFrom.size()
+				|| m_vUpMid.size() != m_vUpTo.size() || m_vUpW.size() != m_vUpTo.size()
+				|| m_vDnMid.size() != m_vDnFrom.size() || m_vDnW.size() != m_vDnFrom.size() ) {
+			return false;
+		}
+		for( size_t i = 0; i < n; ++i ) {
+			if( m_vUpOff[i] > m_vUpOff[i + 1] || m_vDnOff[i] > m_vDnOff[i + 1] ) {
+				return false;
+			}
+		}
+		for( size_t k = 0; k < m_vUpTo.size(); ++k ) {
+			if( m_vUpTo[k] < 0 || m_vUpTo[k] >= m_nSize || m_vUpMid[k] >= m_nSize ) {
+				return false;
+			}
+		}
+		for( size_t k = 0; k < m_vDnFrom.size(); ++k ) {
+			if( m_vDnFrom[k] < 0 || m_vDnFrom[k] >= m_nSize || m_vDnMid[k] >= m_nSize ) {
+				return false;
+			}
+		}
+		std::vector<char> vseen( n, 0 );
+		for( size_t i = 0; i < n; ++i ) {
+			int r = m_vRank[i];
+			if( r < 0 || r >= m_nSize || vseen[r] ) {
+				return false;
+			}
+			vseen[r] = 1;
+		}
+		for( int v = 0; v < m_nSize; ++v ) {
+			int k;
+			for( k = m_vUpOff[v]; k < m_vUpOff[v + 1]; ++k ) {
+				if( !edge_ok( v, m_vUpTo[k], v, m_vUpTo[k], m_vUpMid[k] ) ) {
+					return false;
+				}
+			}
+			for( k = m_vDnOff[v]; k < m_vDnOff[v + 1]; ++k ) {
+				if( !edge_ok( v, m_vDnFrom[k], m_vDnFrom[k], v, m_vDnMid[k] ) ) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	// edge a->b, kept at v for x of higher rank (an up edge of v or a down
+	// edge into it); a shortcut through mid of lower rank than v, with a
+	// down edge a->mid and an up edge mid->b
+	bool edge_ok( int v, int x, int a, int b, int mid ) const {
+		if( m_vRank[x] <= m_vRank[v] ) {
+			return false;
+		}
+		if( mid < 0 ) {
+			return true;
+		}
+		if( m_vRank[mid] >= m_vRank[v] ) {
+			return false;
+		}
+		int k;
+		for( k = m_vDnOff[mid]; k < m_vDnOff[mid + 1] && m_vDnFrom[k] != a; ++k )
+			;
+		if( k == m_vDnOff[mid + 1] ) {
+			return false;
+		}
+		for( k = m_vUpOff[mid]; k < m_vUpOff[mid + 1] && m_vUpTo[k] != b; ++k )
+			;
+		return k < m_vUpOff[mid + 1];
+	}
+
+	// buffers of witness_search( ): distances of nodes reached, those
+	// reached, out-neighbors of v to settle
+	struct witness_ws {
+		std::vector<WeightT> vd;
+		std::vector<char> vreached;
+		std::vector<int> vtouched;
+		std::vector<char> vtarget;
+		afl::indexed_heap<WeightT> heap;
+	};
+
+	// bounded Dijkstra search from u not through v, stopping past wmax,
+	// after limit nodes or once ntarget targets are settled
+	static void witness_search( const std::vector<std::vector<arc> > &vout,
+								int u, int v, WeightT wmax, int limit, int ntarget,
+								witness_ws &ws ) {
+		for( size_t k = 0; k < ws.vtouched.size(); ++k ) {
+			ws.vreached[ws.vtouched[k]] = 0;
+		}
+		ws.vtouched.clear();
+		ws.heap.clear();
+		ws.vd[u] = WeightT();
+		ws.vreached[u] = 1;
+		ws.vtouched.push_back( u );
+		ws.heap.push( u, WeightT() );
+		int nsettled = 0;
+		while( !ws.heap.empty() && nsettled < limit ) {
+			int a = ws.heap.top();
+			WeightT da = ws.heap.top_key();
+			ws.heap.pop();
+			++nsettled;
+			if( wmax < da || ( ws.vtarget[a] && --ntarget == 0 ) ) {
+				break;
+			}
+			const std::vector<arc> &va = vout[a];
+			for( size_t k = 0; k < va.size(); ++k ) {
+				int b = va[k].v;
+				if( b == v ) {
+					continue;
+				}
+				WeightT db = da + va[k].w;
+				if( !ws.vreached[b] ) {
+					ws.vreached[b] = 1;
+					ws.vtouched.push_back( b );
+					ws.vd[b] = db;
+					ws.heap.push( b, db );
+				} else if( db < ws.vd[b] ) {
+					ws.vd[b] = db;
+					ws.heap.push( b, db );
+				}
+			}
+		}
+	}
+
+	// shortcuts contracting v adds (or their number, if vsc is NULL)
+	static int shortcuts( const std::vector<std::vector<arc> > &vout,
+						  const std::vector<std::vector<arc> > &vin, int v,
+						  int limit, witness_ws &ws,
+						  std::vector<std::pair<int, arc> > *vsc ) {
+		const std::vector<arc> &vi = vin[v], &vo = vout[v];
+		if( vi.empty() || vo.empty() ) {
+			return 0;
+		}
+		WeightT womax = vo[0].w;
+		for( size_t k = 1; k < vo.size(); ++k ) {
+			if( womax < vo[k].w ) {
+				womax = vo[k].w;
+			}
+		}
+		for( size_t k = 0; k < vo.size(); ++k ) {
+			ws.vtarget[vo[k].v] = 1;
+		}
+		int nsc = 0;
+		for( size_t i = 0; i < vi.size(); ++i ) {
+			int u = vi[i].v;
+			witness_search( vout, u, v, vi[i].w + womax, limit, ( int )vo.size(), ws );
+			for( size_t k = 0; k < vo.size(); ++k ) {
+				int x = vo[k].v;
+				WeightT w = vi[i].w + vo[k].w;
+				if( x == u || ( ws.vreached[x] && !( w < ws.vd[x] ) ) ) {
+					continue;
+				}
+				++nsc;
+				if( vsc ) {
+					arc a = { x, v, w };
+					vsc->push_back( std::make_pair( u, a ) );
+				}
+			}
+		}
+		for( size_t k = 0; k < vo.size(); ++k ) {
+			ws.vtarget[vo[k].v] = 0;
+		}
+		return nsc;
+	}
+
+	// arc to v in va, -1 if none
+	static int find_arc( const std::vector<arc> &va, int v ) {
+		for( size_t k = 0; k < va.size(); ++k ) {
+			if( va[k].v == v ) {
+				return ( int )k;
+			}
+		}
+		return -1;
+	}
+
+	static void erase_arc( std::vector<arc> &va, int v ) {
+		int k = find_arc( va, v );
+		if( k >= 0 ) {
+			va[k] = va.back();
+			va.pop_back();
+		}
+	}
+
+	// contract the nodes in order of priority and keep the final edges
+	void contract_all( std::vector<std::vector<arc> > &vout,
+					   std::vector<std::vector<arc> > &vin, int limit ) {
+		int n = ( int )vout.size();
+		witness_ws ws;
+		ws.vd.assign( n, WeightT() );
+		ws.vreached.assign( n, 0 );
+		ws.vtarget.assign( n, 0 );
+		ws.heap.reset( n );
+		std::vector<int> vdeleted( n, 0 ), vprio( n );
+		typedef std::pair<int, int> PI;
+		std::priority_queue<PI, std::vector<PI>, std::greater<PI> > pq;
+		for( int v = 0; v < n; ++v ) {
+			vprio[v] = priority( vout, vin, v, vdeleted,
+								 shortcuts( vout, vin, v, limit, ws, NULL ) );
+			pq.push( PI( vprio[v], v ) );
+		}
+
+		m_vRank.assign( n, -1 );
+		std::vector<std::vector<arc> > vup( n ), vdn( n );
+		std::vector<std::pair<int, arc> > vsc;
+		int rank = 0;
+		while( !pq.empty() ) {
+			PI top = pq.top();
+			pq.pop();
+			int v = top.second;
+			if( m_vRank[v] >= 0 || top.first != vprio[v] ) {
+				continue;
+			}
+			// lazy update: contract v only if it still comes first
+			vsc.clear();
+			int p = priority( vout, vin, v, vdeleted,
+							  shortcuts( vout, vin, v, limit, ws, &vsc ) );
+			if( p != vprio[v] ) {
+				vprio[v] = p;
+				if( !pq.empty() && pq.top() < PI( p, v ) ) {
+					pq.push( PI( p, v ) );
+					continue;
+				}
+			}
+
+			m_vRank[v] = rank++;
+			vup[v].swap( vout[v] );
+			vdn[v].swap( vin[v] );
+			for( size_t k = 0; k < vup[v].size(); ++k ) {
+				erase_arc( vin[vup[v][k].v], v );
+			}
+			for( size_t k = 0; k < vdn[v].size(); ++k ) {
+				erase_arc( vout[vdn[v][k].v], v );
+			}
+			for( size_t k = 0; k < vsc.size(); ++k ) {
+				int u = vsc[k].first;
+				const arc &a = vsc[k].second;
+				int j = find_arc( vout[u], a.v );
+				if( j < 0 ) {
+					vout[u].push_back( a );
+					arc b = { u, a.mid, a.w };
+					vin[a.v].push_back( b );
+				} else if( a.w < vout[u][j].w ) {
+					vout[u][j] = a;
+					arc &b = vin[a.v][find_arc( vin[a.v], u )];
+					b.mid = a.mid;
+					b.w = a.w;
+				}
+			}
+			// neighbors have one more contracted neighbor; their priority
+			// is brought up to date when they come first (lazy updates:
+			// updating it now costs too much around nodes of high degree)
+			for( size_t k = 0; k < vup[v].size(); ++k ) {
+				++vdeleted[vup[v][k].v];
+			}
+			for( size_t k = 0; k < vdn[v].size(); ++k ) {
+				++vdeleted[vdn[v][k].v];
+			}
+		}
+
+		flatten( vup, m_vUpOff, m_vUpTo, m_vUpMid, m_vUpW );
+		flatten( vdn, m_vDnOff, m_vDnFrom, m_vDnMid, m_vDnW );
+	}
+
+	// priority of v (the smaller, the sooner contracted) which nsc
+	// shortcuts would replace
+	static int priority( const std::vector<std::vector<arc> > &vout,
+						 const std::vector<std::vector<arc> > &vin, int v,
+						 const std::vector<int> &vdeleted, int nsc ) {
+		return 2 * ( nsc - ( int )( vout[v].size() + vin[v].size() ) ) + vdeleted[v];
+	}
+
+	static void flatten( const std::vector<std::vector<arc> > &va, std::vector<int> &voff,
+						 std::vector<int> &vto, std::vector<int> &vmid,
+						 std::vector<WeightT> &vw ) {
+		int n = ( int )va.size();
+		voff.assign( n + 1, 0 );
+		for( int i = 0; i < n; ++i ) {
+			voff[i + 1] = voff[i] + ( int )va[i].size();
+		}
+		vto.resize( voff[n] );
+		vmid.resize( voff[n] );
+		vw.resize( voff[n] );
+		for( int i = 0; i < n; ++i ) {
+			for( size_t k = 0; k < va[i].size(); ++k ) {
+				vto[voff[i] + k] = va[i][k].v;
+				vmid[voff[i] + k] = va[i][k].mid;
+				vw[voff[i] + k] = va[i][k].w;
+			}
+		}
+	}
+};
+
+/** point to point shortest path queries on a CchIndex, with the search
+    buffers kept from one query to the next: a query costs what its two
+    searches reach. One CchQuery per thread; several may share an index.
+    Distances are those of dijkstra( ); where several paths are shortest
+    the path may be another one.
+*/
+template<class WeightT>
+class CchQuery
+{
+protected:
+	const CchIndex<WeightT> *m_pIdx;
+	// of the forward (0) and backward (1) search: distance, edge of the
+	// hierarchy reaching the node (index into up or down edges), stamp
+	// of the query which reached it
+	std::vector<WeightT> m_vDist[2];
+	std::vector<int> m_vEdge[2];
+	std::vector<unsigned int> m_vStamp[2];
+	afl::indexed_heap<WeightT> m_Heap[2];
+	unsigned int m_nStamp;
+	// up edges from s to where the searches meet, last first
+	std::vector<int> m_vFwd;
+	// edges of the hierarchy to unpack: from, to, node skipped
+	std::vector<int> m_vStack;
+
+public:
+	/// constructor, queries on idx (which must outlive this)
+	explicit CchQuery( const CchIndex<WeightT> &idx ): m_pIdx( &idx ), m_nStamp( 0 ) {
+		int n = idx.size();
+		for( int d = 0; d < 2; ++d ) {
+			m_vDist[d].assign( n, WeightT() );
+			m_vEdge[d].assign( n, -1 );
+			m_vStamp[d].assign( n, 0 );
+			m_Heap[d].reset( n );
+		}
+	}
+
+	/** length of the shortest path from s to t, idx.w_infty( ) if there
+	    is none or s or t is out of range.
+	*/
+	WeightT distance( int s, int t ) {
+		int meet;
+		return search( s, t, meet );
+	}
+
+	/** shortest path from s to t.
+	    @param lp the path, nodes of the graph from s to t; empty if none
+	    @return its length, idx.w_infty( ) if there is no path
+	*/
+	WeightT query( int s, int t, CPath &lp ) {
+		lp.clear();
+		int meet;
+		WeightT d = search( s, t, meet );
+		if( meet < 0 ) {
+			return d;
+		}
+		const CchIndex<WeightT> &ix = *m_pIdx;
+		// hierarchy edges from meet back to s, then from meet to t
+		lp.push_back( s );
+		m_vFwd.clear();
+		for( int x = meet; x != s; ) {
+			int e = m_vEdge[0][x];
+			m_vFwd.push_back( e );
+			x = from_up( e );
+		}
+		for( size_t k = m_vFwd.size(); k-- > 0; ) {
+			int e = m_vFwd[k];
+			unpack( from_up( e ), ix.m_vUpTo[e], ix.m_vUpMid[e], lp );
+		}
+		for( int x = meet; x != t; ) {
+			int e = m_vEdge[1][x];
+			int y = to_dn( e );
+			unpack( x, y, ix.m_vDnMid[e], lp );
+			x = y;
+		}
+		return d;
+	}
+
+protected:
+	// node with up edge e, node with down edge e
+	int from_up( int e ) const {
+		const std::vector<int> &voff = m_pIdx->m_vUpOff;
+		return ( int )( std::upper_bound( voff.begin(), voff.end(), e ) - voff.begin() ) - 1;
+	}
+	int to_dn( int e ) const {
+		const std::vector<int> &voff = m_pIdx->m_vDnOff;
+		return ( int )( std::upper_bound( voff.begin(), voff.end(), e ) - voff.begin() ) - 1;
+	}
+
+	// distance of s to t by searching up from both; meet is the node of a
+	// shortest path where they meet, -1 if none
+	WeightT search( int s, int t, int &meet ) {
+		const CchIndex<WeightT> &ix = *m_pIdx;
+		meet = -1;
+		WeightT best = ix.m_wInfty;
+		if( s < 0 || s >= ix.m_nSize || t < 0 || t >= ix.m_nSize ) {
+			return best;
+		}
+		if( ++m_nStamp == 0 ) {
+			for( int d = 0; d < 2; ++d ) {
+				std::fill( m_vStamp[d].begin(), m_vStamp[d].end(), 0 );
+			}
+			m_nStamp = 1;
+		}
+		for( int d = 0; d < 2; ++d ) {
+			m_Heap[d].clear();
+			int x = d == 0 ? s : t;
+			m_vDist[d][x] = WeightT();
+			m_vEdge[d][x] = -1;
+			m_vStamp[d][x] = m_nStamp;
+			m_Heap[d].push( x, WeightT() );
+		}
+		for( ;; ) {
+			bool go0 = !m_Heap[0].empty() && m_Heap[0].top_key() < best;
+			bool go1 = !m_Heap[1].empty() && m_Heap[1].top_key() < best;
+			if( !go0 && !go1 ) {
+				break;
+			}
+			int d = go0 && ( !go1 || !( m_Heap[1].top_key() < m_Heap[0].top_key() ) ) ? 0 : 1;
+			int u = m_Heap[d].top();
+			WeightT du = m_Heap[d].top_key();
+			m_Heap[d].pop();
+			if( m_vStamp[1 - d][u] == m_nStamp ) {
+				WeightT w = du + m_vDist[1 - d][u];
+				if( w < best ) {
+					best = w;
+					meet = u;
+				}
+			}
+			const std::vector<int> &voff = d == 0 ? ix.m_vUpOff : ix.m_vDnOff;
+			const std::vector<int> &vto = d == 0 ? ix.m_vUpTo : ix.m_vDnFrom;
+			const std::vector<WeightT> &vw = d == 0 ? ix.m_vUpW : ix.m_vDnW;
+			for( int e = voff[u]; e < voff[u + 1]; ++e ) {
+				int x = vto[e];
+				WeightT dx = du + vw[e];
+				if( m_vStamp[d][x] != m_nStamp || dx < m_vDist[d][x] ) {
+					m_vStamp[d][x] = m_nStamp;
+					m_vDist[d][x] = dx;
+					m_vEdge[d][x] = e;
+					m_Heap[d].push( x, dx );
+				}
+			}
+		}
+		return best;
+	}
+
+	// append to lp the nodes after a on the path of edge a->b skipping mid
+	void unpack( int a, int b, int mid, CPath &lp ) {
+		const CchIndex<WeightT> &ix = *m_pIdx;
+		m_vStack.clear();
+		m_vStack.push_back( a );
+		m_vStack.push_back( b );
+		m_vStack.push_back( mid );
+		while( !m_vStack.empty() ) {
+			int m = m_vStack.back();
+			m_vStack.pop_back();
+			int y = m_vStack.back();
+			m_vStack.pop_back();
+			int x = m_vStack.back();
+			m_vStack.pop_back();
+			if( m < 0 ) {
+				lp.push_back( y );
+				continue;
+			}
+			// x->m is a down edge into m, m->y an up edge of m
+			int e1 = ix.m_vUpOff[m];
+			while( ix.m_vUpTo[e1] != y ) {
+				++e1;
+			}
+			int e0 = ix.m_vDnOff[m];
+			while( ix.m_vDnFrom[e0] != x ) {
+				++e0;
+			}
+			m_vStack.push_back( m );
+			m_vStack.push_back( y );
+			m_vStack.push_back( ix.m_vUpMid[e1] );
+			m_vStack.push_back( x );
+			m_vStack.push_back( m );
+			m_vStack.push_back( ix.m_vDnMid[e0] );
+		}
+	}
+};
+
+/**@}*/
+
+} // end of namespace afg
+
+#endif
@@ -0,0 +1,619 @@
+/*@copyright
+
+Copyright (c) 2012 Aiguo Fei
+All rights reserved.
+
+Permission to use and re-distribute this code in source and binary forms
+with or without modifications is therefore granted provided that
+the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Information regarding where to obtain the original source code must be
+      included with the redistrbution.
+
+*NO WARRANTY*
+THIS CODE OR PROGRAM IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S)
+"AS IS" WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE. THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S) MUST NOT BE
+HELD RESPONSIBLE FOR ANY DAMAGE OR UNDESIRED EFFECT CAUSED DIRECTLY OR
+INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
+
+*/
+
+
+/**@file csr_graph.h
+
+  Immutable compressed-sparse-row (CSR) snapshot of a graph.
+
+  A CGraph keeps each adjacency list as a linked list, which is convenient
+  for editing but slow to traverse. CcsrGraph freezes a graph into three
+  flat arrays (row offsets, edge destinations, edge data) held in one
+  contiguous allocation, for read-heavy workloads such as running
+  shortest path algorithms many times on the same topology.
+
+  A snapshot keeps the vertex indices of its source graph (unused positions
+  stay unused), and the edges of each vertex in the same order, so the
+  algorithms in shortest_path.h, tree_alg.h, graph_alg.h etc. give exactly
+  the same results on a snapshot as on the source graph.
+
+*/
+
+#ifndef _AFG_CSR_GRAPH_H_
+#define _AFG_CSR_GRAPH_H_
+
+#include <string>
+#include <iostream>
+#include <vector>
+#include <functional>
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <new>
+#include <cstddef>
+#include <type_traits>
+
+namespace afg
+{
+
+/**@defgroup csrgraph Immutable CSR Graph Snapshot
+@ingroup graphd
+*/
+/**@{*/
+
+/** edge of a CcsrGraph.
+    A light-weight handle to one entry of the flat edge arrays,
+    providing the same to( )/edge_d( ) access as CiEdge.
+*/
+template<class EdgeDT>
+class CcsrEdge
+{
+	template<class EDT> friend class csr_e_iterator;
+
+protected:
+	const int *m_pTo;
+	const EdgeDT *m_pEdge;
+
+public:
+	/// type of the edge data
+	typedef EdgeDT EDT;
+
+	/// constructor
+	CcsrEdge( const int *pto = NULL, const EdgeDT *pe = NULL )
+		: m_pTo( pto ), m_pEdge( pe )
+	{ }
+
+	/// return destination node (index)
+	int to( void ) const {
+		return *m_pTo;
+	}
+
+	/// return reference of edge data
+	const EdgeDT &edge_d( void ) const {
+		return *m_pEdge;
+	}
+
+	/// output the edge in format of "edge_index: edge_data"
+	std::ostream &output( std::ostream &os ) const {
+		os << to( ) << ": " << edge_d( );
+		return os;
+	}
+};
+
+/// conventional output operator for CcsrEdge
+template<class EdgeDT>
+inline std::ostream &operator<<( std::ostream &os, const CcsrEdge<EdgeDT>& edge )
+{
+	return edge.output( os );
+}
+
+/** iterator over the edges of a vertex in a CcsrGraph.
+    Walks the destination and edge data arrays side by side;
+    dereferencing gives a CcsrEdge.
+*/
+template<class EdgeDT>
+class csr_e_iterator
+{
+protected:
+	CcsrEdge<EdgeDT> m_Edge;
+
+public:
+	typedef std::forward_iterator_tag iterator_category;
+	typedef CcsrEdge<EdgeDT> value_type;
+	typedef std::ptrdiff_t difference_type;
+	typedef const CcsrEdge<EdgeDT>* pointer;
+	typedef const CcsrEdge<EdgeDT>& reference;
+
+	/// constructor
+	csr_e_iterator( const int *pto = NULL, const EdgeDT *pe = NULL )
+		: m_Edge( pto, pe )
+	{ }
+
+	reference operator*() const {
+		return m_Edge;
+	}
+
+	pointer operator->() const {
+		return &m_Edge;
+	}
+
+	csr_e_iterator &operator++() {
+		++m_Edge.m_pTo;
+		++m_Edge.m_pEdge;
+		return *this;
+	}
+
+	csr_e_iterator operator++( int ) {
+		csr_e_iterator tmp( *this );
+		++( *this );
+		return tmp;
+	}
+
+	bool operator==( const csr_e_iterator &rhs ) const {
+		return m_Edge.m_pTo == rhs.m_Edge.m_pTo;
+	}
+
+	bool operator!=( const csr_e_iterator &rhs ) const {
+		return m_Edge.m_pTo != rhs.m_Edge.m_pTo;
+	}
+};
+
+/** vertex of a CcsrGraph.
+    Returned by value from CcsrGraph::operator[ ]; it only refers to
+    the storage of the graph and is valid as long as the graph is.
+*/
+template<class VertexDT, class EdgeDT>
+class CcsrVertex
+{
+public:
+	/// edge data type
+	typedef EdgeDT EDT;
+	/// vertex data type
+	typedef VertexDT VDT;
+	/// edge type
+	typedef CcsrEdge<EdgeDT> iET;
+
+	/// iterator type to access edges, read-only
+	typedef csr_e_iterator<EdgeDT> iterator;
+	/// const iterator type to access edges
+	typedef csr_e_iterator<EdgeDT> const_iterator;
+
+protected:
+	const VertexDT *m_pVertexD;
+	const int *m_pToBegin;
+	const int *m_pToEnd;
+	const EdgeDT *m_pEdges;
+
+public:
+	/// constructor
+	CcsrVertex( const VertexDT *pv, const int *ptb, const int *pte,
+				const EdgeDT *pe )
+		: m_pVertexD( pv ), m_pToBegin( ptb ), m_pToEnd( pte ), m_pEdges( pe )
+	{ }
+
+	/// return a reference of the vertex data
+	const VertexDT &vertex_d( void ) const {
+		return *m_pVertexD;
+	}
+
+	/// return iterator pointing to the first edge
+	const_iterator begin( void ) const {
+		return const_iterator( m_pToBegin, m_pEdges );
+	}
+
+	/// return iterator pointing to the end (not pointting to any endge).
+	const_iterator end( void ) const {
+		return const_iterator( m_pToEnd, m_pEdges + ( m_pToEnd - m_pToBegin ) );
+	}
+
+	/** get an edge of this vertex
+	    @param nto destination node (index)
+	    @return a pointer to the edge data, NULL if edge doesn't exist
+	*/
+	const EdgeDT *get_edge( int nto ) const {
+		for( const int *p = m_pToBegin; p != m_pToEnd; ++p ) {
+			if( *p == nto ) {
+				return m_pEdges + ( p - m_pToBegin );
+			}
+		}
+		return NULL;
+	}
+
+	/// return the out degree of this vertex
+	int out_degree( void ) const {
+		return ( int )( m_pToEnd - m_pToBegin );
+	}
+
+	/// output the vertex in the same format as IVertex
+	std::ostream &output( std::ostream &os ) const {
+		os << vertex_d( ) << "-> ";
+		for( const_iterator it = begin(); it != end(); ++it ) {
+			if( it != begin() ) {
+				os << ", ";
+			}
+			os << *it;
+		}
+		return os;
+	}
+};
+
+/// conventional output operator for CcsrVertex
+template<class VertexDT, class EdgeDT>
+inline std::ostream &operator<<( std::ostream &os,
+								 const CcsrVertex<VertexDT, EdgeDT>& rhs )
+{
+	return rhs.output( os );
+}
+
+/** Immutable graph in compressed sparse row form.
+  The read-only part of the CGraph interface is provided: range( ),
+  size( ), is_in_use( ), is_valid( ), operator[ ], at( ), e_begin( ),
+  e_end( ), get_edge( ), get_edge_byi( ), find_index( ) and output.
+  Edge offsets, destinations and edge data are kept in one allocation,
+  so traversing the edges of a vertex touches consecutive memory only.
+
+  A snapshot is built from a CGraph (or any graph with the same read
+  interface) with freeze( ) or the converting constructor; it never
+  changes afterwards, except by freezing another graph into it.
+
+  @see CGraph
+*/
+template < class VertexDT, class EdgeDT, class f_eqv = std::equal_to<VertexDT> >
+class CcsrGraph
+{
+public:
+
+	/**@name type definitions.
+	*/
+	//@{
+
+	/// edge data type
+	typedef EdgeDT EDT;
+
+	/// vertex data type
+	typedef VertexDT VDT;
+
+	/// edge type
+	typedef CcsrEdge<EdgeDT> iET;
+
+	/// vertex type, a light-weight view returned by value
+	typedef CcsrVertex<VertexDT, EdgeDT> iVT;
+
+	/// graph type, this class itself
+	typedef CcsrGraph<VertexDT, EdgeDT, f_eqv> GT;
+
+	/// type compare function object to determine if two vertex data are equal
+	typedef f_eqv COMPT;
+
+	/// edge iterator, the same as the const one since a snapshot is read-only
+	typedef typename iVT::const_iterator e_iterator;
+
+	/// edge iterator, const
+	typedef typename iVT::const_iterator const_e_iterator;
+
+	//@}
+
+protected:
+
+	/**@name data members */
+	//@{
+	/// vertex data, one per index; unused indices hold m_vDefault
+	std::vector<VertexDT> m_Vertices;
+
+	/// flags of indices in use
+	std::vector<bool> m_bInUse;
+
+	/// default vertex value
+	VertexDT m_vDefault;
+
+	/// number of vertices
+	int m_nSize;
+
+	/// number of edges
+	int m_nEdges;
+
+	/// the single allocation holding offsets, destinations and edge data
+	void *m_pBuf;
+
+	/// edges of vertex i are [ m_pOffsets[i], m_pOffsets[i+1] )
+	int *m_pOffsets;
+
+	/// edge destinations
+	int *m_pTo;
+
+	/// edge data
+	EdgeDT *m_pEdges;
+
+	/// predicate to determine if two vertex data are equivalent
+	f_eqv m_eqv;
+	//@}
+
+public:
+	/** constructor, an empty snapshot.
+	@param v default vertex value, as in CGraph.
+	@param eqv predicate to determine if two vertices are equivalent.
+	*/
+	explicit CcsrGraph( const VertexDT &v = VertexDT(), const f_eqv &eqv = f_eqv() )
+		: m_vDefault( v ), m_nSize( 0 ), m_nEdges( 0 ), m_pBuf( NULL ),
+		  m_pOffsets( NULL ), m_pTo( NULL ), m_pEdges( NULL ), m_eqv( eqv ) {
+		allocate( 0, 0 );
+		m_pOffsets[0] = 0;
+	}
+
+	/** constructor, freeze a graph.
+	@see freeze( )
+	*/
+	template<class GraphT>
+	explicit CcsrGraph( const GraphT &gra, const f_eqv &eqv = f_eqv() )
+		: m_vDefault( gra.v_default() ), m_nSize( 0 ), m_nEdges( 0 ),
+		  m_pBuf( NULL ), m_pOffsets( NULL ), m_pTo( NULL ), m_pEdges( NULL ),
+		  m_eqv( eqv ) {
+		freeze( gra );
+	}
+
+	CcsrGraph( const CcsrGraph<VertexDT, EdgeDT, f_eqv> &rhs )
+		: m_Vertices( rhs.m_Vertices ), m_bInUse( rhs.m_bInUse ),
+		  m_vDefault( rhs.m_vDefault ), m_nSize( rhs.m_nSize ), m_nEdges( 0 ),
+		  m_pBuf( NULL ), m_pOffsets( NULL ), m_pTo( NULL ), m_pEdges( NULL ),
+		  m_eqv( rhs.m_eqv ) {
+		copy_arrays( rhs );
+	}
+
+	const CcsrGraph<VertexDT, EdgeDT, f_eqv>& operator=
+	( const CcsrGraph<VertexDT, EdgeDT, f_eqv>& rhs ) {
+		if( this != &rhs ) {
+			CcsrGraph<VertexDT, EdgeDT, f_eqv> tmp( rhs );
+			swap( tmp );
+		}
+		return *this;
+	}
+
+	~CcsrGraph() {
+		release();
+	}
+
+	/// exchange contents with another snapshot
+	void swap( CcsrGraph<VertexDT, EdgeDT, f_eqv> &rhs ) {
+		m_Vertices.swap( rhs.m_Vertices );
+		m_bInUse.swap( rhs.m_bInUse );
+		std::swap( m_vDefault, rhs.m_vDefault );
+		std::swap( m_nSize, rhs.m_nSize );
+		std::swap( m_nEdges, rhs.m_nEdges );
+		std::swap( m_pBuf, rhs.m_pBuf );
+		std::swap( m_pOffsets, rhs.m_pOffsets );
+		std::swap( m_pTo, rhs.m_pTo );
+		std::swap( m_pEdges, rhs.m_pEdges );
+		std::swap( m_eqv, rhs.m_eqv );
+	}
+
+	/** build the snapshot from a graph.
+	  Any previous content is discarded. Vertex indices, unused positions
+	  and the order of edges of each vertex are kept as in gra.
+	  GraphT can be any graph type providing range( ), is_in_use( ),
+	  v_default( ) and operator[ ] with vertex_d( )/begin( )/end( ),
+	  e.g., CGraph or CrTree.
+	*/
+	template<class GraphT>
+	void freeze( const GraphT &gra ) {
+		typedef typename GraphT::const_e_iterator src_iterator;
+		int n = gra.range(), m = 0, i;
+		for( i = 0; i < n; ++i ) {
+			for( src_iterator ie = gra[i].begin(); ie != gra[i].end(); ++ie ) {
+				++m;
+			}
+		}
+
+		release();
+		m_vDefault = gra.v_default();
+		m_Vertices.assign( n, m_vDefault );
+		m_bInUse.assign( n, false );
+		m_nSize = 0;
+		allocate( n, m );
+
+		int k = 0;
+		for( i = 0; i < n; ++i ) {
+			m_pOffsets[i] = k;
+			if( gra.is_in_use( i ) ) {
+				m_Vertices[i] = gra[i].vertex_d();
+				m_bInUse[i] = true;
+				++m_nSize;
+			}
+			for( src_iterator ie = gra[i].begin(); ie != gra[i].end(); ++ie ) {
+				m_pTo[k] = ( *ie ).to();
+				new( m_pEdges + k ) EdgeDT(( *ie ).edge_d() );
+				++k;
+				m_nEdges = k; // only constructed elements are destroyed on failure
+			}
+		}
+		m_pOffsets[n] = k;
+	}
+
+	/**@name element access and helpers*/
+	//@{
+
+	/// return the default vertex value
+	const VDT &v_default( void ) const {
+		return m_vDefault;
+	}
+
+	/** return vertex at position i.
+	    Behavior is undefined if i is out of range.
+	*/
+	iVT operator[]( int i ) const {
+		return iVT( &m_Vertices[i], m_pTo + m_pOffsets[i], m_pTo + m_pOffsets[i + 1],
+					m_pEdges + m_pOffsets[i] );
+	}
+
+	/** return vertex at position i
+	    @exception std::out_of_range.
+	*/
+	iVT at( int i ) const {
+		if( !is_in_range( i ) ) {
+			throw std::out_of_range( std::string( "at( ) of CcsrGraph" ) );
+		}
+		return ( *this )[i];
+	}
+
+	/// return iterator pointing to the first edge of vertex i
+	const_e_iterator e_begin( int i ) const {
+		return const_e_iterator( m_pTo + m_pOffsets[i], m_pEdges + m_pOffsets[i] );
+	}
+
+	/// return iterator pointing to the end of edges of vertex i
+	const_e_iterator e_end( int i ) const {
+		return const_e_iterator( m_pTo + m_pOffsets[i + 1], m_pEdges + m_pOffsets[i + 1] );
+	}
+
+	/// return out degree of vertex i
+	int out_degree( int i ) const {
+		return m_pOffsets[i + 1] - m_pOffsets[i];
+	}
+
+	/** Get edge data (from u to v).
+	   @return a pointer to that edge (data), NULL if not found.
+	*/
+	const EDT *get_edge( const VDT &u, const VDT &v ) const {
+		int nfrom = find_index( u );
+		if( nfrom >= 0 ) {
+			int nto = find_index( v );
+			if( nto >= 0 ) {
+				return ( *this )[nfrom].get_edge( nto );
+			}
+		}
+		return NULL;
+	}
+
+	/** get edge data by index.
+	    @return a pointer to that edge (data), NULL if not found.
+	*/
+	const EDT *get_edge_byi( int nfrom, int nto ) const {
+		if( !is_in_range( nfrom ) || !is_in_range( nto ) ) {
+			return NULL;
+		}
+		return ( *this )[nfrom].get_edge( nto );
+	}
+
+	/// find the index of vertex v
+	int find_index( const VDT &v ) const {
+		for( int i = 0; i < range(); ++i ) {
+			if( m_eqv( v, m_Vertices[i] ) ) {
+				return i;
+			}
+		}
+		return -1;
+	}
+
+	/// return graph size: number of vertices in the graph
+	int size( void ) const {
+		return m_nSize;
+	}
+
+	/// return the number of edges in the graph
+	int n_edges( void ) const {
+		return m_nEdges;
+	}
+
+	/** return upper bound on vertex index range.
+	    Vertex index will be within [0, range()-1 ].
+	*/
+	int range( void ) const {
+		return ( int )m_Vertices.size();
+	}
+
+	/// return if i is within [0, range()-1 ]
+	bool is_in_range( int i ) const {
+		return ( i >= 0 && i < range() );
+	}
+
+	/// return if i (range checked) is an index used for a vertex.
+	bool is_in_use( int i ) const {
+		return !is_in_range( i ) || m_bInUse[i];
+	}
+
+	/// return if i is a valid index: within range and used for a vertex
+	bool is_valid( int i ) const {
+		return is_in_range( i ) && m_bInUse[i];
+	}
+
+	//@}
+
+	/// output graph to a stream, in the same format as IGraph
+	std::ostream &output( std::ostream &os ) const {
+		for( int i = 0; i < range( ); ++i ) {
+			if( is_in_use( i ) ) {
+				os << '(' << i << ')' << ( *this )[i] << std::endl;
+			}
+		}
+		return os;
+	}
+
+protected:
+	// aligned byte offset of the edge data array in the buffer
+	static size_t edge_offset( int n, int m ) {
+		size_t nb = sizeof( int ) * ( size_t )( n + 1 + m );
+		size_t na = std::alignment_of<EdgeDT>::value;
+		return ( nb + na - 1 ) / na * na;
+	}
+
+	// get one buffer for n+1 offsets, m destinations and m edges
+	void allocate( int n, int m ) {
+		size_t ne = edge_offset( n, m );
+		m_pBuf = ::operator new( ne + sizeof( EdgeDT ) * ( size_t )m );
+		m_pOffsets = static_cast<int *>( m_pBuf );
+		m_pTo = m_pOffsets + n + 1;
+		m_pEdges = reinterpret_cast<EdgeDT *>( static_cast<char *>( m_pBuf ) + ne );
+		m_nEdges = 0;
+	}
+
+	// destroy edge data and free the buffer
+	void release( void ) {
+		for( int k = 0; k < m_nEdges; ++k ) {
+			m_pEdges[k].~EdgeDT();
+		}
+		::operator delete( m_pBuf );
+		m_pBuf = NULL;
+		m_pOffsets = m_pTo = NULL;
+		m_pEdges = NULL;
+		m_nEdges = 0;
+	}
+
+	// deep copy of the arrays, used by the copy constructor
+	void copy_arrays( const CcsrGraph<VertexDT, EdgeDT, f_eqv> &rhs ) {
+		int n = rhs.range(), m = rhs.m_nEdges;
+		allocate( n, m );
+		std::copy( rhs.m_pOffsets, rhs.m_pOffsets + n + 1 + m, m_pOffsets );
+		for( int k = 0; k < m; ++k ) {
+			new( m_pEdges + k ) EdgeDT( rhs.m_pEdges[k] );
+			m_nEdges = k + 1;
+		}
+	}
+};
+// end of CcsrGraph
+
+/// conventional output operator for CcsrGraph
+template<class VertexDT, class EdgeDT, class f_eqv>
+inline std::ostream &operator<<( std::ostream &os,
+								 const CcsrGraph<VertexDT, EdgeDT, f_eqv>& rhs )
+{
+	return rhs.output( os );
+}
+
+/** freeze a graph into a CcsrGraph snapshot of the same vertex/edge types.
+  Equivalent to "CcsrGraph<...> csr( gra );".
+*/
+template<class GraphT>
+inline CcsrGraph<typename GraphT::VDT, typename GraphT::EDT, typename GraphT::COMPT>
+freeze( const GraphT &gra )
+{
+	return CcsrGraph<typename GraphT::VDT, typename GraphT::EDT,
+		   typename GraphT::COMPT>( gra );
+}
+
+/**@}*/
+
+}// end of namespace afg
+
+#endif
@@ -0,0 +1,361 @@
+/*@copyright
+
+Copyright (c) 2012 Aiguo Fei
+All rights reserved.
+
+Permission to use and re-distribute this code in source and binary forms
+with or without modifications is therefore granted provided that
+the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Information regarding where to obtain the original source code must be
+      included with the redistrbution.
+
+*NO WARRANTY*
+THIS CODE OR PROGRAM IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S)
+"AS IS" WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE. THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S) MUST NOT BE
+HELD RESPONSIBLE FOR ANY DAMAGE OR UNDESIRED EFFECT CAUSED DIRECTLY OR
+INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
+
+*/
+
+
+
+
+/**@file delta_stepping.h
+
+  delta-stepping single source shortest paths (Meyer and Sanders), with
+  the edges of each bucket relaxed in parallel on an afl::thread_pool.
+
+  Tuning delta: nodes are kept in buckets of width delta by distance.
+  Edges of weight <= delta (light) are relaxed in rounds until the
+  current bucket stays empty, then those heavier once for all the nodes
+  the bucket settled. The smaller delta, the less a node is relaxed more
+  than once, but the more buckets and rounds there are, each one a
+  synchronization of all threads: delta of the smallest weight is
+  Dijkstra's algorithm with buckets, one round per distinct distance;
+  delta beyond the largest weight is Bellman-Ford in rounds.
+    - delta <= 0 picks the largest weight over the average out-degree,
+      the choice of Meyer and Sanders for random weights; a good start.
+    - few threads or small frontiers (road networks, grids: low degree,
+      large diameter): make delta larger, up to several times the
+      typical weight, so that rounds have enough nodes to share out.
+    - many threads, high degree (social, random graphs): the default or
+      smaller; if a run relaxes many more edges than the graph has, delta
+      is too large.
+    - the buckets are a circular array of largest weight / delta + 3
+      entries per thread: keep delta within a few thousandths of the
+      largest weight or it costs memory and scans.
+  b_delta_stepping (bench/afgraph) times several delta and thread counts.
+
+*/
+
+#ifndef _AFG_DELTA_STEPPING_H_
+#define _AFG_DELTA_STEPPING_H_
+
+#include <vector>
+#include <string>
+#include <algorithm>
+
+#include "afl/exceptions.hpp"
+#include "afl/thread_pool.hpp"
+#include "graph_view.h"
+
+namespace afg
+{
+
+/**@addtogroup gspalg
+*/
+/**@{*/
+
+// out-edges of a graph in compressed rows, for delta_stepping( ): those
+// of i are [off[i], off[i+1]), the light ones (weight <= delta) first,
+// up to mid[i]; self loops are left out
+template<class WeightT>
+struct ds_edges {
+	std::vector<size_t> off;
+	std::vector<size_t> mid;
+	std::vector<int> to;
+	std::vector<WeightT> w;
+	WeightT wmax;
+	WeightT delta;
+
+	// delta <= 0 for the default; throws for an out of range edge or a
+	// negative weight
+	template< class GraphT, class Fun >
+	void build( const GraphT &graph, Fun f_weight, WeightT dlt,
+				afl::thread_pool &pool ) {
+		typedef graph_view<GraphT> GV;
+		typedef typename GV::const_e_iterator EIter;
+		int n = GV::range( graph );
+		int nt = pool.size();
+		off.assign( n + 1, 0 );
+		mid.assign( n, 0 );
+		std::vector<WeightT> vmax( nt, WeightT() );
+		std::vector<char> vbad( nt, 0 );
+		pool.parallel_for( n, [&]( int i, int t ) {
+			size_t c = 0;
+			EIter iend = GV::e_end( graph, i );
+			for( EIter ite = GV::e_begin( graph, i ); ite != iend; ++ite ) {
+				int j = GV::to( ite );
+				WeightT we = f_weight( &( GV::edge_d( ite ) ) );
+				if( j < 0 || j >= n || we < WeightT() ) {
+					vbad[t] = 1;
+				} else if( j != i ) {
+					++c;
+					if( vmax[t] < we ) {
+						vmax[t] = we;
+					}
+				}
+			}
+			off[i + 1] = c;
+		}, 256 );
+		wmax = WeightT();
+		for( int t = 0; t < nt; ++t ) {
+			if( vbad[t] ) {
+				throw afl::general_except<std::string>( "delta_stepping( ): "
+						"edge to an out of range index, or of negative weight" );
+			}
+			if( wmax < vmax[t] ) {
+				wmax = vmax[t];
+			}
+		}
+		for( int i = 0; i < n; ++i ) {
+			off[i + 1] += off[i];
+		}
+		delta = dlt;
+		if( !( delta > WeightT() ) && n > 0 ) {
+			size_t deg = off[n] / n;
+			delta = ( WeightT )( wmax / ( WeightT )( deg > 1 ? deg : 1 ) );
+		}
+		if( !( delta > WeightT() ) ) {
+			delta = ( WeightT )1;
+		}
+		to.resize( off[n] );
+		w.resize( off[n] );
+		pool.parallel_for( n, [&]( int i, int ) {
+			size_t a = off[i], b = off[i + 1];
+			EIter iend = GV::e_end( graph, i );
+			for( EIter ite = GV::e_begin( graph, i ); ite != iend; ++ite ) {
+				int j = GV::to( ite );
+				if( j == i ) {
+					continue;
+				}
+				WeightT we = f_weight( &( GV::edge_d( ite ) ) );
+				size_t k = we <= delta ? a++ : --b;
+				to[k] = j;
+				w[k] = we;
+			}
+			mid[i] = a;
+		}, 256 );
+	}
+};
+
+// a relaxation of delta_stepping( ): node v at distance d through u
+template<class WeightT>
+struct ds_request {
+	int v;
+	int u;
+	WeightT d;
+};
+
+/** Delta-stepping single source shortest paths on the threads of pool.
+    Same parameters and results as dijkstra( ): pred and dist are
+    resized to graph.range( ) if smaller, dist[i] is w_infty and pred[i]
+    -1 for a node not reached, pred[nsource] is -1. Distances are the
+    same as dijkstra( )'s; where several paths are shortest, pred[v] is
+    the smallest index among the nodes last to improve dist[v] (in the
+    same round), which may differ from dijkstra( )'s choice but not from
+    one run or thread count to another.
+    Edge weights must not be negative; WeightT may be an integer or a
+    floating point type.
+    @param delta bucket width, <= 0 for the largest weight over the
+      average out-degree; see delta_stepping.h for how to tune it.
+    @param pool threads to run on, see afl::thread_pool
+    @param pnrelax if not NULL, to store the number of relaxations
+      which improved a distance (n - 1 at best)
+    @return false if nsource is not a valid node
+    @exception afl::general_except for an edge to an out of range index
+      or of negative weight
+    @see dijkstra
+*/
+template< class GraphT, class Fun >
+bool delta_stepping( const GraphT &graph, int nsource, Fun f_weight,
+					 typename Fun::result_type w_infty,
+					 std::vector<int>& pred,
+					 std::vector<typename Fun::result_type>& dist,
+					 typename Fun::result_type delta, afl::thread_pool &pool,
+					 long long *pnrelax = NULL )
+{
+	typedef graph_view<GraphT> GV;
+	typedef typename Fun::result_type WeightT;
+	typedef ds_request<WeightT> Req;
+	if( !GV::is_valid( graph, nsource ) ) {
+		return false;
+	}
+
+	int n = GV::range( graph );
+	if(( int )pred.size() < n ) {
+		pred.resize( n );
+	}
+	if(( int )dist.size() < n ) {
+		dist.resize( n );
+	}
+	std::fill( pred.begin(), pred.begin() + n, -1 );
+	std::fill( dist.begin(), dist.begin() + n, w_infty );
+
+	ds_edges<WeightT> eg;
+	eg.build( graph, f_weight, delta, pool );
+	delta = eg.delta;
+
+	// node v belongs to part v % np, whose thread alone changes its
+	// distance and buckets; bucket b is slot b % nb: at any time the
+	// buckets in use are within nb of each other
+	const int np = pool.size();
+	const size_t nb = ( size_t )( eg.wmax / delta ) + 3;
+	std::vector<std::vector<std::vector<int> > > bins( np,
+			std::vector<std::vector<int> >( nb ) );
+	// requests made by thread t for part p are in vreq[t][p]
+	std::vector<std::vector<std::vector<Req> > > vreq( np,
+			std::vector<std::vector<Req> >( np ) );
+	// nodes of the current round (vfront) and those settled by the
+	// current bucket (vset), by part, then gathered in front
+	std::vector<std::vector<int> > vfront( np ), vset( np );
+	std::vector<int> front;
+	// round in which a node was last improved, last in front, last
+	// added to vset (by number of the set)
+	std::vector<int> vround( n, 0 ), vmark( n, 0 ), vsetno( n, 0 );
+	std::vector<long long> vrelax( np, 0 );
+	int round = 0, setno = 1;
+
+	dist[nsource] = WeightT();
+	bins[nsource % np][0].push_back( nsource );
+	size_t cur = 0;
+
+	// relax the light (or heavy) edges of the nodes in front
+	auto relax = [&]( bool light ) {
+		++round;
+		pool.parallel_for(( int )front.size(), [&]( int i, int t ) {
+			int u = front[i];
+			WeightT du = dist[u];
+			size_t e1 = light ? eg.mid[u] : eg.off[u + 1];
+			for( size_t e = light ? eg.off[u] : eg.mid[u]; e < e1; ++e ) {
+				int v = eg.to[e];
+				WeightT d = du + eg.w[e];
+				if( d < dist[v] ) {
+					Req r = { v, u, d };
+					vreq[t][v % np].push_back( r );
+				}
+			}
+		}, 64 );
+		pool.parallel_for( np, [&]( int p, int ) {
+			for( int t = 0; t < np; ++t ) {
+				std::vector<Req> &vr = vreq[t][p];
+				for( size_t k = 0; k < vr.size(); ++k ) {
+					const Req &r = vr[k];
+					if( r.d < dist[r.v] ) {
+						dist[r.v] = r.d;
+						pred[r.v] = r.u;
+						vround[r.v] = round;
+						++vrelax[p];
+						bins[p][( size_t )( r.d / delta ) % nb].push_back( r.v );
+					} else if( r.d == dist[r.v] && vround[r.v] == round
+							   && r.u < pred[r.v] ) {
+						pred[r.v] = r.u;
+					}
+				}
+				vr.clear();
+			}
+		} );
+	};
+	// gather the nodes of vfront or vset into front
+	auto gather = [&]( std::vector<std::vector<int> > &vv ) {
+		front.clear();
+		for( int p = 0; p < np; ++p ) {
+			front.insert( front.end(), vv[p].begin(), vv[p].end() );
+			vv[p].clear();
+		}
+	};
+
+	for( ;; ) {
+		// the nodes now in the current bucket, each once
+		size_t s = cur % nb;
+		int nfront = round + 1;
+		pool.parallel_for( np, [&]( int p, int ) {
+			std::vector<int> &vb = bins[p][s];
+			for( size_t k = 0; k < vb.size(); ++k ) {
+				int v = vb[k];
+				if( vmark[v] != nfront && ( size_t )( dist[v] / delta ) == cur ) {
+					vmark[v] = nfront;
+					vfront[p].push_back( v );
+					if( vsetno[v] != setno ) {
+						vsetno[v] = setno;
+						vset[p].push_back( v );
+					}
+				}
+			}
+			vb.clear();
+		} );
+		gather( vfront );
+		if( !front.empty() ) {
+			relax( true );
+			continue;
+		}
+		gather( vset );
+		if( !front.empty() ) {
+			++setno;
+			relax( false );
+			continue;
+		}
+		// on to the next bucket in use
+		size_t k = 1;
+		for( ; k < nb; ++k ) {
+			int p = 0;
+			while( p < np && bins[p][( cur + k ) % nb].empty() ) {
+				++p;
+			}
+			if( p < np ) {
+				break;
+			}
+		}
+		if( k == nb ) {
+			break;
+		}
+		cur += k;
+	}
+
+	if( pnrelax ) {
+		*pnrelax = 0;
+		for( int p = 0; p < np; ++p ) {
+			*pnrelax += vrelax[p];
+		}
+	}
+	return true;
+}
+
+/** delta-stepping on nthreads threads (0 for as many as the hardware
+    runs).
+    @see delta_stepping
+*/
+template< class GraphT, class Fun >
+bool delta_stepping( const GraphT &graph, int nsource, Fun f_weight,
+					 typename Fun::result_type w_infty,
+					 std::vector<int>& pred,
+					 std::vector<typename Fun::result_type>& dist,
+					 typename Fun::result_type delta = 0, int nthreads = 0 )
+{
+	afl::thread_pool pool( nthreads );
+	return delta_stepping( graph, nsource, f_weight, w_infty, pred, dist,
+						   delta, pool );
+}
+
+/**@}*/
+
+} // end of namespace afg
+
+#endif
@@ -0,0 +1,355 @@
+/*@copyright
+
+Copyright (c) 2012 Aiguo Fei
+All rights reserved.
+
+Permission to use and re-distribute this code in source and binary forms
+with or without modifications is therefore granted provided that
+the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Information regarding where to obtain the original source code must be
+      included with the redistrbution.
+
+*NO WARRANTY*
+THIS CODE OR PROGRAM IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S)
+"AS IS" WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE. THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S) MUST NOT BE
+HELD RESPONSIBLE FOR ANY DAMAGE OR UNDESIRED EFFECT CAUSED DIRECTLY OR
+INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
+
+*/
+
+
+
+
+/**@file dynamic_sp.h
+
+  single source shortest paths kept up to date as edges of the graph
+  change, repairing only the nodes a change affects (after Ramalingam
+  and Reps) instead of running dijkstra( ) again.
+
+*/
+
+#ifndef _AFG_DYNAMIC_SP_H_
+#define _AFG_DYNAMIC_SP_H_
+
+#include <vector>
+#include <algorithm>
+
+#include "afl/indexed_heap.hpp"
+#include "shortest_path.h"
+
+namespace afg
+{
+
+/**@addtogroup gspalg
+*/
+/**@{*/
+
+/** shortest paths from one source of a graph, kept up to date as edges
+    are changed, inserted or removed through it.
+    The graph must be a CGraph (not changed other than through this
+    object while it is in use); its in-edge index is turned on (see
+    CGraph::enable_in_index( )), to find the other ways into a node.
+    Weights must not be negative.
+
+    A lighter or new edge (i->j) which shortens the path to j is followed
+    by a Dijkstra search from j over the nodes it makes closer. A heavier
+    or removed edge only matters if it is in the shortest path tree: the
+    subtree below it is cut off, each of its nodes takes the best way in
+    from outside the subtree, and a Dijkstra search within the subtree
+    settles the rest. Each change costs about what it affects.
+
+    pred( ) and dist( ) are as dijkstra( ) gives them: distances are
+    always the same as a new dijkstra( ) run would give; where several
+    paths are shortest the predecessor may be another one. changed( )
+    lists the nodes the last change touched, and update_sptree( ) applies
+    it to a shortest path tree made by sptree_all( ) or pred2tree( ).
+    @see dijkstra sptree_all
+*/
+template< class GraphT, class Fun >
+class CspDynamic
+{
+public:
+	/// weight type
+	typedef typename Fun::result_type WeightT;
+	/// edge data type
+	typedef typename GraphT::EDT EDT;
+
+protected:
+	GraphT &m_Graph;
+	Fun m_fWeight;
+	WeightT m_wInfty;
+	int m_nSource;
+	std::vector<int> m_vPred;
+	std::vector<WeightT> m_vDist;
+	// nodes the last change touched, and their predecessors before it
+	std::vector<int> m_vChanged, m_vOldPred;
+	// the edge last changed, -1 if none
+	int m_nFrom, m_nTo;
+	// m_vSeen[i] == m_nStamp: i is in m_vChanged; m_vCut[i] == m_nStamp:
+	// i is in the subtree cut off
+	std::vector<unsigned int> m_vSeen, m_vCut;
+	unsigned int m_nStamp;
+	afl::indexed_heap<WeightT> m_Heap;
+	std::vector<int> m_vNodes;
+
+public:
+	/** constructor, shortest paths from nsource by dijkstra( ).
+	    @see reset
+	*/
+	CspDynamic( GraphT &g, int nsource, Fun f_weight, WeightT w_infty )
+		: m_Graph( g ), m_fWeight( f_weight ), m_wInfty( w_infty ),
+		  m_nSource( -1 ), m_nFrom( -1 ), m_nTo( -1 ), m_nStamp( 0 ) {
+		reset( nsource );
+	}
+
+	/** compute the shortest paths from nsource again, by dijkstra( ).
+	    @return false if nsource is not a valid node (no paths then)
+	*/
+	bool reset( int nsource ) {
+		m_Graph.enable_in_index();
+		int n = m_Graph.range();
+		m_vChanged.clear();
+		m_vOldPred.clear();
+		m_nFrom = m_nTo = -1;
+		m_vSeen.assign( n, 0 );
+		m_vCut.assign( n, 0 );
+		m_nStamp = 0;
+		m_Heap.reset( n );
+		m_nSource = nsource;
+		if( !dijkstra( m_Graph, nsource, m_fWeight, m_wInfty, m_vPred, m_vDist ) ) {
+			m_nSource = -1;
+			m_vPred.assign( n, -1 );
+			m_vDist.assign( n, m_wInfty );
+			return false;
+		}
+		return true;
+	}
+
+	/// the source, -1 if not valid
+	int source( void ) const {
+		return m_nSource;
+	}
+
+	/// pred[i]: predecessor of i on the shortest path from the source
+	const std::vector<int>& pred( void ) const {
+		return m_vPred;
+	}
+
+	/// dist[i]: length of the shortest path from the source, w_infty if none
+	const std::vector<WeightT>& dist( void ) const {
+		return m_vDist;
+	}
+
+	/// nodes whose predecessor or distance the last change set
+	const std::vector<int>& changed( void ) const {
+		return m_vChanged;
+	}
+
+	/** change the data (weight) of edge (i->j) to e.
+	    @return false if there is no such edge (nothing changed)
+	*/
+	bool update_edge( int i, int j, const EDT &e ) {
+		EDT *pe = m_Graph.get_edge_byi( i, j );
+		if( !pe ) {
+			return false;
+		}
+		WeightT wold = m_fWeight( pe );
+		*pe = e;
+		repair( i, j, true, wold, true, m_fWeight( pe ) );
+		return true;
+	}
+
+	/** insert edge (i->j) with data e, or change it if it is there, as
+	    CGraph::insert_e_byi( ) does.
+	    @return false if i or j is not a valid node (nothing changed)
+	*/
+	bool insert_edge( int i, int j, const EDT &e ) {
+		const EDT *pe = m_Graph.get_edge_byi( i, j );
+		bool had = pe != NULL;
+		WeightT wold = had ? m_fWeight( pe ) : WeightT();
+		if( !m_Graph.insert_e_byi( i, j, e ) ) {
+			return false;
+		}
+		repair( i, j, had, wold, true, m_fWeight( m_Graph.get_edge_byi( i, j ) ) );
+		return true;
+	}
+
+	/** remove edge (i->j).
+	    @return false if there is no such edge (nothing changed)
+	*/
+	bool remove_edge( int i, int j ) {
+		const EDT *pe = m_Graph.get_edge_byi( i, j );
+		if( !pe ) {
+			return false;
+		}
+		WeightT wold = m_fWeight( pe );
+		m_Graph.remove_e_byi( i, j );
+		repair( i, j, true, wold, false, WeightT() );
+		return true;
+	}
+
+	/** apply the last change to tree, a shortest path tree from the
+	    source with all the nodes of the graph (sptree_all( ), or
+	    pred2tree( ) of pred( ) before the change): parents and edge data
+	    become those of pred( ) now. Called after each change, the tree
+	    is kept up to date at the cost of the nodes changed.
+	    @return false if an edge of pred( ) is not in the graph (should
+	      not happen)
+	*/
+	template<class TreeT>
+	bool update_sptree( TreeT &tree ) const {
+		for( size_t k = 0; k < m_vChanged.size(); ++k ) {
+			int x = m_vChanged[k], p = m_vPred[x], op = m_vOldPred[k];
+			if( p == op ) {
+				continue;
+			}
+			if( op >= 0 ) {
+				tree.remove_e_byi( op, x );
+			}
+			if( p >= 0 && !insert_tree_edge( tree, p, x ) ) {
+				return false;
+			}
+		}
+		// new data of an edge which stays in the tree
+		if( m_nFrom >= 0 && m_vPred[m_nTo] == m_nFrom ) {
+			return insert_tree_edge( tree, m_nFrom, m_nTo );
+		}
+		return true;
+	}
+
+protected:
+	template<class TreeT>
+	bool insert_tree_edge( TreeT &tree, int p, int x ) const {
+		const EDT *pe = m_Graph.get_edge_byi( p, x );
+		return pe && tree.insert_e_byi( p, x, *pe );
+	}
+
+	WeightT weight( int i, int j ) const {
+		return m_fWeight( m_Graph.get_edge_byi( i, j ) );
+	}
+
+	// remember the predecessor of x before this change
+	void touch( int x ) {
+		if( m_vSeen[x] != m_nStamp ) {
+			m_vSeen[x] = m_nStamp;
+			m_vChanged.push_back( x );
+			m_vOldPred.push_back( m_vPred[x] );
+		}
+	}
+
+	// edge (i->j) was of weight wold (if had) and is of wnew (if has)
+	void repair( int i, int j, bool had, WeightT wold, bool has, WeightT wnew ) {
+		m_vChanged.clear();
+		m_vOldPred.clear();
+		m_nFrom = i;
+		m_nTo = j;
+		if( ++m_nStamp == 0 ) {
+			std::fill( m_vSeen.begin(), m_vSeen.end(), 0 );
+			std::fill( m_vCut.begin(), m_vCut.end(), 0 );
+			m_nStamp = 1;
+		}
+		if( m_nSource < 0 || i == j ) {
+			return;
+		}
+		if( has && ( !had || wnew < wold ) ) {
+			shorter( i, j, wnew );
+		} else if( had && ( !has || wold < wnew ) && m_vPred[j] == i ) {
+			longer( j );
+		}
+	}
+
+	// edge (i->j) of weight w became lighter or new
+	void shorter( int i, int j, WeightT w ) {
+		if( !( m_vDist[i] < m_wInfty ) || !( m_vDist[i] + w < m_vDist[j] ) ) {
+			return;
+		}
+		touch( j );
+		m_vDist[j] = m_vDist[i] + w;
+		m_vPred[j] = i;
+		m_Heap.push( j, m_vDist[j] );
+		settle( false );
+	}
+
+	// the edge into j of the tree became heavier or was removed
+	void longer( int j ) {
+		// the subtree of j: nodes whose predecessor is one of it
+		m_vNodes.clear();
+		m_vNodes.push_back( j );
+		m_vCut[j] = m_nStamp;
+		typename GraphT::const_e_iterator ite, iend;
+		for( size_t k = 0; k < m_vNodes.size(); ++k ) {
+			int u = m_vNodes[k];
+			iend = m_Graph.e_end( u );
+			for( ite = m_Graph.e_begin( u ); ite != iend; ++ite ) {
+				int x = ( *ite ).to();
+				if( m_vPred[x] == u && m_vCut[x] != m_nStamp ) {
+					m_vCut[x] = m_nStamp;
+					m_vNodes.push_back( x );
+				}
+			}
+		}
+		for( size_t k = 0; k < m_vNodes.size(); ++k ) {
+			int x = m_vNodes[k];
+			touch( x );
+			m_vDist[x] = m_wInfty;
+			m_vPred[x] = -1;
+		}
+		// the best way into each from outside the subtree
+		for( size_t k = 0; k < m_vNodes.size(); ++k ) {
+			int x = m_vNodes[k];
+			typename GraphT::in_iterator it, itend = m_Graph.in_end( x );
+			for( it = m_Graph.in_begin( x ); it != itend; ++it ) {
+				int y = *it;
+				if( m_vCut[y] == m_nStamp || !( m_vDist[y] < m_wInfty ) ) {
+					continue;
+				}
+				WeightT d = m_vDist[y] + weight( y, x );
+				if( d < m_vDist[x] ) {
+					m_vDist[x] = d;
+					m_vPred[x] = y;
+				}
+			}
+			if( m_vDist[x] < m_wInfty ) {
+				m_Heap.push( x, m_vDist[x] );
+			}
+		}
+		settle( true );
+	}
+
+	// Dijkstra's loop from the nodes in the heap; within the subtree cut
+	// off only if cut
+	void settle( bool cut ) {
+		typename GraphT::const_e_iterator ite, iend;
+		while( !m_Heap.empty() ) {
+			int u = m_Heap.top();
+			m_Heap.pop();
+			iend = m_Graph.e_end( u );
+			for( ite = m_Graph.e_begin( u ); ite != iend; ++ite ) {
+				int x = ( *ite ).to();
+				if( cut && m_vCut[x] != m_nStamp ) {
+					continue;
+				}
+				WeightT d = m_vDist[u] + m_fWeight( &( *ite ).edge_d() );
+				if( d < m_vDist[x] ) {
+					touch( x );
+					m_vDist[x] = d;
+					m_vPred[x] = u;
+					m_Heap.push( x, d );
+				}
+			}
+		}
+	}
+};
+
+/**@}*/
+
+} // end of namespace afg
+
+#endif
@@ -45,9 +45,14 @@ INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
 #include <functional>
 #include <algorithm>
 #include <exception>
+#include <type_traits>
+#include <memory>
+#include <unordered_map>
 
 #include "afl/util_tl.hpp"
 #include "afl/sorted_list.hpp"
+#include "afl/small_vector.hpp"
+#include "afl/slot_bitmap.hpp"
 #include "graph_intf.h"
 
 namespace afg
@@ -117,6 +122,40 @@ inline std::istream &operator>>( std::istream &is, CiEdge<EdgeDT>& edge )
 }
 //@}
 
+/**@name edge container policies.
+  Select the container CiVertex (and so CGraph) keeps its edges in.
+  elist_policy (the default) uses std::list: one heap allocation per edge,
+  edge iterators stay valid when other edges are inserted/removed.
+  evector_policy uses std::vector and esmall_policy<N> uses afl::small_vector
+  with the first N edges stored inside the vertex itself; both keep
+  edges contiguous (faster traversal, less memory), but inserting or
+  removing an edge of a vertex invalidates iterators to its edges.
+  rebind<T, Al>::other is the container of T using allocator Al.
+*/
+//@{
+/// edges in a std::list
+struct elist_policy {
+	template < class T, class Al = std::allocator<T> > struct rebind {
+		typedef std::list<T, Al> other;
+	};
+};
+
+/// edges in a std::vector
+struct evector_policy {
+	template < class T, class Al = std::allocator<T> > struct rebind {
+		typedef std::vector<T, Al> other;
+	};
+};
+
+/// edges in an afl::small_vector, the first N kept inline
+template<int N = 4>
+struct esmall_policy {
+	template < class T, class Al = std::allocator<T> > struct rebind {
+		typedef afl::small_vector<T, N, Al> other;
+	};
+};
+//@}
+
 /* should make some members protected and make CGraph as friend;
   however, template friend is annoying with C++ (have to put all the template
   names in declarion), so just use public.
@@ -125,10 +164,13 @@ inline std::istream &operator>>( std::istream &is, CiEdge<EdgeDT>& edge )
     @author Aiguo Fei
     @version 0.8a, revision November 2000
 */
-template<class VertexDT, class EdgeDT>
+template < class VertexDT, class EdgeDT, class EdgeC = elist_policy,
+		 class A = std::allocator<char> >
 class CiVertex: public IVertex < VertexDT, EdgeDT,
-	typename std::list<CiEdge<EdgeDT> >::iterator,
-	typename std::list<CiEdge<EdgeDT> >::const_iterator >
+	typename EdgeC::template rebind < CiEdge<EdgeDT>, typename std::allocator_traits<A>::
+	template rebind_alloc<CiEdge<EdgeDT> > >::other::iterator,
+	typename EdgeC::template rebind < CiEdge<EdgeDT>, typename std::allocator_traits<A>::
+	template rebind_alloc<CiEdge<EdgeDT> > >::other::const_iterator >
 {
 public:
 
@@ -136,7 +178,13 @@ public:
 	typedef CiEdge<EdgeDT> iET;
 
 	/// vertex type, this class itself
-	typedef CiVertex<VertexDT, EdgeDT> iVT;
+	typedef CiVertex<VertexDT, EdgeDT, EdgeC, A> iVT;
+
+	/// allocator type of edges, A rebound to iET
+	typedef typename std::allocator_traits<A>::template rebind_alloc<iET> edge_alloc_type;
+
+	/// container type of edges, given by the policy EdgeC
+	typedef typename EdgeC::template rebind<iET, edge_alloc_type>::other container_type;
 
 	/// edge data type
 	typedef EdgeDT EDT;
@@ -145,37 +193,37 @@ public:
 
 	/** iterator type to access edges.
 	*/
-	typedef typename std::list<CiEdge<EdgeDT> >::iterator iterator;
+	typedef typename container_type::iterator iterator;
 
 	/** const iterator type to access edges (read-only).
 	*/
-	typedef typename std::list<CiEdge<EdgeDT> >::const_iterator const_iterator;
+	typedef typename container_type::const_iterator const_iterator;
 
 protected:
 	/// data member, vertex data
 	VertexDT m_VertexD;
 	/// data member, a list of edges.
-	std::list< CiEdge<EdgeDT> > m_lEdges;
+	container_type m_lEdges;
 
 private:
 	// notation convenience, vertex base type
-	typedef IVertex < VertexDT, CiEdge<EdgeDT>,
-			typename std::list<CiEdge<EdgeDT> >::iterator,
-			typename std::list<CiEdge<EdgeDT> >::const_iterator > VBT;
+	typedef IVertex < VertexDT, CiEdge<EdgeDT>, iterator, const_iterator > VBT;
 
 public:
-	/// constructor.
-	explicit CiVertex( const VertexDT &v = VertexDT() )
-		: m_VertexD( v ), m_lEdges()
+	/** constructor.
+	@param a allocator the edges are allocated from (rebound to iET).
+	*/
+	explicit CiVertex( const VertexDT &v = VertexDT(), const A &a = A() )
+		: m_VertexD( v ), m_lEdges( edge_alloc_type( a ) )
 	{ }
 
-	CiVertex( const CiVertex<VertexDT, EdgeDT>& rhs )
+	CiVertex( const CiVertex<VertexDT, EdgeDT, EdgeC, A>& rhs )
 		: m_VertexD( rhs.m_VertexD ), m_lEdges( rhs.m_lEdges )
 	{ }
 
 	/// assignment operator
-	const CiVertex<VertexDT, EdgeDT>& operator=(
-		const CiVertex<VertexDT, EdgeDT>& rhs ) {
+	const CiVertex<VertexDT, EdgeDT, EdgeC, A>& operator=(
+		const CiVertex<VertexDT, EdgeDT, EdgeC, A>& rhs ) {
 		if( this != &rhs ) {
 			m_VertexD = rhs.m_VertexD;
 			m_lEdges = rhs.m_lEdges;
@@ -260,32 +308,37 @@ public:
 	  old edge data will be replaced.
 	  @param nto destination node (index)
 	  @param edge edge data
+	  @return true if this is a new edge, false if an old one is replaced
 	*/
-	void insert_edge( int nto, EdgeDT edge ) {
-		typename std::list<iET>::iterator it =
+	bool insert_edge( int nto, EdgeDT edge ) {
+		iterator it =
 			std::find_if( m_lEdges.begin(), m_lEdges.end(),
 						  std::bind2nd( equal_n<EDT>(), nto ) );
 		if( it == m_lEdges.end() ) {
 			m_lEdges.push_back( CiEdge<EdgeDT>( nto, edge ) );
+			return true;
 		} else {
 			m_lEdges.erase( it );
 			m_lEdges.push_back( CiEdge<EdgeDT>( nto, edge ) );
+			return false;
 		}
 	}
 
 	/** remove an edge for this vertex.
 	    Has no effect if the given edge doesn't exist.
 	  @param nto destination node (index)
+	  @return true if the edge existed and has been removed
 	*/
-	void remove_edge( int nto ) {
-		typename std::list<iET>::iterator it = m_lEdges.begin();
+	bool remove_edge( int nto ) {
+		iterator it = m_lEdges.begin();
 		while( it != m_lEdges.end() ) {
 			if(( *it ).to( ) == nto ) {
 				m_lEdges.erase( it );
-				break;
+				return true;
 			}
 			++it;
 		}
+		return false;
 	}
 
 	/** remove all edges for this vertex.
@@ -294,6 +347,173 @@ public:
 		m_lEdges.clear();
 	}
 
+	/** append an edge without looking for an existing one.
+	    The caller must make sure there is no edge to nto yet.
+	*/
+	void append_edge( int nto, const EdgeDT &edge ) {
+		m_lEdges.push_back( CiEdge<EdgeDT>( nto, edge ) );
+	}
+
+};
+
+/** an edge given by source and destination indices,
+    input of CGraph::assign_edges( ).
+*/
+template<class EdgeDT>
+struct CeTuple {
+	/// source index
+	int from;
+	/// destination index
+	int to;
+	/// edge data
+	EdgeDT edge;
+
+	CeTuple( int i = -1, int j = -1, const EdgeDT &e = EdgeDT() )
+		: from( i ), to( j ), edge( e )
+	{ }
+};
+
+/**@name duplicate edge policies for CGraph::assign_edges( ).
+  Called as dp( kept, dup ) for each duplicate, in input order.
+*/
+//@{
+/// keep the edge data seen first
+struct dup_keep_first {
+	template<class EDT>
+	void operator()( EDT &, const EDT & ) const
+	{ }
+};
+
+/// keep the edge data seen last, same as repeated insert_e( )
+struct dup_keep_last {
+	template<class EDT>
+	void operator()( EDT &kept, const EDT &dup ) const {
+		kept = dup;
+	}
+};
+
+/// combine edge data of duplicates with a binary function: kept=op(kept, dup)
+template<class BinOp>
+struct dup_combine {
+	BinOp m_op;
+
+	explicit dup_combine( const BinOp &op = BinOp() ): m_op( op )
+	{ }
+
+	template<class EDT>
+	void operator()( EDT &kept, const EDT &dup ) const {
+		kept = m_op( kept, dup );
+	}
+};
+
+/// convenience function to make a dup_combine
+template<class BinOp>
+inline dup_combine<BinOp> make_dup_combine( const BinOp &op )
+{
+	return dup_combine<BinOp>( op );
+}
+//@}
+
+/** tag for the f_hash parameter of CGraph: no hash index is kept,
+    find_index( ) does a linear search.
+*/
+struct no_hash {
+};
+
+/** index from vertex data to vertex index, used by CGraph::find_index( ).
+  Several vertices may have equivalent data (e.g., after insert_v_ati( )),
+  find( ) returns the smallest index among them, as a linear search would.
+  f_hash: hash function object for VertexDT, consistent with f_eqv.
+*/
+template<class VertexDT, class f_hash, class f_eqv>
+class CvIndex
+{
+	typedef std::unordered_multimap<VertexDT, int, f_hash, f_eqv> map_type;
+
+	map_type m_Map;
+
+public:
+	/// true if this index is in use (false for no_hash)
+	static const bool enabled = true;
+
+	/// constructor
+	explicit CvIndex( const f_eqv &eqv = f_eqv() )
+		: m_Map( 16, f_hash(), eqv )
+	{ }
+
+	/// add vertex v at index i
+	void insert( const VertexDT &v, int i ) {
+		m_Map.insert( typename map_type::value_type( v, i ) );
+	}
+
+	/// remove vertex v at index i, no effect if not there
+	void erase( const VertexDT &v, int i ) {
+		std::pair<typename map_type::iterator, typename map_type::iterator> r =
+			m_Map.equal_range( v );
+		for( ; r.first != r.second; ++r.first ) {
+			if( r.first->second == i ) {
+				m_Map.erase( r.first );
+				return;
+			}
+		}
+	}
+
+	/// return the smallest index of vertex v, -1 if not found
+	int find( const VertexDT &v ) const {
+		std::pair < typename map_type::const_iterator,
+			typename map_type::const_iterator > r = m_Map.equal_range( v );
+		int n = -1;
+		for( ; r.first != r.second; ++r.first ) {
+			if( n < 0 || r.first->second < n ) {
+				n = r.first->second;
+			}
+		}
+		return n;
+	}
+
+	/// remove all
+	void clear( void ) {
+		m_Map.clear();
+	}
+};
+
+/// no index, all members do nothing
+template<class VertexDT, class f_eqv>
+class CvIndex<VertexDT, no_hash, f_eqv>
+{
+public:
+	static const bool enabled = false;
+
+	explicit CvIndex( const f_eqv & = f_eqv() )
+	{ }
+
+	void insert( const VertexDT &, int )
+	{ }
+
+	void erase( const VertexDT &, int )
+	{ }
+
+	int find( const VertexDT & ) const {
+		return -1;
+	}
+
+	void clear( void )
+	{ }
+};
+
+/** types of the vertex table of CGraph<VertexDT, EdgeDT, *, *, EdgeC, A>.
+  Vertices and their edges are all allocated from (copies of) A, rebound
+  to the element type.
+*/
+template<class VertexDT, class EdgeDT, class EdgeC, class A>
+struct cgraph_types {
+	/// vertex type
+	typedef CiVertex<VertexDT, EdgeDT, EdgeC, A> vertex_type;
+	/// allocator of vertices
+	typedef typename std::allocator_traits<A>::template rebind_alloc<vertex_type>
+	vertex_alloc;
+	/// vertex table
+	typedef std::vector<vertex_type, vertex_alloc> vertex_table;
 };
 
 /** The graph class.
@@ -317,16 +537,37 @@ public:
   EdgeDT: data type of edge data.
   f_eqv: a function object which compares two vertex data to see they
   are equal; by default, std::equal_to is used.
+  f_hash: a hash function object for VertexDT (e.g., std::hash<int>),
+  consistent with f_eqv; if given, a hash index from vertex data to index
+  is kept and find_index( ), and all value-based operations using it
+  (insert_v( ), insert_e( ), get_edge( u, v ), remove_v( ), ...), take
+  expected constant time instead of a linear search. By default (no_hash)
+  there is no index. With an index, vertex data must only be changed
+  through the graph (insert_v_ati( ), set_v_ati( ), ...); after changing
+  it directly via operator[ ], call rebuild_index( ).
+  EdgeC: edge container policy of each vertex, elist_policy (std::list)
+  by default; evector_policy or esmall_policy<N> keep edges contiguous.
+  A: allocator, rebound for the vertex table and the edges of every vertex;
+  std::allocator<char> by default. With a stateful allocator such as
+  afl::arena_allocator (afl/arena.hpp), all nodes of a graph come from one
+  arena, and a short-lived graph or tree is freed in one shot.
+
+  Optionally (see enable_in_index( )) a graph also keeps, for each vertex,
+  the list of vertices having an edge to it. This makes remove_v_byi( )
+  O(degree) instead of O(number of edges), and gives in_begin( )/in_end( )
+  for algorithms which search backwards.
 
   @author Aiguo Fei
   @version 0.5a, November/December 2000
 */
-template < class VertexDT, class EdgeDT, class f_eqv = std::equal_to<VertexDT> >
+template < class VertexDT, class EdgeDT, class f_eqv = std::equal_to<VertexDT>,
+		 class f_hash = no_hash, class EdgeC = elist_policy,
+		 class A = std::allocator<char> >
 class CGraph: public IGraph < VertexDT, EdgeDT,
 	f_eqv,
-	typename std::vector<CiVertex<VertexDT, EdgeDT> >::iterator,
-	typename std::vector<CiVertex<VertexDT, EdgeDT> >::const_iterator,
-	CiVertex<VertexDT, EdgeDT> >
+	typename cgraph_types<VertexDT, EdgeDT, EdgeC, A>::vertex_table::iterator,
+	typename cgraph_types<VertexDT, EdgeDT, EdgeC, A>::vertex_table::const_iterator,
+	CiVertex<VertexDT, EdgeDT, EdgeC, A> >
 {
 
 public:
@@ -344,23 +585,34 @@ public:
 	/// edge type
 	typedef CiEdge<EdgeDT> iET;
 
-	typedef CiVertex<VertexDT, EdgeDT> iVT;
+	typedef CiVertex<VertexDT, EdgeDT, EdgeC, A> iVT;
 
 	/// graph type, this class itself
-	typedef CGraph<VertexDT, EdgeDT, f_eqv> GT;
+	typedef CGraph<VertexDT, EdgeDT, f_eqv, f_hash, EdgeC, A> GT;
 
 	/// type compare function object to determine if two vertex data are equal
 	typedef f_eqv COMPT;
 
+	/// type of hash function object for vertex data, no_hash if none
+	typedef f_hash HASHT;
+
+	/// edge container policy
+	typedef EdgeC ECT;
+
+	/// allocator type
+	typedef A allocator_type;
+
+	/// vertex table type
+	typedef typename cgraph_types<VertexDT, EdgeDT, EdgeC, A>::vertex_table vertex_table;
 
 	/** iterator type to access vertices.
 	*/
-	typedef typename std::vector<CiVertex<VertexDT, EdgeDT> >::iterator iterator;
+	typedef typename cgraph_types<VertexDT, EdgeDT, EdgeC, A>::vertex_table::iterator iterator;
 
 	/** iterator type to access vertices.
 	    Only read access is allowed.
 	*/
-	typedef typename std::vector<CiVertex<VertexDT, EdgeDT> >::const_iterator
+	typedef typename cgraph_types<VertexDT, EdgeDT, EdgeC, A>::vertex_table::const_iterator
 	const_iterator;
 
 	/// edge iterator
@@ -369,10 +621,13 @@ public:
 	/// edge iterator, const
 	typedef typename iVT::const_iterator const_e_iterator;
 
+	/// iterator over in-neighbours (source indices) of a vertex
+	typedef std::vector<int>::const_iterator in_iterator;
+
 	typedef IGraph < VertexDT, EdgeDT, f_eqv,
-			typename std::vector<CiVertex<VertexDT, EdgeDT> >::iterator,
-			typename std::vector<CiVertex<VertexDT, EdgeDT> >::const_iterator,
-			CiVertex<VertexDT, EdgeDT> > igraph_base_type;
+			typename cgraph_types<VertexDT, EdgeDT, EdgeC, A>::vertex_table::iterator,
+			typename cgraph_types<VertexDT, EdgeDT, EdgeC, A>::vertex_table::const_iterator,
+			CiVertex<VertexDT, EdgeDT, EdgeC, A> > igraph_base_type;
 
 	//@}
 
@@ -380,8 +635,11 @@ protected:
 
 	/**@name data members */
 	//@{
+	/// allocator, all vertices and edges are allocated from its copies
+	A m_Alloc;
+
 	/// data member, vertices
-	std::vector< CiVertex<VertexDT, EdgeDT> > m_Vertices;
+	vertex_table m_Vertices;
 
 	/// default vertex value
 	VertexDT m_vDefault;
@@ -392,8 +650,20 @@ protected:
 	/// growth percentage when vertex vector is full
 	double m_dGrow;
 
-	/// list of unused indices in m_Vertices
-	afl::sorted_list<int> m_iUnused;
+	/** unused indices in m_Vertices.
+	  A bitmap, so is_in_use( ) is O(1) and the lowest unused index
+	  is found in amortized O(1) time.
+	*/
+	afl::slot_bitmap m_sUnused;
+
+	/// index from vertex data to index, empty if f_hash is no_hash
+	CvIndex<VertexDT, f_hash, f_eqv> m_vIndex;
+
+	/// if the in-edge index (m_vInSrc) is kept
+	bool m_bInIndex;
+
+	/// in-edge index, m_vInSrc[j] holds i for every edge (i->j)
+	std::vector< std::vector<int> > m_vInSrc;
 	//@}
 
 public:
@@ -404,60 +674,102 @@ public:
 	due to insertion of new vertices.
 	@param eqv predicate to determine if two vertices are equivalent (having
 	the same key or id); default std::equal_to is used.
+	@param a allocator for vertices and edges.
 	*/
 	CGraph( int size = 1, const VertexDT &v = VertexDT(), double dg = 0.25,
-			const f_eqv &eqv = f_eqv() )
+			const f_eqv &eqv = f_eqv(), const A &a = A() )
 		: IGraph < VertexDT, EdgeDT, f_eqv,
-		  typename std::vector<CiVertex<VertexDT, EdgeDT> >::iterator,
-		  typename std::vector<CiVertex<VertexDT, EdgeDT> >::const_iterator,
-		  CiVertex<VertexDT, EdgeDT> >
-		  ( size, v, dg, eqv ),
-		  m_Vertices( size, CiVertex<VertexDT, EdgeDT>( v ) ),
-		  m_vDefault( v ), m_nSize( 0 ), m_dGrow( dg ) {
+		  typename cgraph_types<VertexDT, EdgeDT, EdgeC, A>::vertex_table::iterator,
+		  typename cgraph_types<VertexDT, EdgeDT, EdgeC, A>::vertex_table::const_iterator,
+		  CiVertex<VertexDT, EdgeDT, EdgeC, A> >
+		  ( size, v, dg, eqv ), m_Alloc( a ),
+		  m_Vertices( size, iVT( v, a ), a ),
+		  m_vDefault( v ), m_nSize( 0 ), m_dGrow( dg ),
+		  m_sUnused( size ), m_vIndex( eqv ), m_bInIndex( false ) {
 		// initially vertex table is empty and all indices are unused
-		for( int i = size - 1; i >= 0; --i ) {
-			m_iUnused.push( i );
-		}
 	}
 
 	~CGraph()
 	{}
 
-	CGraph( const CGraph<VertexDT, EdgeDT, f_eqv> &rhs )
+	CGraph( const CGraph<VertexDT, EdgeDT, f_eqv, f_hash, EdgeC, A> &rhs )
 		: IGraph < VertexDT, EdgeDT,
 		  f_eqv,
-		  typename std::vector<CiVertex<VertexDT, EdgeDT> >::iterator,
-		  typename std::vector<CiVertex<VertexDT, EdgeDT> >::const_iterator,
-		  CiVertex<VertexDT, EdgeDT> >
+		  typename cgraph_types<VertexDT, EdgeDT, EdgeC, A>::vertex_table::iterator,
+		  typename cgraph_types<VertexDT, EdgeDT, EdgeC, A>::vertex_table::const_iterator,
+		  CiVertex<VertexDT, EdgeDT, EdgeC, A> >
 		  ( rhs.size(), rhs.m_vDefault, rhs.m_dGrow, rhs.m_eqv ),
-		  m_Vertices( rhs.m_Vertices ), m_vDefault( rhs.m_vDefault ),
+		  m_Alloc( rhs.m_Alloc ), m_Vertices( rhs.m_Vertices ), m_vDefault( rhs.m_vDefault ),
 		  m_nSize( rhs.m_nSize ), m_dGrow( rhs.m_dGrow ),
-		  m_iUnused( rhs.m_iUnused )
+		  m_sUnused( rhs.m_sUnused ), m_vIndex( rhs.m_vIndex ),
+		  m_bInIndex( rhs.m_bInIndex ), m_vInSrc( rhs.m_vInSrc )
 	{ }
 
-	const CGraph<VertexDT, EdgeDT, f_eqv>& operator=
-	( const CGraph<VertexDT, EdgeDT, f_eqv>& rhs ) {
+	const CGraph<VertexDT, EdgeDT, f_eqv, f_hash, EdgeC, A>& operator=
+	( const CGraph<VertexDT, EdgeDT, f_eqv, f_hash, EdgeC, A>& rhs ) {
 		if( this != &rhs ) {
 			igraph_base_type::m_eqv = rhs.m_eqv;
-			m_Vertices = rhs.m_Vertices;
+			if( m_Alloc == rhs.m_Alloc ) {
+				m_Vertices = rhs.m_Vertices;
+			} else {
+				// keep our own allocator for every vertex and edge
+				vertex_table vt( rhs.m_Vertices.size(), iVT( rhs.m_vDefault, m_Alloc ),
+								 m_Alloc );
+				for( size_t i = 0; i < vt.size(); ++i ) {
+					vt[i] = rhs.m_Vertices[i];
+				}
+				m_Vertices.swap( vt );
+			}
 			m_vDefault = rhs.m_vDefault;
 			m_nSize = rhs.m_nSize;
 			m_dGrow = rhs.m_dGrow;
-			m_iUnused = rhs.m_iUnused;
+			m_sUnused = rhs.m_sUnused;
+			m_vIndex = rhs.m_vIndex;
+			m_bInIndex = rhs.m_bInIndex;
+			m_vInSrc = rhs.m_vInSrc;
 		}
 		return *this;
 	}
 
+	/// return a copy of the allocator
+	allocator_type get_allocator( void ) const {
+		return m_Alloc;
+	}
+
 	/// copy all vertices from a graph
 	virtual void copy_vertices( const GT &gra ) {
-		m_Vertices.resize( gra.range() );
+		m_Vertices.resize( gra.range(), iVT( gra.m_vDefault, m_Alloc ) );
 		for( int i = 0; i < gra.range(); ++i ) {
-			m_Vertices[i] = GT::iVT( gra[i].vertex_d() );
+			m_Vertices[i] = iVT( gra[i].vertex_d(), m_Alloc );
 		}
 		m_vDefault = gra.m_vDefault;
 		m_nSize = gra.m_nSize;
 		m_dGrow = gra.m_dGrow;
-		m_iUnused = gra.m_iUnused;
+		m_sUnused = gra.m_sUnused;
+		m_vIndex = gra.m_vIndex;
+		reset_in_index();
+	}
+
+	/** copy all vertices from a graph of another type (e.g., CcsrGraph).
+	    Vertex indices and unused positions are kept; edges are not copied.
+	*/
+	template<class GraphT>
+	typename std::enable_if < !std::is_base_of<GT, GraphT>::value >::type
+	copy_vertices( const GraphT &gra ) {
+		m_vDefault = gra.v_default();
+		m_Vertices.assign( gra.range(), iVT( m_vDefault, m_Alloc ) );
+		m_nSize = 0;
+		m_sUnused.assign( gra.range() );
+		m_vIndex.clear();
+		for( int i = 0; i < gra.range(); ++i ) {
+			if( gra.is_in_use( i ) ) {
+				m_Vertices[i] = iVT( gra[i].vertex_d(), m_Alloc );
+				++m_nSize;
+				m_sUnused.set_used( i );
+				m_vIndex.insert( m_Vertices[i].vertex_d(), i );
+			}
+		}
+		reset_in_index();
 	}
 
 	/**@name element access and helpers*/
@@ -570,10 +882,18 @@ public:
 		return m_Vertices[nfrom].get_edge( nto );
 	}
 
-	/// find the index of vertex v
+	/** find the index of vertex v.
+	    Expected constant time with a hash index, linear search otherwise.
+	    @return the smallest index of a vertex equivalent to v, -1 if none
+	*/
 	virtual int find_index( const VDT &v ) const {
+		if( m_vIndex.enabled && !igraph_base_type::m_eqv( v, m_vDefault ) ) {
+			// unused positions (holding m_vDefault) are not indexed
+			return m_vIndex.find( v );
+		}
 		size_t i = 0;
-		while( i < m_Vertices.size() && !m_eqv( v, m_Vertices[i].vertex_d() ) ) {
+		while( i < m_Vertices.size()
+			   && !igraph_base_type::m_eqv( v, m_Vertices[i].vertex_d() ) ) {
 			++i;
 		}
 		if( i < m_Vertices.size() ) {
@@ -583,6 +903,81 @@ public:
 		}
 	}
 
+	/// find vertex equal to v, return position (iterator)
+	virtual iterator find_vertex( const VDT &v ) {
+		int i = find_index( v );
+		return ( i >= 0 ) ? m_Vertices.begin() + i : m_Vertices.end();
+	}
+
+	/// find vertex equal to v, return position (iterator), const version
+	virtual const_iterator find_vertex( const VDT &v ) const {
+		int i = find_index( v );
+		return ( i >= 0 ) ? m_Vertices.begin() + i : m_Vertices.end();
+	}
+
+	/** rebuild the hash index of vertex data.
+	    Only needed if vertex data has been changed directly, e.g.,
+	    "gra[i].vertex_d() = v"; has no effect if there is no index.
+	*/
+	void rebuild_index( void ) {
+		if( !m_vIndex.enabled ) {
+			return;
+		}
+		m_vIndex.clear();
+		for( int i = 0; i < ( int )m_Vertices.size(); ++i ) {
+			if( is_in_use( i ) ) {
+				m_vIndex.insert( m_Vertices[i].vertex_d(), i );
+			}
+		}
+	}
+
+	/**@name in-edge index */
+	//@{
+	/** start or stop keeping the in-edge index.
+	    Building the index takes O(number of edges); afterwards it is
+	    kept up to date by all edge insertion/removal operations.
+	    Edges must not be changed directly through operator[ ] while
+	    the index is kept.
+	*/
+	void enable_in_index( bool b = true ) {
+		m_bInIndex = b;
+		m_vInSrc.clear();
+		if( b ) {
+			reset_in_index();
+			for( int i = 0; i < ( int )m_Vertices.size(); ++i ) {
+				for( typename iVT::const_iterator it = m_Vertices[i].begin();
+					 it != m_Vertices[i].end(); ++it ) {
+					m_vInSrc[( *it ).to()].push_back( i );
+				}
+			}
+		}
+	}
+
+	/// return if the in-edge index is kept
+	bool has_in_index( void ) const {
+		return m_bInIndex;
+	}
+
+	/** return iterator pointing to the first in-neighbour of vertex i.
+	    Dereferencing gives the index of a vertex having an edge to i,
+	    in no particular order; get_edge_byi( *it, i ) gives the edge data.
+	    Only available if has_in_index( ).
+	*/
+	in_iterator in_begin( int i ) const {
+		return m_vInSrc[i].begin();
+	}
+
+	/// return iterator pointing to the end of in-neighbours of vertex i
+	in_iterator in_end( int i ) const {
+		return m_vInSrc[i].end();
+	}
+
+	/// return the in degree of vertex i, only available if has_in_index( )
+	int in_degree( int i ) const {
+		return ( int )m_vInSrc[i].size();
+	}
+	//@}
+
 	/// return graph size: number of vertices in the graph
 	virtual int size( void ) const {
 		return m_nSize;
@@ -598,11 +993,8 @@ public:
 
 	/// return if i (range checked) is an index used for a vertex.
 	virtual bool is_in_use( int i ) const {
-		if( std::find( m_iUnused.begin(), m_iUnused.end(), i )
-			!= m_iUnused.end() ) {
-			return false;    // index i is still available, so it is not in use
-		}
-		return true;
+		// index i is in use unless it is still available
+		return !m_sUnused.is_free( i );
 	}
 
 	//@}
@@ -615,9 +1007,10 @@ public:
 	virtual void reserve( int n ) {
 		int olds = m_Vertices.size();
 		if( n > olds ) {
-			m_Vertices.resize( n, iVT( m_vDefault ) );
-			for( int i = n - 1; i >= olds; --i ) {
-				m_iUnused.push( i );
+			m_Vertices.resize( n, iVT( m_vDefault, m_Alloc ) );
+			m_sUnused.resize( n );
+			if( m_bInIndex ) {
+				m_vInSrc.resize( n );
 			}
 		}
 	}
@@ -629,79 +1022,59 @@ public:
 	  @return number of index changes that have been made.
 	*/
 	virtual int pack( int ns = 0 ) {
+		return pack( ns, NULL );
+	}
+
+	/** rearrange vertices to make them stored consecutively, O(V+E).
+	  Same as pack( ns ), and if remap is not NULL, it is set to the
+	  old-to-new index table: (*remap)[i] is the new index of the vertex
+	  at old index i, or -1 if i was not in use; remap->size() is the
+	  old range( ). Relative order of vertices is kept.
+	  @param ns new capacity; if ns<size( ), size() will be used.
+	  @param remap pointer to receive the old-to-new index table, or NULL.
+	  @return number of index changes that have been made.
+	*/
+	virtual int pack( int ns, std::vector<int> *remap ) {
 		if( ns < m_nSize ) {
 			ns = m_nSize;
 		}
-		//std::cout<<"size: "<<m_nSize<<", "<<m_Vertices.size()<<", "<<m_iUnused.size()<<std::endl;
-
-		using std::pair;
-		afl::sorted_list< afl::named_pair<int, int> > slind;
-		int i, j, next, ii;
-		// pack vertices into unused vertex table spots
-		if( !m_iUnused.empty() ) {
-			i = m_iUnused.front(); // first unused spot
-			j = i + 1;
-			m_iUnused.pop_front();
-			//std::cout<<"first: "<<i<<std::endl;
-			while( j < ( int )m_Vertices.size() && !m_iUnused.empty() ) {
-				next = m_iUnused.front();
-				m_iUnused.pop_front();
-				while( next == j && !m_iUnused.empty() ) {
-					// find a consecutive block to move
-					++j;
-					next = m_iUnused.front();
-					m_iUnused.pop_front();
-				}
-				//std::cout<<"block: "<<i<<", "<<j<<", "<<next<<std::endl;
-				for( ; j < next; ++j ) {
-					// move this block
-					// old index j is mapped to new index i, note: always i<j
-					//std::cout<<j<<"->"<<i<<std::endl;
+
+		std::vector<int> vlocal;
+		std::vector<int> &vmap = ( remap != NULL ) ? *remap : vlocal;
+		int nold = ( int )m_Vertices.size();
+		vmap.assign( nold, -1 );
+		int i, j, ii;
+		// move each vertex in use to the next spot, note: always i<=j
+		int nretn = 0;
+		for( i = 0, j = 0; j < nold; ++j ) {
+			if( is_in_use( j ) ) {
+				if( i != j ) {
 					m_Vertices[i] = m_Vertices[j];
-					slind.push( afl::named_pair<int, int>( i, j ) );
-					++i;
+					++nretn;
 				}
-				j = next + 1;
-			} // end of while( j<... )
-			// last block
-			//std::cout<<"block: "<<i<<", "<<j<<", "<<m_Vertices.size()<<std::endl;
-			for( ; j < ( int )m_Vertices.size(); ++j ) {
-				// old index j is mapped to new index i, note: always i<j
-				//std::cout<<j<<"->"<<i<<std::endl;
-				m_Vertices[i] = m_Vertices[j];
-				slind.push( afl::named_pair<int, int>( i, j ) );
-				++i;
+				vmap[j] = i++;
 			}
-		}// end of if
-		// update edges' destination indices for all vertices affected,
-		// the mapping of j->i has been sorted from small to large according to j;
-		// because always i<j, the mapping update won't mess up
-		// ?note: can't use iterator m_Vertices[ii].begin()
-		afl::named_pair<int, int> pin;
-		typename iVT::iterator it;
-		int nretn = 0;
-		while( !slind.empty() ) {
-			pin = slind.front();
-			slind.pop_front();
+		}
+		// update edges' destination indices, one pass over all edges
+		if( nretn > 0 ) {
+			typename iVT::iterator it;
 			for( ii = 0; ii < m_nSize; ++ii ) {
 				for( it = m_Vertices[ii].begin();
 					 it != m_Vertices[ii].end(); ++it ) {
-					if(( *it ).to( ) == pin.key ) {
-						( *it ).to( ) = pin.name;
-						//std::cout<<pin.key<<"->"<<pin.name<<std::endl;
-					}
+					( *it ).to( ) = vmap[( *it ).to( )];
 				}
 			}
-			++nretn;
 		}
-		for( ii = m_nSize; ii < afl::tmin( ns, ( int )m_Vertices.size() ); ++ii ) {
-			//std::cout<<"set default: "<<ii<<std::endl;
-			m_Vertices[ii] = iVT( m_vDefault );
+		for( ii = m_nSize; ii < afl::tmin( ns, nold ); ++ii ) {
+			m_Vertices[ii] = iVT( m_vDefault, m_Alloc );
+		}
+		m_Vertices.resize( ns, iVT( m_vDefault, m_Alloc ) );
+		m_sUnused.assign( range(), m_nSize ); // unused indices: [m_nSize, range()-1]
+		if( nretn > 0 ) {
+			rebuild_index();
 		}
-		m_Vertices.resize( ns, iVT( m_vDefault ) );
-		m_iUnused.clear( );
-		for( ii = range() - 1; ii >= m_nSize; --ii ) {
-			m_iUnused.push( ii );    // unused indices
+		if( m_bInIndex ) {
+			enable_in_index( true );
 		}
 
 		return nretn;
@@ -718,11 +1091,11 @@ public:
 	*/
 	virtual int insert_v_qik( const VDT &v ) {
 		// there is still unused index
-		if( !m_iUnused.empty() ) {
-			int i = m_iUnused.front();
-			m_Vertices[i] = iVT( v );
-			m_iUnused.pop_front();
+		if( !m_sUnused.empty() ) {
+			int i = m_sUnused.acquire();
+			m_Vertices[i] = iVT( v, m_Alloc );
 			++m_nSize;
+			m_vIndex.insert( v, i );
 			return i;
 		} else {
 			// vertex table is full, grow it first
@@ -765,15 +1138,32 @@ public:
 			grow( i + 1 );
 		}
 
+		// remove i from unused indices if it is there
+		if( m_sUnused.is_free( i ) ) {
+			m_sUnused.set_used( i );
+			++m_nSize; // new vertex at position i
+		} else {
+			m_vIndex.erase( m_Vertices[i].vertex_d(), i );
+		}
+
 		m_Vertices[i].set( v );
+		m_vIndex.insert( v, i );
+		return true;
+	}
 
-		// remove i from unused index list if it is in list
-		afl::sorted_list<int>::iterator it = std::find( m_iUnused.begin(),
-											 m_iUnused.end(), i );
-		if( it != m_iUnused.end() ) {
-			m_iUnused.erase( it );
-			++m_nSize; // new vertex at position i
+	/** set the value of vertex at position i.
+	    Value of existing vertex at position i (if exist) will be replaced by v,
+	    any existing edge will be kept.
+	    Has no effect if there is no vertex at position i.
+	    @return true if replacement succeeds; false if there is no vertex at i.
+	*/
+	virtual bool set_v_ati( const VDT &v, int i ) {
+		if( !igraph_base_type::is_valid( i ) ) {
+			return false;
 		}
+		m_vIndex.erase( m_Vertices[i].vertex_d(), i );
+		m_Vertices[i].set( v );
+		m_vIndex.insert( v, i );
 		return true;
 	}
 
@@ -795,13 +1185,23 @@ public:
 	virtual void remove_v_byi( int vi ) {
 		if( igraph_base_type::is_valid( vi ) ) {
 			// valid index
-			for( int i = 0; i < ( int )m_Vertices.size(); ++i ) {
-				m_Vertices[i].remove_edge( vi );
+			if( m_bInIndex ) {
+				// only visit vertices with an edge to vi
+				std::vector<int> vin;
+				vin.swap( m_vInSrc[vi] );
+				for( size_t k = 0; k < vin.size(); ++k ) {
+					m_Vertices[vin[k]].remove_edge( vi );
+				}
+			} else {
+				for( int i = 0; i < ( int )m_Vertices.size(); ++i ) {
+					m_Vertices[i].remove_edge( vi );
+				}
 			}
-			m_Vertices[vi].remove_all();
+			unlink_all( vi );
+			m_vIndex.erase( m_Vertices[vi].vertex_d(), vi );
 			m_Vertices[vi].set( m_vDefault );
 			--m_nSize;
-			m_iUnused.push( vi );
+			m_sUnused.set_free( vi );
 		}
 	}
 
@@ -817,7 +1217,7 @@ public:
 		if( i >= 0 ) {
 			int j = find_index( v );
 			if( j >= 0 ) {
-				m_Vertices[i].insert_edge( j, e );
+				link( i, j, e );
 				return true;
 			}
 		}
@@ -834,8 +1234,8 @@ public:
 		if( i >= 0 ) {
 			int j = find_index( v );
 			if( j >= 0 ) {
-				m_Vertices[i].insert_edge( j, e );
-				m_Vertices[j].insert_edge( i, e );
+				link( i, j, e );
+				link( j, i, e );
 				return true;
 			}
 		}
@@ -853,7 +1253,7 @@ public:
 			return false;
 		}
 
-		m_Vertices[i].insert_edge( j, e );
+		link( i, j, e );
 		return true;
 	}
 
@@ -868,8 +1268,8 @@ public:
 			return false;
 		}
 
-		m_Vertices[i].insert_edge( j, e );
-		m_Vertices[j].insert_edge( i, e );
+		link( i, j, e );
+		link( j, i, e );
 		return true;
 	}
 
@@ -894,8 +1294,8 @@ public:
 		if( n1 >= 0 ) {
 			int n2 = find_index( v );
 			if( n2 >= 0 ) {
-				m_Vertices[n1].remove_edge( n2 );
-				m_Vertices[n2].remove_edge( n1 );
+				unlink( n1, n2 );
+				unlink( n2, n1 );
 			}
 		}
 	}
@@ -912,7 +1312,7 @@ public:
 	virtual void remove_e_byi( int nfrom, int nto ) {
 		if( igraph_base_type::is_in_range( nfrom )
 			&& igraph_base_type::is_in_range( nto ) ) {
-			m_Vertices[nfrom].remove_edge( nto );
+			unlink( nfrom, nto );
 		}
 	}
 
@@ -920,15 +1320,15 @@ public:
 	    Has no effect if edge not found. */
 	virtual void remove_2e_byi( int n1, int n2 ) {
 		if( igraph_base_type::is_in_range( n1 ) && igraph_base_type::is_in_range( n2 ) ) {
-			m_Vertices[n1].remove_edge( n2 );
-			m_Vertices[n2].remove_edge( n1 );
+			unlink( n1, n2 );
+			unlink( n2, n1 );
 		}
 	}
 
 	/// remove all edges of vertex of index nfrom
 	virtual void remove_alle_byi( int nfrom ) {
 		if( igraph_base_type::is_in_range( nfrom ) ) {
-			m_Vertices[nfrom].remove_all();
+			unlink_all( nfrom );
 		}
 	}
 
@@ -937,17 +1337,141 @@ public:
 		for( int i = 0; i < ( int )m_Vertices.size(); ++i ) {
 			m_Vertices[i].remove_all();
 		}
-		;
+		reset_in_index();
+	}
+
+	/** replace all edges by those in [first, last), in O(V+E).
+	  Each element is a CeTuple<EDT> (from, to, edge). Tuples are bucketed
+	  by source (a counting sort) and de-duplicated once per vertex, instead
+	  of the linear duplicate search of every insert_e_byi( ).
+	  The result is the same as remove_all_edges( ) followed by
+	  insert_e_byi( ) for each tuple in order, except that the data of
+	  duplicates is decided by dp: dup_keep_first, dup_keep_last (default)
+	  or dup_combine. Edges of a vertex are ordered by the last occurrence
+	  of their destination, as repeated insert_e_byi( ) leaves them.
+	  Tuples with an invalid source or destination are ignored.
+	  Not for CrTree, which needs insert_e( ) to keep parents (it hides
+	  it). To add to the edges of the graph, see insert_edges( ).
+	  @param first, last forward iterators over CeTuple<EDT>
+	  @param dp duplicate policy, see dup_keep_first etc.
+	  @return number of edges in the graph
+	*/
+	template<class FwdIt, class DupPolicy>
+	int assign_edges( FwdIt first, FwdIt last, DupPolicy dp ) {
+		remove_all_edges();
+		int n = ( int )m_Vertices.size();
+		// count out degree (with duplicates) of each vertex
+		std::vector<int> vstart( n + 1, 0 );
+		FwdIt it;
+		for( it = first; it != last; ++it ) {
+			if( igraph_base_type::is_valid(( *it ).from )
+				&& igraph_base_type::is_valid(( *it ).to ) ) {
+				++vstart[( *it ).from + 1];
+			}
+		}
+		int i, k;
+		for( i = 0; i < n; ++i ) {
+			vstart[i + 1] += vstart[i];
+		}
+		// bucket tuples by source, input order kept within a bucket
+		std::vector<const CeTuple<EDT>*> vbkt( vstart[n] );
+		std::vector<int> vnext( vstart.begin(), vstart.end() - 1 );
+		for( it = first; it != last; ++it ) {
+			if( igraph_base_type::is_valid(( *it ).from )
+				&& igraph_base_type::is_valid(( *it ).to ) ) {
+				vbkt[vnext[( *it ).from]++] = &( *it );
+			}
+		}
+		// de-duplicate each bucket: vslot[j] is the position of edge (i->j)
+		// in vkept if vstamp[j]==i; vlast[k] is the last occurrence of vkept[k]
+		std::vector<int> vstamp( n, -1 ), vslot( n ), vlast, vorder;
+		std::vector<CiEdge<EDT> > vkept;
+		int nedges = 0;
+		for( i = 0; i < n; ++i ) {
+			int nb = vstart[i + 1] - vstart[i];
+			if( nb == 0 ) {
+				continue;
+			}
+			vkept.clear();
+			vlast.clear();
+			for( k = 0; k < nb; ++k ) {
+				const CeTuple<EDT> &t = *vbkt[vstart[i] + k];
+				if( vstamp[t.to] != i ) {
+					vstamp[t.to] = i;
+					vslot[t.to] = ( int )vkept.size();
+					vkept.push_back( CiEdge<EDT>( t.to, t.edge ) );
+					vlast.push_back( k );
+				} else {
+					dp( vkept[vslot[t.to]].edge_d(), t.edge );
+					vlast[vslot[t.to]] = k;
+				}
+			}
+			// order by last occurrence, positions are distinct within [0, nb)
+			vorder.assign( nb, -1 );
+			for( k = 0; k < ( int )vkept.size(); ++k ) {
+				vorder[vlast[k]] = k;
+			}
+			for( k = 0; k < nb; ++k ) {
+				if( vorder[k] >= 0 ) {
+					const CiEdge<EDT> &e = vkept[vorder[k]];
+					m_Vertices[i].append_edge( e.to(), e.edge_d() );
+				}
+			}
+			nedges += ( int )vkept.size();
+		}
+		if( m_bInIndex ) {
+			enable_in_index( true );
+		}
+		return nedges;
+	}
+
+	/// assign_edges( ) with dup_keep_last
+	template<class FwdIt>
+	int assign_edges( FwdIt first, FwdIt last ) {
+		return assign_edges( first, last, dup_keep_last() );
+	}
+
+	/** insert the edges in [first, last), keeping the edges already in
+	  the graph: assign_edges( ) over the present edges followed by the
+	  tuples, the same as insert_e_byi( ) for each tuple in order but for
+	  duplicates, decided by dp (a present edge coming first). O(V+E).
+	  Not for CrTree.
+	  @return number of edges in the graph
+	*/
+	template<class FwdIt, class DupPolicy>
+	int insert_edges( FwdIt first, FwdIt last, DupPolicy dp ) {
+		std::vector< CeTuple<EDT> > vt;
+		for( int i = 0; i < ( int )m_Vertices.size(); ++i ) {
+			if( !igraph_base_type::is_valid( i ) ) {
+				continue;
+			}
+			const_e_iterator ite, iend = m_Vertices[i].end();
+			for( ite = m_Vertices[i].begin(); ite != iend; ++ite ) {
+				vt.push_back( CeTuple<EDT>( i, ( *ite ).to(), ( *ite ).edge_d() ) );
+			}
+		}
+		if( vt.empty() ) {
+			return assign_edges( first, last, dp );
+		}
+		vt.insert( vt.end(), first, last );
+		return assign_edges( vt.begin(), vt.end(), dp );
+	}
+
+	/// insert_edges( ) with dup_keep_last
+	template<class FwdIt>
+	int insert_edges( FwdIt first, FwdIt last ) {
+		return insert_edges( first, last, dup_keep_last() );
 	}
 
 	/// clear all nodes and all their edges
 	virtual void clear( void ) {
 		m_nSize = 0;
-		m_iUnused.clear();
+		m_sUnused.assign( m_Vertices.size() );
+		m_vIndex.clear();
 		for( int i = ( int )m_Vertices.size() - 1; i >= 0; --i ) {
-			m_Vertices[i] = iVT( m_vDefault );
-			m_iUnused.push( i );
+			m_Vertices[i] = iVT( m_vDefault, m_Alloc );
 		}
+		reset_in_index();
 	}
 	//@} // end of insertion/deletion
 
@@ -959,14 +1483,62 @@ protected:
 		n = ( n > nold ) ? n : nold + 1;
 		n = ( n > ns ) ? n : ns;
 
-		m_Vertices.resize( n, iVT( m_vDefault ) );
-		for( int i = n - 1; i >= nold; --i ) {
-			m_iUnused.push( i );
+		m_Vertices.resize( n, iVT( m_vDefault, m_Alloc ) );
+		m_sUnused.resize( n );
+		if( m_bInIndex ) {
+			m_vInSrc.resize( n );
 		}
 
 		return n;
 	}
 
+	/**@name edge insertion/removal helpers, keeping the in-edge index.
+	  All changes of edges go through these.
+	*/
+	//@{
+	/// insert (or replace) edge (i->j)
+	void link( int i, int j, const EDT &e ) {
+		if( m_Vertices[i].insert_edge( j, e ) && m_bInIndex ) {
+			m_vInSrc[j].push_back( i );
+		}
+	}
+
+	/// remove edge (i->j), if it exists
+	void unlink( int i, int j ) {
+		if( m_Vertices[i].remove_edge( j ) && m_bInIndex ) {
+			erase_in( j, i );
+		}
+	}
+
+	/// remove all edges of vertex i
+	void unlink_all( int i ) {
+		if( m_bInIndex ) {
+			for( typename iVT::const_iterator it = m_Vertices[i].begin();
+				 it != m_Vertices[i].end(); ++it ) {
+				erase_in( ( *it ).to(), i );
+			}
+		}
+		m_Vertices[i].remove_all();
+	}
+
+	// remove i from the in-neighbours of j
+	void erase_in( int j, int i ) {
+		std::vector<int> &vin = m_vInSrc[j];
+		std::vector<int>::iterator it = std::find( vin.begin(), vin.end(), i );
+		if( it != vin.end() ) {
+			*it = vin.back();
+			vin.pop_back();
+		}
+	}
+
+	// empty in-edge lists for all vertices (if the index is kept)
+	void reset_in_index( void ) {
+		if( m_bInIndex ) {
+			m_vInSrc.assign( m_Vertices.size(), std::vector<int>() );
+		}
+	}
+	//@}
+
 };
 // end of CGraph
 
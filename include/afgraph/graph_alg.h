@@ -41,6 +41,8 @@ INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
 
 #include <vector>
 
+#include "graph_view.h"
+
 namespace afg
 {
 
@@ -63,19 +65,20 @@ template<class GT>
 bool is_connected( const GT &grf )
 {
 	// find distances between all pairs
-	int n = grf.range();
+	typedef graph_view<GT> GV;
+	int n = GV::range( grf );
 	//std::cout<<"n: "<<n<<std::endl;
 
 	std::vector<int> vdist( n * n, n * n );
 	// vdist[j*n+i] is distance between (i,j)
 	// first, if there is edge (i,j) then d(i,j)=1;
-	typename GT::const_e_iterator eit;
+	typename GV::const_e_iterator eit;
 	int i, j, k;
 	for( i = 0; i < n; ++i ) {
 		vdist[i *n+i] = 0;
-		for( eit = grf.e_begin( i );
-			 eit != grf.e_end( i ); ++eit ) {
-			vdist[( *eit ).to( )*n+i] = 1;
+		for( eit = GV::e_begin( grf, i );
+			 eit != GV::e_end( grf, i ); ++eit ) {
+			vdist[GV::to( eit )*n+i] = 1;
 		}
 	}
 	// run an all-pair shortest-path algorithm
@@ -93,7 +96,7 @@ bool is_connected( const GT &grf )
 		for( j = 0; j < n; ++j ) {
 			if( j != i ) {
 				//std::cout<<i<<", "<<j<<": "<<vdist[j*n+i]<<std::endl;
-				if( vdist[j *n+i] >= n * n && grf.is_in_use( i ) && grf.is_in_use( j ) ) {
+				if( vdist[j *n+i] >= n * n && GV::is_in_use( grf, i ) && GV::is_in_use( grf, j ) ) {
 					return false;
 				}
 			}
@@ -110,16 +113,52 @@ bool is_connected( const GT &grf )
 template< class GraphT, class Fun >
 typename Fun::result_type graph_cost( const GraphT &g, Fun f_w )
 {
+	typedef graph_view<GraphT> GV;
 	typename Fun::result_type wt = ( typename Fun::result_type )0;
-	typename GraphT::const_e_iterator ie;
-	for( int i = 0; i < g.range(); ++i ) {
-		for( ie = g[i].begin(); ie != g[i].end(); ++ie ) {
-			wt = wt + f_w( &(( *ie ).edge_d() ) );
+	typename GV::const_e_iterator ie, iend;
+	int n = GV::range( g );
+	for( int i = 0; i < n; ++i ) {
+		iend = GV::e_end( g, i );
+		for( ie = GV::e_begin( g, i ); ie != iend; ++ie ) {
+			wt = wt + f_w( &( GV::edge_d( ie ) ) );
 		}
 	}
 	return wt;
 }
 
+/** Compute the smallest and largest edge cost of the graph.
+@param g the given graph
+@param f_w function object that returns the cost of an edge
+@param wmin smallest cost, not changed if there is no edge
+@param wmax largest cost, not changed if there is no edge
+@return false if the graph has no edge
+*/
+template< class GraphT, class Fun >
+bool weight_range( const GraphT &g, Fun f_w, typename Fun::result_type &wmin,
+				   typename Fun::result_type &wmax )
+{
+	typedef graph_view<GraphT> GV;
+	typename Fun::result_type w;
+	typename GV::const_e_iterator ie, iend;
+	bool found = false;
+	int n = GV::range( g );
+	for( int i = 0; i < n; ++i ) {
+		iend = GV::e_end( g, i );
+		for( ie = GV::e_begin( g, i ); ie != iend; ++ie ) {
+			w = f_w( &( GV::edge_d( ie ) ) );
+			if( !found ) {
+				wmin = wmax = w;
+				found = true;
+			} else if( w < wmin ) {
+				wmin = w;
+			} else if( wmax < w ) {
+				wmax = w;
+			}
+		}
+	}
+	return found;
+}
+
 /**@}*/
 
 } // end of namespace afg
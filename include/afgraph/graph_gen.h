@@ -70,8 +70,11 @@ graph generators, convertors, input/export utilities
       and edge data type of int (every edge has weight 1).
     @param grf result graph. grf should be empty before passed to this function;
       grf.clear( ) will make it emtpy. A newly created graph is empty as well.
+    GraphT: T_xynGraph, or any graph type with the same vertex/edge data
+      and insert_v( )/insert_2e( ), e.g. CuGraph.
 */
-void grid_graph_gen( T_xynGraph &grf, int n, int m )
+template<class GraphT>
+void grid_graph_gen( GraphT &grf, int n, int m )
 {
 	if( n <= 0 || m <= 0 ) {
 		return;
@@ -119,8 +122,11 @@ void grid_graph_gen( T_xynGraph &grf, int n, int m )
       after n trials, then gives up.
     @return number of links in graph generated;
       since every link is bidirectional, # of edges=2*(# of links).
+    GraphT: T_xydGraph, or any graph type with the same vertex/edge data
+      and insert_v( )/insert_2e( ), e.g. CuGraph.
 */
-int bmw_graph_gen( T_xydGraph &dgrf,
+template<class GraphT>
+int bmw_graph_gen( GraphT &dgrf,
 				   int ngrid, int n, int ntry = 10,
 				   double lamda = 0.3, double rou = 0.3 )
 {
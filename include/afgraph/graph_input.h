@@ -33,10 +33,12 @@ INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
 #define _AFG_GRAPH_INPUT_H_
 
 #include <string>
+#include <vector>
 
 #include <sstream>
 
 #include "gexception.h"
+#include "graph.h"
 
 namespace afg
 {
@@ -113,6 +115,9 @@ void input_gra_die( GT &gra, std::istream &is )
 	int ntotal = 0;
 	int j;
 	EDT w;
+	// edges are collected and then added at once to those in gra
+	std::vector< CeTuple<EDT> > vedges;
+	vedges.reserve( 2 * nlinks );
 
 	if( sdir.c_str()[0] == 'd' && sdir.c_str()[1] == 'i' ) {
 		// uni-directional
@@ -124,7 +129,7 @@ void input_gra_die( GT &gra, std::istream &is )
 
 			iste >> i >> j >> w;
 			if( i >= 0 && i < nnodes && j >= 0 && j < nnodes ) {
-				gra.insert_e_byi( i, j, w );
+				vedges.push_back( CeTuple<EDT>( i, j, w ) );
 			} else {
 				throw afl::general_except<std::string>( "input edge error" );
 			}
@@ -140,13 +145,15 @@ void input_gra_die( GT &gra, std::istream &is )
 
 			iste >> i >> j >> w;
 			if( i >= 0 && i < nnodes && j >= 0 && j < nnodes ) {
-				gra.insert_2e_byi( i, j, w );
+				vedges.push_back( CeTuple<EDT>( i, j, w ) );
+				vedges.push_back( CeTuple<EDT>( j, i, w ) );
 			} else {
 				throw afl::general_except<std::string>( "input edge error" );
 			}
 			ntotal++;
 		}
 	}
+	gra.insert_edges( vedges.begin(), vedges.end() );
 }
 
 /** input graph for type vie
@@ -192,6 +199,9 @@ void input_gra_vie( GT &gra, std::istream &is )
 	int j;
 	EDT edg;
 	ntotal = 0;
+	// edges are collected and then added at once to those in gra
+	std::vector< CeTuple<EDT> > vedges;
+	vedges.reserve( 2 * nlinks );
 	//cout<<"reading links\n";
 	if( sdir.c_str()[0] == 'd' && sdir.c_str()[1] == 'i' ) {
 		// uni-directional
@@ -203,7 +213,7 @@ void input_gra_vie( GT &gra, std::istream &is )
 
 			iste >> i >> j >> edg;
 			if( i >= 0 && i < nnodes && j >= 0 && j < nnodes ) {
-				gra.insert_e_byi( i, j, edg );
+				vedges.push_back( CeTuple<EDT>( i, j, edg ) );
 			} else {
 				throw afl::general_except<std::string>( "input edge error" );
 			}
@@ -219,13 +229,15 @@ void input_gra_vie( GT &gra, std::istream &is )
 
 			iste >> i >> j >> edg;
 			if( i >= 0 && i < nnodes && j >= 0 && j < nnodes ) {
-				gra.insert_2e_byi( i, j, edg );
+				vedges.push_back( CeTuple<EDT>( i, j, edg ) );
+				vedges.push_back( CeTuple<EDT>( j, i, edg ) );
 			} else {
 				throw afl::general_except<std::string>( "input edge error" );
 			}
 			ntotal++;
 		}
 	}
+	gra.insert_edges( vedges.begin(), vedges.end() );
 	//std::cout<<gra<<std::endl;
 }
 
@@ -271,7 +283,12 @@ void input_gra_vve( GT &gra, std::istream &is )
 
 	VIDT vid1, vid2;
 	EDT edg;
+	int i, j;
 	ntotal = 0;
+	// edges are collected and then added at once to those in gra,
+	// edges with an unknown vertex are ignored
+	std::vector< CeTuple<EDT> > vedges;
+	vedges.reserve( 2 * nlinks );
 	//cout<<"reading links\n";
 	if( sdir.c_str()[0] == 'd' && sdir.c_str()[1] == 'i' ) {
 		// uni-directional
@@ -283,7 +300,11 @@ void input_gra_vve( GT &gra, std::istream &is )
 			std::istringstream iste( sbuf );
 
 			iste >> vid1 >> vid2 >> edg;
-			gra.insert_e( VDT( vid1 ), VDT( vid2 ), edg );
+			i = gra.find_index( VDT( vid1 ) );
+			j = gra.find_index( VDT( vid2 ) );
+			if( i >= 0 && j >= 0 ) {
+				vedges.push_back( CeTuple<EDT>( i, j, edg ) );
+			}
 			ntotal++;
 		}
 	} else {
@@ -296,10 +317,16 @@ void input_gra_vve( GT &gra, std::istream &is )
 
 			iste >> vid1 >> vid2 >> edg;
 			//cout<<vid1<<", "<<vid2<<": "<<edg<<endl;
-			gra.insert_2e( VDT( vid1 ), VDT( vid2 ), edg );
+			i = gra.find_index( VDT( vid1 ) );
+			j = gra.find_index( VDT( vid2 ) );
+			if( i >= 0 && j >= 0 ) {
+				vedges.push_back( CeTuple<EDT>( i, j, edg ) );
+				vedges.push_back( CeTuple<EDT>( j, i, edg ) );
+			}
 			ntotal++;
 		}
 	}
+	gra.insert_edges( vedges.begin(), vedges.end() );
 	//std::cout<<gra<<std::endl;
 }
 
@@ -349,6 +376,8 @@ bool input_gra_i_2e( GT &gra, std::istream &is )
 	int j;
 	EDT edg;
 	ntotal = 0;
+	std::vector< CeTuple<EDT> > vedges;
+	vedges.reserve( 2 * nlinks );
 	//cout<<"reading links\n";
 	while( ntotal < nlinks && is ) {
 		while( std::getline( is, sbuf ) && ( sbuf.size() < 1 || sbuf.at( 0 ) == '#' ) )
@@ -357,7 +386,8 @@ bool input_gra_i_2e( GT &gra, std::istream &is )
 		iste >> i >> j >> edg;
 		//cout<<i<<", "<<", "<<edg<<endl;
 		if( i >= 0 && i < nnodes && j >= 0 && j < nnodes ) {
-			gra.insert_2e_byi( i, j, edg );
+			vedges.push_back( CeTuple<EDT>( i, j, edg ) );
+			vedges.push_back( CeTuple<EDT>( j, i, edg ) );
 		} else {
 			return false;
 		}
@@ -365,6 +395,7 @@ bool input_gra_i_2e( GT &gra, std::istream &is )
 		ntotal++;
 	}
 
+	gra.insert_edges( vedges.begin(), vedges.end() );
 	//std::cout<<gra<<std::endl;
 
 	return true;
@@ -274,9 +274,9 @@ public:
 		// so "," will not be printed if there is only one edge
 		if( it != end() ) {
 			os << *it;
-		}
-		while( ++it != end() ) {
-			os << ", " << *it;
+			while( ++it != end() ) {
+				os << ", " << *it;
+			}
 		}
 		return os;
 	}
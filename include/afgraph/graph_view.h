@@ -0,0 +1,147 @@
+/*@copyright
+
+Copyright (c) 2012 Aiguo Fei
+All rights reserved.
+
+Permission to use and re-distribute this code in source and binary forms
+with or without modifications is therefore granted provided that
+the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Information regarding where to obtain the original source code must be
+      included with the redistrbution.
+
+*NO WARRANTY*
+THIS CODE OR PROGRAM IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S)
+"AS IS" WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE. THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S) MUST NOT BE
+HELD RESPONSIBLE FOR ANY DAMAGE OR UNDESIRED EFFECT CAUSED DIRECTLY OR
+INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
+
+*/
+
+
+
+
+/**@file graph_view.h
+
+  non-virtual access to a graph for algorithm inner loops.
+
+*/
+
+#ifndef _AFG_GRAPH_VIEW_H_
+#define _AFG_GRAPH_VIEW_H_
+
+#include <type_traits>
+
+#include "graph.h"
+
+namespace afg
+{
+
+/**@addtogroup galg
+*/
+/**@{*/
+
+/// helpers to tell if a type is (derived from) some CGraph
+template<class V, class E, class Q, class H, class C, class A>
+std::true_type is_cgraph_test( const CGraph<V, E, Q, H, C, A> * );
+std::false_type is_cgraph_test( ... );
+
+/// is_cgraph<G>::value is true if G is CGraph or derived from it (e.g. CrTree)
+template<class G>
+struct is_cgraph: public decltype( is_cgraph_test(( const G * )0 ) ) {
+};
+
+/** static access to a graph: range, vertex validity and out edges.
+  Algorithms go through graph_view<GraphT> instead of the graph itself.
+  This generic version simply forwards to the graph; it is for graph
+  types whose access functions are not virtual already (e.g. CcsrGraph),
+  or whose concrete type is not known (e.g. a reference to IGraph).
+  No range checking is done: i must be within [0, range( )-1].
+*/
+template<class GraphT, bool bCGraph = is_cgraph<GraphT>::value>
+struct graph_view {
+	/// edge data type
+	typedef typename GraphT::EDT EDT;
+	/// iterator over out edges of a vertex
+	typedef typename GraphT::const_e_iterator const_e_iterator;
+
+	static int range( const GraphT &g ) {
+		return g.range();
+	}
+	static bool is_in_use( const GraphT &g, int i ) {
+		return g.is_in_use( i );
+	}
+	static bool is_valid( const GraphT &g, int i ) {
+		return g.is_valid( i );
+	}
+	static const_e_iterator e_begin( const GraphT &g, int i ) {
+		return g.e_begin( i );
+	}
+	static const_e_iterator e_end( const GraphT &g, int i ) {
+		return g.e_end( i );
+	}
+	static int out_degree( const GraphT &g, int i ) {
+		return g[i].out_degree();
+	}
+	/// destination of the edge pointed to by ite
+	static int to( const const_e_iterator &ite ) {
+		return ( *ite ).to();
+	}
+	/// data of the edge pointed to by ite
+	static const EDT &edge_d( const const_e_iterator &ite ) {
+		return ( *ite ).edge_d();
+	}
+};
+
+/** static access to CGraph and derived classes.
+  Calls are qualified with the CGraph/CiVertex/CiEdge class names, so
+  they bypass the virtual functions of IGraph/IVertex/IEdge and can be
+  inlined. Derived classes must not change what these functions do
+  (CrTree doesn't).
+*/
+template<class GraphT>
+struct graph_view<GraphT, true> {
+	/// the CGraph base type
+	typedef typename GraphT::GT CGT;
+	typedef typename CGT::iVT iVT;
+	typedef typename CGT::iET iET;
+	typedef typename CGT::EDT EDT;
+	typedef typename CGT::const_e_iterator const_e_iterator;
+
+	static int range( const GraphT &g ) {
+		return g.CGT::range();
+	}
+	static bool is_in_use( const GraphT &g, int i ) {
+		return g.CGT::is_in_use( i );
+	}
+	static bool is_valid( const GraphT &g, int i ) {
+		return i >= 0 && i < g.CGT::range() && g.CGT::is_in_use( i );
+	}
+	static const_e_iterator e_begin( const GraphT &g, int i ) {
+		return g.CGT::operator[]( i ).iVT::begin();
+	}
+	static const_e_iterator e_end( const GraphT &g, int i ) {
+		return g.CGT::operator[]( i ).iVT::end();
+	}
+	static int out_degree( const GraphT &g, int i ) {
+		return g.CGT::operator[]( i ).iVT::out_degree();
+	}
+	static int to( const const_e_iterator &ite ) {
+		return ( *ite ).iET::to();
+	}
+	static const EDT &edge_d( const const_e_iterator &ite ) {
+		return ( *ite ).iET::edge_d();
+	}
+};
+
+/**@}*/
+
+}// end of namespace afg
+
+#endif
@@ -0,0 +1,641 @@
+/*@copyright
+
+Copyright (c) 2012 Aiguo Fei
+All rights reserved.
+
+Permission to use and re-distribute this code in source and binary forms
+with or without modifications is therefore granted provided that
+the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Information regarding where to obtain the original source code must be
+      included with the redistrbution.
+
+*NO WARRANTY*
+THIS CODE OR PROGRAM IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S)
+"AS IS" WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE. THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S) MUST NOT BE
+HELD RESPONSIBLE FOR ANY DAMAGE OR UNDESIRED EFFECT CAUSED DIRECTLY OR
+INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
+
+*/
+
+
+
+
+/**@file ksp.h
+
+  k shortest paths with memory about O(E + kV): Eppstein's algorithm for
+  the k shortest paths (loops allowed) from a source to all destinations
+  (CkspEppstein), and Yen's algorithm for the k shortest loopless paths
+  between two nodes (CkspYen); both with the interface of CkthSP.
+
+*/
+
+#ifndef _AFG_KSP_H_
+#define _AFG_KSP_H_
+
+#include <vector>
+#include <set>
+#include <utility>
+#include <algorithm>
+#include <limits>
+
+#include "afl/indexed_heap.hpp"
+#include "path.h"
+#include "graph_view.h"
+#include "shortest_path.h"
+
+namespace afg
+{
+
+/**@addtogroup gspalg
+*/
+/**@{*/
+
+/** k shortest paths from a source to every destination, by Eppstein's
+    algorithm ("Finding the k shortest paths", 1998). As with CkthSP,
+    paths may go through a node more than once (the 2nd shortest path
+    from the source to itself is the shortest cycle through it), and
+    get_first( ), get_next( ), get_path( ) and increase_k( ) work the same
+    way; CkspEppstein can be used in place of CkthSP. Where several paths
+    have the same length they may come in another order.
+
+    A path is given by the edges it takes off the shortest path tree
+    from the source (sidetracks), each costing what it adds to the length.
+    The sidetracks into the nodes of the tree path to v are kept in a
+    persistent heap shared along the tree, O(E + V log V) memory in all;
+    each destination then keeps a small heap of candidate paths, and each
+    path found costs O(log k) time and O(1) memory (a sidetrack and the
+    path it extends). Paths are put together for get_path( ) only.
+    The graph must not change while a CkspEppstein of it is in use.
+    @see CkthSP CkspYen
+*/
+template<class GraphT, class Fun >
+class CkspEppstein
+{
+public:
+	///
+	typedef typename Fun::result_type WT;
+
+	/** constructor, arguments as for CkthSP.
+	@param thegra graph on which to run the algorithm, a reference is kept
+	@param source source node
+	@param k desired kth
+	@param fw function object used to get edge weight, pass pointer
+	@param winfty an "upper bound" value of weight which should be larger
+		than the path length of any valid path.
+	*/
+	CkspEppstein( const GraphT &thegra, int source, int k, Fun fw, WT winfty ):
+		m_gra( thegra ), m_nSource( source ), m_nK( k ),
+		f_Weight( fw ), m_wInfty( winfty ), m_kCurrent( 0 ),
+		m_nSize( graph_view<GraphT>::range( thegra ) )
+	{ }
+
+private:
+	typedef graph_view<GraphT> GV;
+
+	// node of the persistent (leftist) heap of sidetracks along the tree
+	struct hnode {
+		int side;
+		int left, right;
+		int rank;
+	};
+
+	// a path found or a candidate: a sidetrack (persistent heap node if
+	// >= 0, ~index into the sidetrack heap of its head otherwise, nil for
+	// the shortest path) taken before the path parent
+	struct entry {
+		WT d;
+		int node;
+		int parent;
+	};
+
+	// orders candidates by length, then by when they were found
+	struct entry_less {
+		const std::vector<entry> *pv;
+		bool operator()( int a, int b ) const {
+			const entry &ea = ( *pv )[a], &eb = ( *pv )[b];
+			return eb.d < ea.d || ( !( ea.d < eb.d ) && b < a );
+		}
+	};
+
+	static const int nil = -2147483647 - 1;
+
+	const GraphT &m_gra;
+	int m_nSource;
+	int m_nK;
+	Fun f_Weight;
+	WT m_wInfty;
+	int m_kCurrent;
+	int m_nSize;
+
+	std::vector<int> m_vPred;
+	std::vector<WT> m_vDist;
+	// sidetracks into v are [m_vSideOff[v], m_vSideOff[v+1]): the one of
+	// least cost first, the others as a binary heap after it
+	std::vector<int> m_vSideOff;
+	std::vector<int> m_vSideFrom;
+	std::vector<int> m_vSideTo;
+	std::vector<WT> m_vSideCost;
+	std::vector<hnode> m_vHeap;
+	// root of the persistent heap of node v, -1 if empty
+	std::vector<int> m_vRoot;
+	std::vector<entry> m_vEntry;
+	// paths found to each node, and candidates (a heap)
+	std::vector<std::vector<int> > m_vFound;
+	std::vector<std::vector<int> > m_vCand;
+
+public:
+	/** get the first shortest path.
+	    This should be the first function to call after constructor.
+	*/
+	void get_first( ) {
+		m_kCurrent = 1;
+		m_vEntry.clear();
+		m_vHeap.clear();
+		m_vFound.assign( m_nSize, std::vector<int>() );
+		m_vCand.assign( m_nSize, std::vector<int>() );
+		m_vRoot.assign( m_nSize, -1 );
+		if( !dijkstra<GraphT, Fun>( m_gra, m_nSource, f_Weight, m_wInfty, m_vPred, m_vDist ) ) {
+			m_vSideOff.assign( m_nSize + 1, 0 );
+			return;
+		}
+		build_sidetracks();
+		build_heaps();
+		for( int t = 0; t < m_nSize; ++t ) {
+			if( m_vDist[t] < m_wInfty ) {
+				m_vFound[t].push_back( add_entry( m_vDist[t], nil, -1 ) );
+				if( m_vRoot[t] >= 0 ) {
+					push( t, m_vDist[t] + m_vSideCost[m_vHeap[m_vRoot[t]].side],
+						  m_vRoot[t], m_vFound[t].back() );
+				}
+			}
+		}
+	}
+
+	/// call this one to compute the next shortest path (from ith to (i+1)th ).
+	void get_next( ) {
+		if( m_kCurrent >= m_nK ) {
+			return;
+		}
+		++m_kCurrent;
+		for( int t = 0; t < m_nSize; ++t ) {
+			std::vector<int> &vc = m_vCand[t];
+			if( vc.empty() ) {
+				continue;
+			}
+			entry_less cmp = { &m_vEntry };
+			std::pop_heap( vc.begin(), vc.end(), cmp );
+			int id = vc.back();
+			vc.pop_back();
+			m_vFound[t].push_back( id );
+			expand( t, id );
+		}
+	}
+
+	/** return the ith shortest path to node nt.
+		get_next( ) should have been already called (nk-1) times.
+	@param nt destination node
+	@param nk the nkth shortest-path to nt
+	@param lp the path retrieved, empty if there is none
+	@return the total "weight" (distance) of the path, winfty if none
+	*/
+	WT get_path( int nt, int nk, CPath &lp ) {
+		lp.clear();
+		if( nt < 0 || nt >= m_nSize || nk < 1 || nk > m_nK || nk > m_kCurrent
+			|| nk > ( int )m_vFound[nt].size() ) {
+			return m_wInfty;
+		}
+		int id = m_vFound[nt][nk - 1];
+		// sidetracks, the last of the path first
+		std::vector<int> vside;
+		for( int e = id; e >= 0 && m_vEntry[e].node != nil; e = m_vEntry[e].parent ) {
+			vside.push_back( side_of( m_vEntry[e].node ) );
+		}
+		int x = nt;
+		for( int k = ( int )vside.size() - 1; k >= 0; --k ) {
+			int g = vside[k];
+			while( x != m_vSideTo[g] ) {
+				lp.push_front( x );
+				x = m_vPred[x];
+			}
+			lp.push_front( x );
+			x = m_vSideFrom[g];
+		}
+		while( x != m_nSource ) {
+			lp.push_front( x );
+			x = m_vPred[x];
+		}
+		lp.push_front( x );
+		return m_vEntry[id].d;
+	}
+
+	/// increase k value to newk, no effect if newk<=old k
+	bool increase_k( int newk ) {
+		if( newk > m_nK ) {
+			m_nK = newk;
+		}
+		return true;
+	}
+
+private:
+	int add_entry( WT d, int node, int parent ) {
+		entry e = { d, node, parent };
+		m_vEntry.push_back( e );
+		return ( int )m_vEntry.size() - 1;
+	}
+
+	void push( int t, WT d, int node, int parent ) {
+		m_vCand[t].push_back( add_entry( d, node, parent ) );
+		entry_less cmp = { &m_vEntry };
+		std::push_heap( m_vCand[t].begin(), m_vCand[t].end(), cmp );
+	}
+
+	int side_of( int node ) const {
+		return node >= 0 ? m_vHeap[node].side : ~node;
+	}
+
+	// candidates following path id to t: the next sidetracks in the
+	// heaps in place of its last one, and one more sidetrack before it
+	void expand( int t, int id ) {
+		entry e = m_vEntry[id];
+		int g = side_of( e.node );
+		int v = m_vSideTo[g], beg = m_vSideOff[v] + 1, end = m_vSideOff[v + 1];
+		WT d0 = e.d - m_vSideCost[g];
+		if( e.node >= 0 ) {
+			const hnode &h = m_vHeap[e.node];
+			if( h.left >= 0 ) {
+				push( t, d0 + m_vSideCost[m_vHeap[h.left].side], h.left, e.parent );
+			}
+			if( h.right >= 0 ) {
+				push( t, d0 + m_vSideCost[m_vHeap[h.right].side], h.right, e.parent );
+			}
+			if( beg < end ) {
+				push( t, d0 + m_vSideCost[beg], ~beg, e.parent );
+			}
+		} else {
+			for( int c = beg + 2 * ( g - beg ) + 1; c < end && c <= beg + 2 * ( g - beg ) + 2; ++c ) {
+				push( t, d0 + m_vSideCost[c], ~c, e.parent );
+			}
+		}
+		int r = m_vRoot[m_vSideFrom[g]];
+		if( r >= 0 ) {
+			push( t, e.d + m_vSideCost[m_vHeap[r].side], r, id );
+		}
+	}
+
+	// edges off the shortest path tree between reached nodes, by head
+	void build_sidetracks( void ) {
+		int n = m_nSize, u;
+		typename GV::const_e_iterator ite, iend;
+		std::vector<unsigned char> vtree( n, 0 );
+		m_vSideOff.assign( n + 1, 0 );
+		for( int pass = 0; pass < 2; ++pass ) {
+			std::vector<int> vpos( m_vSideOff.begin(), m_vSideOff.end() - 1 );
+			for( u = 0; u < n; ++u ) {
+				if( !( m_vDist[u] < m_wInfty ) ) {
+					continue;
+				}
+				iend = GV::e_end( m_gra, u );
+				for( ite = GV::e_begin( m_gra, u ); ite != iend; ++ite ) {
+					int v = GV::to( ite );
+					WT d = m_vDist[u] + f_Weight( &( GV::edge_d( ite ) ) );
+					// the tree edge, the first one of pred[v] of the right length
+					if( m_vPred[v] == u && vtree[v] == pass && d == m_vDist[v] ) {
+						vtree[v] = ( unsigned char )( pass + 1 );
+						continue;
+					}
+					if( pass == 0 ) {
+						++m_vSideOff[v + 1];
+					} else {
+						int k = vpos[v]++;
+						m_vSideFrom[k] = u;
+						m_vSideTo[k] = v;
+						m_vSideCost[k] = d - m_vDist[v];
+					}
+				}
+			}
+			if( pass == 0 ) {
+				for( u = 0; u < n; ++u ) {
+					m_vSideOff[u + 1] += m_vSideOff[u];
+				}
+				m_vSideFrom.resize( m_vSideOff[n] );
+				m_vSideTo.resize( m_vSideOff[n] );
+				m_vSideCost.resize( m_vSideOff[n] );
+			}
+		}
+		// least cost first, a heap of the others after it
+		for( int v = 0; v < n; ++v ) {
+			int beg = m_vSideOff[v], end = m_vSideOff[v + 1];
+			if( beg == end ) {
+				continue;
+			}
+			std::vector<std::pair<WT, int> > vs;
+			for( int k = beg; k < end; ++k ) {
+				vs.push_back( std::make_pair( m_vSideCost[k], m_vSideFrom[k] ) );
+			}
+			std::iter_swap( vs.begin(), std::min_element( vs.begin(), vs.end() ) );
+			std::make_heap( vs.begin() + 1, vs.end(), std::greater<std::pair<WT, int> >() );
+			for( int k = beg; k < end; ++k ) {
+				m_vSideCost[k] = vs[k - beg].first;
+				m_vSideFrom[k] = vs[k - beg].second;
+			}
+		}
+	}
+
+	// persistent heap of each node: the least sidetrack into it added to
+	// that of its tree parent
+	void build_heaps( void ) {
+		int n = m_nSize;
+		std::vector<int> voff( n + 1, 0 ), vchild;
+		int v;
+		for( v = 0; v < n; ++v ) {
+			if( m_vPred[v] >= 0 ) {
+				++voff[m_vPred[v] + 1];
+			}
+		}
+		for( v = 0; v < n; ++v ) {
+			voff[v + 1] += voff[v];
+		}
+		vchild.resize( voff[n] );
+		std::vector<int> vpos( voff.begin(), voff.end() - 1 );
+		for( v = 0; v < n; ++v ) {
+			if( m_vPred[v] >= 0 ) {
+				vchild[vpos[m_vPred[v]]++] = v;
+			}
+		}
+		std::vector<int> vstack( 1, m_nSource );
+		while( !vstack.empty() ) {
+			v = vstack.back();
+			vstack.pop_back();
+			int r = m_vPred[v] >= 0 ? m_vRoot[m_vPred[v]] : -1;
+			if( m_vSideOff[v] < m_vSideOff[v + 1] ) {
+				hnode h = { m_vSideOff[v], -1, -1, 1 };
+				m_vHeap.push_back( h );
+				r = merge(( int )m_vHeap.size() - 1, r );
+			}
+			m_vRoot[v] = r;
+			for( int k = voff[v]; k < voff[v + 1]; ++k ) {
+				vstack.push_back( vchild[k] );
+			}
+		}
+	}
+
+	int rank( int a ) const {
+		return a < 0 ? 0 : m_vHeap[a].rank;
+	}
+
+	// merge a new single node a into heap b, copying the nodes of b it
+	// changes
+	int merge( int a, int b ) {
+		if( b < 0 ) {
+			return a;
+		}
+		if( m_vSideCost[m_vHeap[a].side] < m_vSideCost[m_vHeap[b].side] ) {
+			m_vHeap[a].left = b;
+			m_vHeap[a].rank = 1;
+			return a;
+		}
+		hnode h = m_vHeap[b];
+		int r = merge( a, h.right );
+		h.right = r;
+		if( rank( h.left ) < rank( h.right ) ) {
+			std::swap( h.left, h.right );
+		}
+		h.rank = rank( h.right ) + 1;
+		m_vHeap.push_back( h );
+		return ( int )m_vHeap.size() - 1;
+	}
+};
+
+/** k shortest loopless paths between two nodes, by Yen's algorithm
+    ("Finding the k shortest loopless paths in a network", 1971): the
+    (i+1)th path is the shortest of the candidates made from the ith by
+    leaving it at each of its nodes (a spur node) by an edge none of the
+    first i paths with the same start takes there, and going on without
+    the nodes before; each candidate is one Dijkstra search.
+    get_first( ), get_next( ), get_path( ) and increase_k( ) work as for
+    CkthSP, with paths to the destination given to the constructor only.
+    Memory is O(V + E) for the searches, plus the paths found and the
+    candidates. The graph must not change while a CkspYen of it is in use.
+    @see CkthSP CkspEppstein
+*/
+template<class GraphT, class Fun >
+class CkspYen
+{
+public:
+	///
+	typedef typename Fun::result_type WT;
+
+	/** constructor.
+	@param thegra graph on which to run the algorithm, a reference is kept
+	@param source source node
+	@param dest destination node
+	@param k desired kth
+	@param fw function object used to get edge weight, pass pointer
+	@param winfty an "upper bound" value of weight which should be larger
+		than the path length of any valid path.
+	*/
+	CkspYen( const GraphT &thegra, int source, int dest, int k, Fun fw, WT winfty ):
+		m_gra( thegra ), m_nSource( source ), m_nDest( dest ), m_nK( k ),
+		f_Weight( fw ), m_wInfty( winfty ), m_kCurrent( 0 ),
+		m_nSize( graph_view<GraphT>::range( thegra ) ), m_nStamp( 0 )
+	{ }
+
+private:
+	typedef graph_view<GraphT> GV;
+	typedef std::pair<WT, std::vector<int> > path_t;
+
+	const GraphT &m_gra;
+	int m_nSource, m_nDest;
+	int m_nK;
+	Fun f_Weight;
+	WT m_wInfty;
+	int m_kCurrent;
+	int m_nSize;
+
+	// paths found, and their lengths up to each node
+	std::vector<std::vector<int> > m_vPath;
+	std::vector<std::vector<WT> > m_vLen;
+	std::set<path_t> m_sCand;
+	// search state: entries valid where m_vStamp is m_nStamp; a node is
+	// left out where m_vBan is m_nStamp
+	std::vector<unsigned int> m_vStamp, m_vBan;
+	unsigned int m_nStamp;
+	std::vector<WT> m_vDist;
+	std::vector<int> m_vPred;
+	afl::indexed_heap<WT> m_Heap;
+
+public:
+	/** get the first shortest path.
+	    This should be the first function to call after constructor.
+	*/
+	void get_first( ) {
+		m_kCurrent = 1;
+		m_vPath.clear();
+		m_vLen.clear();
+		m_sCand.clear();
+		m_vStamp.assign( m_nSize, 0 );
+		m_vBan.assign( m_nSize, 0 );
+		m_vDist.resize( m_nSize );
+		m_vPred.resize( m_nSize );
+		m_Heap.reset( m_nSize );
+		m_nStamp = 0;
+		if( !GV::is_valid( m_gra, m_nSource ) || m_nDest < 0 || m_nDest >= m_nSize ) {
+			return;
+		}
+		std::vector<int> vban;
+		std::vector<int> vp;
+		if( search( m_nSource, vban, vp ) ) {
+			add_path( vp );
+		}
+	}
+
+	/// call this one to compute the next shortest path (from ith to (i+1)th ).
+	void get_next( ) {
+		if( m_kCurrent >= m_nK ) {
+			return;
+		}
+		++m_kCurrent;
+		if(( int )m_vPath.size() < m_kCurrent - 1 || m_vPath.empty() ) {
+			return;    // no more paths
+		}
+		const std::vector<int> last = m_vPath.back();
+		const std::vector<WT> lastlen = m_vLen.back();
+		std::vector<int> vban, vp;
+		for( int i = 0; i + 1 < ( int )last.size(); ++i ) {
+			// edges from the spur node of paths with the same start
+			vban.clear();
+			for( size_t k = 0; k < m_vPath.size(); ++k ) {
+				const std::vector<int> &p = m_vPath[k];
+				if(( int )p.size() > i + 1 && std::equal( last.begin(), last.begin() + i + 1, p.begin() ) ) {
+					vban.push_back( p[i + 1] );
+				}
+			}
+			if( !search( last[i], vban, vp, &last, i ) ) {
+				continue;
+			}
+			path_t c;
+			c.second.assign( last.begin(), last.begin() + i );
+			c.second.insert( c.second.end(), vp.begin(), vp.end() );
+			c.first = lastlen[i] + m_vDist[m_nDest];
+			m_sCand.insert( c );
+		}
+		if( !m_sCand.empty() ) {
+			add_path( m_sCand.begin()->second );
+			m_sCand.erase( m_sCand.begin() );
+		}
+	}
+
+	/** return the ith shortest path to node nt.
+		get_next( ) should have been already called (nk-1) times.
+	@param nt destination node, the one given to the constructor
+	@param nk the nkth shortest-path to nt
+	@param lp the path retrieved, empty if there is none
+	@return the total "weight" (distance) of the path, winfty if none
+	*/
+	WT get_path( int nt, int nk, CPath &lp ) {
+		lp.clear();
+		if( nt != m_nDest || nk < 1 || nk > m_nK || nk > m_kCurrent
+			|| nk > ( int )m_vPath.size() ) {
+			return m_wInfty;
+		}
+		lp.assign( m_vPath[nk - 1].begin(), m_vPath[nk - 1].end() );
+		return m_vLen[nk - 1].back();
+	}
+
+	/// increase k value to newk, no effect if newk<=old k
+	bool increase_k( int newk ) {
+		if( newk > m_nK ) {
+			m_nK = newk;
+		}
+		return true;
+	}
+
+private:
+	void add_path( const std::vector<int> &vp ) {
+		std::vector<WT> vl( 1, ( WT )0 );
+		for( size_t k = 1; k < vp.size(); ++k ) {
+			vl.push_back( vl.back() + weight( vp[k - 1], vp[k] ) );
+		}
+		m_vPath.push_back( vp );
+		m_vLen.push_back( vl );
+	}
+
+	// weight of the lightest edge (u->v)
+	WT weight( int u, int v ) const {
+		WT w = m_wInfty;
+		typename GV::const_e_iterator ite, iend = GV::e_end( m_gra, u );
+		for( ite = GV::e_begin( m_gra, u ); ite != iend; ++ite ) {
+			WT we = f_Weight( &( GV::edge_d( ite ) ) );
+			if( GV::to( ite ) == v && we < w ) {
+				w = we;
+			}
+		}
+		return w;
+	}
+
+	// shortest path from ns to the destination not through the nodes of
+	// proot before position nroot nor by edges from ns to vban, into vp
+	bool search( int ns, const std::vector<int> &vban, std::vector<int> &vp,
+				 const std::vector<int> *proot = NULL, int nroot = 0 ) {
+		if( ++m_nStamp == 0 ) {
+			std::fill( m_vStamp.begin(), m_vStamp.end(), 0 );
+			std::fill( m_vBan.begin(), m_vBan.end(), 0 );
+			m_nStamp = 1;
+		}
+		for( int k = 0; k < nroot; ++k ) {
+			m_vBan[( *proot )[k]] = m_nStamp;
+		}
+		m_Heap.clear();
+		m_vStamp[ns] = m_nStamp;
+		m_vDist[ns] = ( WT )0;
+		m_vPred[ns] = -1;
+		m_Heap.push( ns, ( WT )0 );
+		typename GV::const_e_iterator ite, iend;
+		bool bfound = false;
+		while( !m_Heap.empty() ) {
+			int u = m_Heap.top();
+			m_Heap.pop();
+			if( u == m_nDest ) {
+				bfound = true;
+				break;
+			}
+			iend = GV::e_end( m_gra, u );
+			for( ite = GV::e_begin( m_gra, u ); ite != iend; ++ite ) {
+				int v = GV::to( ite );
+				if( m_vBan[v] == m_nStamp || v == ns
+					|| ( u == ns && std::find( vban.begin(), vban.end(), v ) != vban.end() ) ) {
+					continue;
+				}
+				WT d = m_vDist[u] + f_Weight( &( GV::edge_d( ite ) ) );
+				if( m_vStamp[v] != m_nStamp || d < m_vDist[v] ) {
+					m_vStamp[v] = m_nStamp;
+					m_vDist[v] = d;
+					m_vPred[v] = u;
+					m_Heap.push( v, d );
+				}
+			}
+		}
+		if( !bfound ) {
+			return false;
+		}
+		vp.clear();
+		for( int x = m_nDest; x >= 0; x = m_vPred[x] ) {
+			vp.push_back( x );
+		}
+		std::reverse( vp.begin(), vp.end() );
+		return true;
+	}
+};
+
+/**@}*/
+
+} // end of namespace afg
+
+#endif
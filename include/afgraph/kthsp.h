@@ -38,7 +38,14 @@ INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
 
 //#include <iostream>
 
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+#include "afl/indexed_heap.hpp"
+#include "afl/thread_pool.hpp"
 #include "path.h"
+#include "graph_view.h"
 #include "shortest_path.h"
 
 namespace afg
@@ -64,6 +71,18 @@ namespace afg
     To get the ith shortest path, have to call get_next( ) (i-1) times
     (after calling get_first( ) ).
     If want to go beyond the initial k, call increase_k( ) to specify a new k value.
+
+    The kth path to node j is the shortest of, over the edges (i->j),
+    the next path to i not yet extended by that edge, plus the edge.
+    Each round goes through the in-edges of every node (kept in
+    compressed rows, with how many times each was taken), the nodes in
+    parallel on a thread pool; the edges whose next path to i is the kth
+    one itself are few, and settled after that by a Dijkstra search
+    among them. Edges are by index; self loops are not taken.
+    Each path is kept as the path it extends and its last node (see
+    CPathStore), and put together by get_path( ) only.
+    Memory is O(E + kV); for large graphs or k see CkspEppstein (ksp.h),
+    which works the same way.
 */
 template<class GraphT, class Fun >
 class CkthSP
@@ -79,16 +98,19 @@ public:
 	@param winfty an "upper bound" value of weight which should be larger
 		than the path length of any valid path; used to initialize distance
 		to all nodes.
+	@param nthreads threads for get_next( ), including the calling one;
+	  0 for the number of hardware threads. A copy of a CkthSP gets
+	  a thread pool of its own, of the same size.
 	*/
 	CkthSP( const GraphT &thegra, int source, int k, Fun fw,
-			typename Fun::result_type winfty ):
+			typename Fun::result_type winfty, int nthreads = 1 ):
 		m_gra( thegra ), m_nSource( source ), m_nK( k ),
 		f_Weight( fw ), m_wInfty( winfty ),
-		m_kCurrent( 0 ), m_nSize( thegra.range() ),
-		m_vDist( thegra.range()*( k + 1 ), winfty ),
-		m_vp( thegra.range()*thegra.range(), -1 ),
-		m_vPred( thegra.range()*( k + 1 ), -1 ),
-		m_vPath( thegra.range()*( k + 1 ) )
+		m_kCurrent( 0 ), m_nSize( graph_view<GraphT>::range( thegra ) ),
+		m_vDist( m_nSize *( k + 1 ), winfty ),
+		m_vPred( m_nSize *( k + 1 ), -1 ),
+		m_vPath( m_nSize *( k + 1 ), -1 ),
+		m_Pool( nthreads )
 
 	{ }
 
@@ -99,6 +121,8 @@ public:
 	typedef typename Fun::result_type  WT;
 
 private:
+	typedef graph_view<GraphT> GV;
+
 	const GraphT &m_gra;
 	int m_nSource;
 	int m_nK;
@@ -109,9 +133,28 @@ private:
 	int m_kCurrent;
 	int m_nSize;
 	std::vector<WT> m_vDist;
-	std::vector<int> m_vp;
 	std::vector<int> m_vPred;
-	std::vector<CPath> m_vPath;
+	// paths, as ids in m_Paths (-1: none)
+	std::vector<int> m_vPath;
+	CPathStore m_Paths;
+	// in-edges of j: [m_vInOff[j], m_vInOff[j+1]), by source index; the
+	// weight, and how many paths to j so far end by the edge
+	std::vector<int> m_vInOff;
+	std::vector<int> m_vInSrc;
+	std::vector<WT> m_vInW;
+	std::vector<int> m_vInUse;
+	// in-edge of the path to each node found by the current round, -1 if none
+	std::vector<int> m_vEdge;
+	// a thread pool which is copied as a new pool of the same size
+	struct pool_t : public afl::thread_pool {
+		explicit pool_t( int nthreads ): afl::thread_pool( nthreads ) { }
+		pool_t( const pool_t &rhs ): afl::thread_pool( rhs.size() ) { }
+	};
+	pool_t m_Pool;
+	// per thread: in-edges (e, j) whose next path is of the current round
+	std::vector< std::vector< std::pair<int, int> > > m_vSame;
+	afl::indexed_heap<WT> m_Heap;
+	std::vector<char> m_vState;
 
 public:
 
@@ -121,26 +164,41 @@ public:
 	void get_first( ) {
 		m_kCurrent = 1;
 		int k = m_kCurrent;
+		// rounds 2.. of an earlier run; get_next( ) only improves on them
+		size_t n2 = std::min( m_vDist.size(), ( size_t )m_nSize * 2 );
+		std::fill( m_vDist.begin() + n2, m_vDist.end(), m_wInfty );
+		std::fill( m_vPred.begin() + n2, m_vPred.end(), -1 );
 		std::vector<WT> vd( m_nSize, m_wInfty );
 		std::vector<int> vpred( m_nSize, -1 );
 		dijkstra<GraphT, Fun>( m_gra, m_nSource, f_Weight, m_wInfty, vpred, vd );
 		m_vDist[m_nSource] = ( WT )0;
-		int i, j;
-		for( i = 0; i < m_nSize; i++ )
-			for( j = 0; j < m_nSize; j++ ) {
-				m_vp[m_nSize *i+j] = 0;
-			}
-
+		int j;
+		build_in_edges();
 		for( j = 0; j < m_nSize; j++ ) {
 			m_vDist[m_nSize *k+j] = vd[j];
 			if( vpred[j] >= 0 ) {
-				m_vp[m_nSize *vpred[j] + j] = 1;
 				m_vPred[m_nSize *k+j] = vpred[j];
+				++m_vInUse[find_in_edge( vpred[j], j )];
 			}
 		}
 
+		// paths of the tree, each extending that of its predecessor; ids of
+		// an earlier run point into the cleared store
+		m_Paths.clear();
+		std::fill( m_vPath.begin(), m_vPath.end(), -1 );
+		int *pid = &m_vPath[m_nSize * k];
+		if( m_nSource >= 0 && m_nSource < m_nSize ) {
+			pid[m_nSource] = m_Paths.extend( -1, m_nSource );
+		}
+		std::vector<int> vstack;
 		for( j = 0; j < m_nSize; j++ ) {
-			pred2path( vpred, m_nSource, j, m_vPath[m_nSize*k+j] );
+			for( int x = j; pid[x] < 0 && vpred[x] >= 0; x = vpred[x] ) {
+				vstack.push_back( x );
+			}
+			for( ; !vstack.empty(); vstack.pop_back() ) {
+				int x = vstack.back();
+				pid[x] = m_Paths.extend( pid[vpred[x]], x );
+			}
 		}
 	}
 
@@ -152,43 +210,54 @@ public:
 			return ;
 		}
 
-		int i, j, k = m_kCurrent;
-		const typename GraphT::EDT *pedg;
-
-		//cerr<<"k="<<k<<endl;
-
-		for( j = 0; j < m_nSize; j++ ) {
-			//bool isupdated=false;
-			for( i = 0; i < m_nSize; i++ ) {
-				if( i != j ) {
-					if(( pedg = m_gra.get_edge( i, j ) ) ) {
-						int k2 = m_vp[m_nSize*i+j] + 1;
-
-						//cerr<<j<<": "<<m_vDist[ m_nSize*k+j]<<", i="<<i<<", k2="<<k2<<", "
-						//<<m_vDist[ m_nSize*k2 +i ]<<", w="<<f_Weight( pedg)<<endl;
-
-						if( m_vDist[ m_nSize*k+j]
-							> m_vDist[ m_nSize*k2 +i ] + f_Weight( pedg ) ) {
-							m_vDist[ m_nSize *k+j] = m_vDist[ m_nSize*k2 +i ] + f_Weight( pedg ) ;
-							m_vPath[ m_nSize *k+j] = m_vPath[m_nSize*k2+i];
-							m_vPath[ m_nSize*k+j].push_back( j );
-							m_vPred[ m_nSize *k+j] = i;
-							//isupdated=true;
-
-							//cerr<<"update to "<<i<<", "<<m_vDist[ m_nSize*k+j]<<endl;
+		int k = m_kCurrent, n = m_nSize;
+		const int nchunk = 256;
+		for( size_t t = 0; t < m_vSame.size(); ++t ) {
+			m_vSame[t].clear();
+		}
+		// by in-edges whose next path is of an earlier round; ties go to
+		// the lowest source index
+		m_Pool.parallel_for( n, [&]( int j, int t ) {
+			WT *pd = &m_vDist[n * k + j];
+			int best = -1;
+			for( int e = m_vInOff[j]; e < m_vInOff[j + 1]; ++e ) {
+				int k2 = m_vInUse[e] + 1;
+				if( k2 == k ) {
+					m_vSame[t].push_back( std::make_pair( e, j ) );
+					continue;
+				}
+				WT d = m_vDist[n * k2 + m_vInSrc[e]];
+				if( d < m_wInfty && *pd > d + m_vInW[e] ) {
+					*pd = d + m_vInW[e];
+					best = e;
+				}
+			}
+			m_vEdge[j] = best;
+		}, nchunk );
 
-						}
-					}
+		// by in-edges whose next path is of this round
+		std::vector<int> vorder;
+		settle_same( k, vorder );
 
-				}
-			}// for (i)
-		}// for( j)
+		for( int j = 0; j < n; j++ ) {
+			if( m_vEdge[j] >= 0 && m_vState[j] == 0 ) {
+				set_path( k, j, m_vEdge[j] );
+			}
+		}
+		for( size_t q = 0; q < vorder.size(); ++q ) {
+			int j = vorder[q];
+			if( m_vEdge[j] >= 0 ) {
+				set_path( k, j, m_vEdge[j] );
+			}
+			m_vState[j] = 0;
+		}
 
-		// update m_vp
-		for( j = 0; j < m_nSize; j++ )
-			if( m_vPred[m_nSize *k+j] >= 0 ) {
-				m_vp[ m_nSize*m_vPred[m_nSize*k+j] + j]++;
+		// update counts of the edges taken
+		for( int j = 0; j < n; j++ ) {
+			if( m_vEdge[j] >= 0 ) {
+				++m_vInUse[m_vEdge[j]];
 			}
+		}
 	}
 
 	/** return the ith shortest path to node nt.
@@ -204,7 +273,7 @@ public:
 			return m_wInfty;
 		}
 
-		lp = m_vPath[ m_nSize*nk+nt];
+		m_Paths.get( m_vPath[ m_nSize*nk+nt], lp );
 		return m_vDist[ m_nSize*nk+nt];
 	}
 
@@ -219,7 +288,7 @@ public:
 			return false;    // failed to allocate additional memory
 		}
 
-		m_vPath.resize( m_nSize*( newk + 1 ) );
+		m_vPath.resize( m_nSize*( newk + 1 ), -1 );
 		if(( int )m_vPath.size() < m_nSize*( newk + 1 ) ) {
 			return false;
 		}
@@ -233,6 +302,113 @@ public:
 		return true;
 	}
 
+private:
+	// in-edges of all nodes, by source index, self loops left out
+	void build_in_edges( void ) {
+		int n = m_nSize, i;
+		typename GV::const_e_iterator ite, iend;
+		m_vInOff.assign( n + 1, 0 );
+		for( i = 0; i < n; ++i ) {
+			iend = GV::e_end( m_gra, i );
+			for( ite = GV::e_begin( m_gra, i ); ite != iend; ++ite ) {
+				if( GV::to( ite ) != i ) {
+					++m_vInOff[GV::to( ite ) + 1];
+				}
+			}
+		}
+		for( i = 0; i < n; ++i ) {
+			m_vInOff[i + 1] += m_vInOff[i];
+		}
+		m_vInSrc.resize( m_vInOff[n] );
+		m_vInW.resize( m_vInOff[n] );
+		m_vInUse.assign( m_vInOff[n], 0 );
+		std::vector<int> vpos( m_vInOff.begin(), m_vInOff.end() - 1 );
+		for( i = 0; i < n; ++i ) {
+			iend = GV::e_end( m_gra, i );
+			for( ite = GV::e_begin( m_gra, i ); ite != iend; ++ite ) {
+				int j = GV::to( ite );
+				if( j != i ) {
+					int e = vpos[j]++;
+					m_vInSrc[e] = i;
+					m_vInW[e] = f_Weight( &( GV::edge_d( ite ) ) );
+				}
+			}
+		}
+		m_vEdge.assign( n, -1 );
+		m_vState.assign( n, 0 );
+		m_vSame.assign( m_Pool.size(), std::vector< std::pair<int, int> >() );
+		m_Heap.reset( n );
+	}
+
+	// the in-edge (i->j) of least weight (the one dijkstra( ) takes)
+	int find_in_edge( int i, int j ) const {
+		int best = -1;
+		for( int e = m_vInOff[j]; e < m_vInOff[j + 1]; ++e ) {
+			if( m_vInSrc[e] == i && ( best < 0 || m_vInW[e] < m_vInW[best] ) ) {
+				best = e;
+			}
+		}
+		return best;
+	}
+
+	// Dijkstra search over the in-edges whose next path is the kth one,
+	// from the distances found by the others; nodes settled in order
+	// into vorder (marked in m_vState)
+	void settle_same( int k, std::vector<int> &vorder ) {
+		int n = m_nSize;
+		std::vector< std::pair<int, int> > vsame;
+		for( size_t t = 0; t < m_vSame.size(); ++t ) {
+			vsame.insert( vsame.end(), m_vSame[t].begin(), m_vSame[t].end() );
+		}
+		if( vsame.empty() ) {
+			return;
+		}
+		// by source
+		std::vector< std::pair<int, int> > vout;
+		for( size_t q = 0; q < vsame.size(); ++q ) {
+			int e = vsame[q].first;
+			vout.push_back( std::make_pair( m_vInSrc[e], ( int )q ) );
+		}
+		std::sort( vout.begin(), vout.end() );
+		WT *pd = &m_vDist[n * k];
+		for( size_t q = 0; q < vsame.size(); ++q ) {
+			int i = m_vInSrc[vsame[q].first];
+			if( m_vState[i] == 0 && pd[i] < m_wInfty ) {
+				m_vState[i] = 1;
+				m_Heap.push( i, pd[i] );
+			}
+		}
+		while( !m_Heap.empty() ) {
+			int u = m_Heap.top();
+			m_Heap.pop();
+			m_vState[u] = 2;
+			vorder.push_back( u );
+			std::vector< std::pair<int, int> >::const_iterator it =
+				std::lower_bound( vout.begin(), vout.end(), std::make_pair( u, -1 ) );
+			for( ; it != vout.end() && it->first == u; ++it ) {
+				int e = vsame[it->second].first, j = vsame[it->second].second;
+				if( m_vState[j] == 2 ) {
+					continue;
+				}
+				WT d = pd[u] + m_vInW[e];
+				int b = m_vEdge[j];
+				if( d < pd[j] || ( d == pd[j] && b >= 0 && u < m_vInSrc[b] ) ) {
+					pd[j] = d;
+					m_vEdge[j] = e;
+					m_vState[j] = 1;
+					m_Heap.push( j, d );
+				}
+			}
+		}
+	}
+
+	// kth path to j by in-edge e
+	void set_path( int k, int j, int e ) {
+		int i = m_vInSrc[e], n = m_nSize;
+		int k2 = m_vInUse[e] + 1;
+		m_vPred[n * k + j] = i;
+		m_vPath[n * k + j] = m_Paths.extend( m_vPath[n * k2 + i], j );
+	}
 };
 
 /**@}*/
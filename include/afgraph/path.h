@@ -152,6 +152,80 @@ public:
 
 };
 
+/** paths sharing their prefixes, kept in one array.
+    Each path is a record of the path it extends (its prefix) and its
+    last node, added in O(1) time and memory by extend( ) and known by
+    its id (index); many paths which extend each other, such as the k
+    shortest paths of CkthSP, take 8 bytes each instead of a list of
+    all their nodes. get( ) puts a path together as a CPath, O(length).
+    Ids stay valid until clear( ).
+*/
+class CPathStore
+{
+protected:
+	struct record {
+		int prefix;
+		int node;
+	};
+	std::vector<record> m_vRec;
+
+public:
+	CPathStore()
+	{}
+
+	/// number of paths
+	int size( void ) const {
+		return ( int )m_vRec.size();
+	}
+
+	/// remove all paths
+	void clear( void ) {
+		m_vRec.clear();
+	}
+
+	/// make room for n paths in all
+	void reserve( int n ) {
+		m_vRec.reserve( n );
+	}
+
+	/** add path nprefix followed by node i (the path of node i only if
+	    nprefix is -1).
+	    @return id of the new path
+	*/
+	int extend( int nprefix, int i ) {
+		record r = { nprefix, i };
+		m_vRec.push_back( r );
+		return ( int )m_vRec.size() - 1;
+	}
+
+	/// add a copy of lp, -1 if lp is empty
+	int add( const CPath &lp ) {
+		int id = -1;
+		for( CPath::const_iterator it = lp.begin(); it != lp.end(); ++it ) {
+			id = extend( id, *it );
+		}
+		return id;
+	}
+
+	/// the path path id extends, -1 if none
+	int prefix( int id ) const {
+		return m_vRec[id].prefix;
+	}
+
+	/// the last node of path id
+	int last( int id ) const {
+		return m_vRec[id].node;
+	}
+
+	/// put path id together into lp, empty if id is -1
+	void get( int id, CPath &lp ) const {
+		lp.clear();
+		for( ; id >= 0; id = m_vRec[id].prefix ) {
+			lp.push_front( m_vRec[id].node );
+		}
+	}
+};
+
 /**@name path related utility functions */
 
 //@{
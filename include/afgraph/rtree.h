@@ -47,9 +47,14 @@ namespace afg
 
 /** rooted tree.
     Tree structure that has a specific root.
+    Template parameters are those of CGraph; with an arena allocator
+    (afl/arena.hpp) many short-lived trees, e.g. shortest path trees,
+    are built without a heap allocation per node and edge.
 */
-template < class VDT, class EDT, class f_eqv = std::equal_to<VDT> >
-class CrTree: public CGraph<VDT, EDT, f_eqv>
+template < class VDT, class EDT, class f_eqv = std::equal_to<VDT>,
+		 class f_hash = no_hash, class EdgeC = elist_policy,
+		 class A = std::allocator<char> >
+class CrTree: public CGraph<VDT, EDT, f_eqv, f_hash, EdgeC, A>
 {
 protected:
 	int m_nRoot;
@@ -58,27 +63,22 @@ protected:
 public:
 	/// constructor.
 	CrTree( int size = 1, VDT v = VDT(), double dg = 0.25,
-			const f_eqv &eqv = f_eqv() )
-		: CGraph<VDT, EDT, f_eqv>( size, v, dg, eqv ),
+			const f_eqv &eqv = f_eqv(), const A &a = A() )
+		: CGraph<VDT, EDT, f_eqv, f_hash, EdgeC, A>( size, v, dg, eqv, a ),
 		  m_nRoot( -1 ), m_Parents( size, -1 )
 	{ }
 
 	/// tree type, this class itself
-	typedef CrTree<VDT, EDT, f_eqv> TT;
-	typedef CGraph<VDT, EDT, f_eqv> base_graph_t;
+	typedef CrTree<VDT, EDT, f_eqv, f_hash, EdgeC, A> TT;
+	typedef CGraph<VDT, EDT, f_eqv, f_hash, EdgeC, A> base_graph_t;
 
-	CrTree( const TT &rhs ): CGraph<VDT, EDT, f_eqv>( rhs ),
+	CrTree( const TT &rhs ): CGraph<VDT, EDT, f_eqv, f_hash, EdgeC, A>( rhs ),
 		m_Parents( rhs.m_Parents )
 	{ }
 
 	const TT &operator=( const TT &rhs ) {
 		if( this != &rhs ) {
-			base_graph_t::m_eqv = rhs.m_eqv;
-			base_graph_t::m_Vertices = rhs.m_Vertices;
-			base_graph_t::m_vDefault = rhs.m_vDefault;
-			base_graph_t::m_nSize = rhs.m_nSize;
-			base_graph_t::m_dGrow = rhs.m_dGrow;
-			base_graph_t::m_iUnused = rhs.m_iUnused;
+			base_graph_t::operator=( rhs );
 			m_Parents = rhs.m_Parents;
 		}
 		return *this;
@@ -93,9 +93,17 @@ public:
 		}
 	}
 
+	/// copy all vertices from a graph of another type (e.g., CcsrGraph)
+	template<class GraphT>
+	typename std::enable_if < !std::is_base_of<base_graph_t, GraphT>::value >::type
+	copy_vertices( const GraphT &gra ) {
+		base_graph_t::copy_vertices( gra );
+		m_Parents.assign( gra.range(), -1 );
+	}
+
 	/// return parent node of node v
 	int parent( const VDT &v ) const {
-		int i = find_index( v );
+		int i = this->find_index( v );
 		if( i >= 0 ) {
 			return m_Parents[i];
 		}
@@ -125,7 +133,7 @@ public:
 
 	/// set the root node
 	bool set_root( const VDT &v ) {
-		int n = find_index( v );
+		int n = this->find_index( v );
 		if( n < 0 ) {
 			return false;
 		}
@@ -201,28 +209,30 @@ public:
 	  @return number of index changes that have been made.
 	*/
 	virtual int pack( int ns = 0 ) {
-		VDT vroot;
-		bool broot = false;
-		if( base_graph_t::is_in_range( m_nRoot ) && base_graph_t::is_in_use( m_nRoot ) ) {
-			broot = true;
-			vroot = base_graph_t::at( m_nRoot ).vertex_d();
-		}
-		int nch = base_graph_t::pack(); // number of index changes
-		//cout<<"before updating parent:\n"<<*this<<endl;
-		m_Parents.resize( base_graph_t::range(), -1 );
+		return pack( ns, NULL );
+	}
+
+	/** rearrange vertices to make them stored consecutively, O(V+E).
+	  See CGraph::pack( ns, remap ); parents and root are remapped as well.
+	*/
+	virtual int pack( int ns, std::vector<int> *remap ) {
+		std::vector<int> vlocal;
+		std::vector<int> &vmap = ( remap != NULL ) ? *remap : vlocal;
+		int nch = base_graph_t::pack( ns, &vmap ); // number of index changes
 		if( nch > 0 ) {
 			// only need to update parents if some index has been changed
-			typename base_graph_t::const_e_iterator it;
-			for( int i = 0; i < base_graph_t::size(); ++i )
-				for( it = base_graph_t::e_begin( i ); it != base_graph_t::e_end( i ); ++it ) {
-					//cout<<it->to()<<", "<<m_Parents[it->to()]<<", "<<i<<endl;
-					m_Parents[it->to()] = i;
+			std::vector<int> vpar( base_graph_t::range(), -1 );
+			for( int j = 0; j < ( int )vmap.size(); ++j ) {
+				if( vmap[j] >= 0 && m_Parents[j] >= 0 ) {
+					vpar[vmap[j]] = vmap[m_Parents[j]];
 				}
-			if( broot ) {
-				m_nRoot = find_index( vroot );
-				m_Parents[m_nRoot] = -1;
-				//cout<<"root: "<<m_nRoot<<", "<<m_Parents[m_nRoot]<<endl;
 			}
+			m_Parents.swap( vpar );
+			if( m_nRoot >= 0 && m_nRoot < ( int )vmap.size() ) {
+				m_nRoot = vmap[m_nRoot];
+			}
+		} else {
+			m_Parents.resize( base_graph_t::range(), -1 );
 		}
 		return nch;
 	}
@@ -273,11 +283,11 @@ public:
 						   const EDT &e ) {
 		// find the indices of both nodes, then insert the corresponding edge,
 		// if both nodes are found
-		int i = find_index( u );
+		int i = this->find_index( u );
 		if( i >= 0 ) {
-			int j = find_index( v );
+			int j = this->find_index( v );
 			if( j >= 0 ) {
-				base_graph_t::m_Vertices[i].insert_edge( j, e );
+				base_graph_t::link( i, j, e );
 				m_Parents[j] = i;
 				//cout<<"tree insert_e: "<<i<<"->"<<j<<endl;
 				return true;
@@ -354,6 +364,9 @@ private: // the following member functions are disabled in tree
 	{ }
 	virtual void remove_2e_byi( int n1, int n2 )
 	{ }
+	// bulk loads skip insert_e_byi( ) and would leave parents unset
+	using base_graph_t::assign_edges;
+	using base_graph_t::insert_edges;
 
 protected:
 	// grow the graph size by a certain percentage
@@ -64,23 +64,35 @@ The tree is "full-blown", having all the vertices and all vertex
 @param f_weight function to retrieve the weight(distance) of an edge,
   an edge pointer will be passed.
 @param w_infty a weight that is large enough to be considered infinity.
-@return true is successful, false if any exception happens when it
-  calls dijkstra() to compute the shortest paths from the source.
+@param ws workspace for dijkstra( ), see CSPWorkspace
+@return true is successful, false if ns is not a valid node or any
+  exception happens when it calls dijkstra() to compute the shortest
+  paths from the source.
 */
 template< class GraphT, class TreeT, class Fun >
 bool sptree_all( const GraphT &gra, int ns, TreeT &tree,
-				 Fun f_weight, typename Fun::result_type w_infty )
+				 Fun f_weight, typename Fun::result_type w_infty,
+				 CSPWorkspace<typename Fun::result_type> &ws )
 {
-	std::vector<int> vpred( gra.range() );
-	typedef typename Fun::result_type REST;
-	std::vector<REST> vdist( gra.range() );
 	try {
-		dijkstra<GraphT >( gra, ns, f_weight, w_infty,
-						   vpred, vdist );
+		if( !dijkstra( gra, ns, f_weight, w_infty, ws ) ) {
+			return false;
+		}
 	} catch( ... ) {
 		return false;
 	}
-	return pred2tree< GraphT, TreeT >( gra, vpred, tree );
+	return pred2tree< GraphT, TreeT >( gra, ws.pred(), tree );
+}
+
+/** build a single-source shortest-path tree.
+@see sptree_all
+*/
+template< class GraphT, class TreeT, class Fun >
+bool sptree_all( const GraphT &gra, int ns, TreeT &tree,
+				 Fun f_weight, typename Fun::result_type w_infty )
+{
+	CSPWorkspace<typename Fun::result_type> ws;
+	return sptree_all( gra, ns, tree, f_weight, w_infty, ws );
 }
 
 /** build a single-source shortest-path tree for a subset of nodes.
@@ -94,25 +106,37 @@ template< class GraphT, class TreeT, class Fun >
 bool sptree( const GraphT &gra, int ns, TreeT &tree,
 			 const std::set
 			 <int>& smem,
-			 Fun f_weight, typename Fun::result_type w_infty )
+			 Fun f_weight, typename Fun::result_type w_infty,
+			 CSPWorkspace<typename Fun::result_type> &ws )
 {
-	std::vector<int> vpred( gra.range() );
-	typedef typename Fun::result_type REST;
-	std::vector<REST> vdist( gra.range() );
 	try {
-		dijkstra<GraphT>( gra, ns, f_weight, w_infty,
-						  vpred, vdist );
+		if( !dijkstra( gra, ns, f_weight, w_infty, ws ) ) {
+			return false;
+		}
 	} catch( ... ) {
 		return false;
 	}
 
-	if( pred2tree< GraphT, TreeT >( gra, vpred, tree ) ) {
+	if( pred2tree< GraphT, TreeT >( gra, ws.pred(), tree ) ) {
 		prune_tree( tree, smem );
 		return true;
 	}
 	return false;
 }
 
+/** build a single-source shortest-path tree for a subset of nodes.
+@see sptree
+*/
+template< class GraphT, class TreeT, class Fun >
+bool sptree( const GraphT &gra, int ns, TreeT &tree,
+			 const std::set
+			 <int>& smem,
+			 Fun f_weight, typename Fun::result_type w_infty )
+{
+	CSPWorkspace<typename Fun::result_type> ws;
+	return sptree( gra, ns, tree, smem, f_weight, w_infty, ws );
+}
+
 /** build a "simple" single-source shortest-path tree.
 The tree has integer vertecies (their indices in the original graph)
   and a single weight edge.
@@ -120,18 +144,28 @@ The tree has integer vertecies (their indices in the original graph)
 */
 template< class GraphT, class TreeT, class Fun >
 bool sptree_all_s( const GraphT &gra, int ns, TreeT &tree,
-				   Fun f_weight, typename Fun::result_type w_infty )
+				   Fun f_weight, typename Fun::result_type w_infty,
+				   CSPWorkspace<typename Fun::result_type> &ws )
 {
-	std::vector<int> vpred( gra.range() );
-	typedef typename Fun::result_type REST;
-	std::vector<REST> vdist( gra.range() );
 	try {
-		dijkstra<GraphT >( gra, ns, f_weight, w_infty,
-						   vpred, vdist );
+		if( !dijkstra( gra, ns, f_weight, w_infty, ws ) ) {
+			return false;
+		}
 	} catch( ... ) {
 		return false;
 	}
-	return pred2tree_s< TreeT >( vpred, vdist, tree );
+	return pred2tree_s< TreeT >( ws.pred(), ws.dist(), tree );
+}
+
+/** build a "simple" single-source shortest-path tree.
+@see sptree_all_s
+*/
+template< class GraphT, class TreeT, class Fun >
+bool sptree_all_s( const GraphT &gra, int ns, TreeT &tree,
+				   Fun f_weight, typename Fun::result_type w_infty )
+{
+	CSPWorkspace<typename Fun::result_type> ws;
+	return sptree_all_s( gra, ns, tree, f_weight, w_infty, ws );
 }
 
 /** build a "simple" single-source shortest-path tree
@@ -144,25 +178,38 @@ template< class GraphT, class TreeT, class Fun >
 bool sptree_s( const GraphT &gra, int ns, TreeT &tree,
 			   const std::set
 			   <int>& smem,
-			   Fun f_weight, typename Fun::result_type w_infty )
+			   Fun f_weight, typename Fun::result_type w_infty,
+			   CSPWorkspace<typename Fun::result_type> &ws )
 {
-	std::vector<int> vpred( gra.range() );
-	typedef typename Fun::result_type REST;
-	std::vector<REST> vdist( gra.range() );
 	try {
-		dijkstra<GraphT >( gra, ns, f_weight, w_infty,
-						   vpred, vdist );
+		if( !dijkstra( gra, ns, f_weight, w_infty, ws ) ) {
+			return false;
+		}
 	} catch( ... ) {
 		return false;
 	}
 
-	if( pred2tree_s< TreeT >( vpred, vdist, tree ) ) {
+	if( pred2tree_s< TreeT >( ws.pred(), ws.dist(), tree ) ) {
 		prune_tree( tree, smem );
 		return true;
 	}
 	return false;
 }
 
+/** build a "simple" single-source shortest-path tree
+    for a subset of nodes.
+@see sptree_s
+*/
+template< class GraphT, class TreeT, class Fun >
+bool sptree_s( const GraphT &gra, int ns, TreeT &tree,
+			   const std::set
+			   <int>& smem,
+			   Fun f_weight, typename Fun::result_type w_infty )
+{
+	CSPWorkspace<typename Fun::result_type> ws;
+	return sptree_s( gra, ns, tree, smem, f_weight, w_infty, ws );
+}
+
 /**@}*/
 
 /**@defgroup spantree spanning tree algorithms
@@ -0,0 +1,1006 @@
+/*@copyright
+
+Copyright (c) 2012 Aiguo Fei
+All rights reserved.
+
+Permission to use and re-distribute this code in source and binary forms
+with or without modifications is therefore granted provided that
+the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Information regarding where to obtain the original source code must be
+      included with the redistrbution.
+
+*NO WARRANTY*
+THIS CODE OR PROGRAM IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S)
+"AS IS" WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE. THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S) MUST NOT BE
+HELD RESPONSIBLE FOR ANY DAMAGE OR UNDESIRED EFFECT CAUSED DIRECTLY OR
+INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
+
+*/
+
+
+
+
+/**@file ugraph.h
+
+  Undirected graph storing each link once.
+
+  A CGraph represents an undirected link (u, v) by two directed edges
+  (u->v) and (v->u), each with its own copy of the edge data, and
+  insert_2e( )/remove_2e( ) have to update both adjacency lists.
+  CuGraph keeps one record (CuLink) per link in a flat array, and each
+  vertex only a list of link ids. Iterating the edges of a vertex yields
+  CuEdge handles with the same to( )/edge_d( ) access as CiEdge, so the
+  algorithms written for CGraph run on a CuGraph unchanged; through
+  vertex i, a link (i, j) is seen as an edge to j, and through j as an
+  edge to i, both referring to the same edge data.
+
+*/
+
+#ifndef _AFG_UGRAPH_H_
+#define _AFG_UGRAPH_H_
+
+#include <string>
+#include <iostream>
+#include <vector>
+#include <functional>
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <cstddef>
+#include <type_traits>
+
+#include "afl/slot_bitmap.hpp"
+#include "graph.h"
+
+namespace afg
+{
+
+/**@defgroup ugraph Undirected Graph
+@ingroup graphd
+*/
+/**@{*/
+
+/** a link of a CuGraph: its two end vertices (indices) and edge data.
+*/
+template<class EdgeDT>
+struct CuLink {
+	/// type of the edge data
+	typedef EdgeDT EDT;
+
+	/// one end (index)
+	int u;
+	/// the other end (index)
+	int v;
+	/// edge data, shared by both directions
+	EdgeDT edge;
+
+	CuLink( int i = -1, int j = -1, const EdgeDT &e = EdgeDT() )
+		: u( i ), v( j ), edge( e )
+	{ }
+
+	/// return the end which is not i
+	int other( int i ) const {
+		return ( u == i ) ? v : u;
+	}
+};
+
+/** edge of a CuGraph seen from one of its ends.
+    LinkT is CuLink<EDT> or const CuLink<EDT>.
+*/
+template<class LinkT>
+class CuEdge
+{
+	template<class LT> friend class cu_e_iterator;
+
+public:
+	/// type of the edge data
+	typedef typename LinkT::EDT EDT;
+
+protected:
+	LinkT *m_pLink;
+	int m_nFrom;
+
+public:
+	/// constructor
+	CuEdge( LinkT *pl = NULL, int nfrom = -1 )
+		: m_pLink( pl ), m_nFrom( nfrom )
+	{ }
+
+	/// return destination node (index): the other end of the link
+	int to( void ) const {
+		return m_pLink->other( m_nFrom );
+	}
+
+	/// return reference of edge data
+	typename std::conditional < std::is_const<LinkT>::value,
+			 const EDT &, EDT & >::type edge_d( void ) const {
+		return m_pLink->edge;
+	}
+
+	/// output the edge in format of "edge_index: edge_data"
+	std::ostream &output( std::ostream &os ) const {
+		os << to( ) << ": " << edge_d( );
+		return os;
+	}
+};
+
+/// conventional output operator for CuEdge
+template<class LinkT>
+inline std::ostream &operator<<( std::ostream &os, const CuEdge<LinkT>& edge )
+{
+	return edge.output( os );
+}
+
+/** iterator over the edges of a vertex in a CuGraph.
+    Walks the link ids of the vertex; dereferencing gives a CuEdge.
+*/
+template<class LinkT>
+class cu_e_iterator
+{
+protected:
+	const int *m_pId;
+	LinkT *m_pLinks;
+	mutable CuEdge<LinkT> m_Edge;
+
+public:
+	typedef std::forward_iterator_tag iterator_category;
+	typedef CuEdge<LinkT> value_type;
+	typedef std::ptrdiff_t difference_type;
+	typedef const CuEdge<LinkT>* pointer;
+	typedef const CuEdge<LinkT>& reference;
+
+	/// constructor
+	cu_e_iterator( const int *pid = NULL, LinkT *plinks = NULL, int nfrom = -1 )
+		: m_pId( pid ), m_pLinks( plinks ), m_Edge( NULL, nfrom )
+	{ }
+
+	/// conversion from a mutable iterator to a const one
+	template<class LT>
+	cu_e_iterator( const cu_e_iterator<LT> &rhs,
+				   typename std::enable_if < std::is_convertible < LT *,
+				   LinkT * >::value >::type * = 0 )
+		: m_pId( rhs.id_ptr() ), m_pLinks( rhs.links_ptr() ),
+		  m_Edge( NULL, rhs.from() )
+	{ }
+
+	reference operator*() const {
+		m_Edge.m_pLink = m_pLinks + *m_pId;
+		return m_Edge;
+	}
+
+	pointer operator->() const {
+		return &( **this );
+	}
+
+	cu_e_iterator &operator++() {
+		++m_pId;
+		return *this;
+	}
+
+	cu_e_iterator operator++( int ) {
+		cu_e_iterator tmp( *this );
+		++m_pId;
+		return tmp;
+	}
+
+	bool operator==( const cu_e_iterator &rhs ) const {
+		return m_pId == rhs.m_pId;
+	}
+
+	bool operator!=( const cu_e_iterator &rhs ) const {
+		return m_pId != rhs.m_pId;
+	}
+
+	/**@name access for conversion */
+	//@{
+	const int *id_ptr( void ) const {
+		return m_pId;
+	}
+	LinkT *links_ptr( void ) const {
+		return m_pLinks;
+	}
+	int from( void ) const {
+		return m_Edge.m_nFrom;
+	}
+	//@}
+};
+
+/** vertex of a CuGraph.
+    Returned by value from CuGraph::operator[ ]; it only refers to the
+    storage of the graph and is valid until the graph is changed.
+    VertexDT and LinkT are const qualified for a const graph.
+*/
+template<class VertexDT, class LinkT>
+class CuVertex
+{
+public:
+	/// edge data type
+	typedef typename LinkT::EDT EDT;
+	/// vertex data type
+	typedef typename std::remove_const<VertexDT>::type VDT;
+	/// edge type
+	typedef CuEdge<LinkT> iET;
+
+	/// iterator type to access edges
+	typedef cu_e_iterator<LinkT> iterator;
+	/// const iterator type to access edges
+	typedef cu_e_iterator<const CuLink<EDT> > const_iterator;
+
+protected:
+	VertexDT *m_pVertexD;
+	const std::vector<int> *m_pIds;
+	LinkT *m_pLinks;
+	int m_nIndex;
+
+public:
+	/// constructor
+	CuVertex( VertexDT *pv, const std::vector<int> *pids, LinkT *plinks, int i )
+		: m_pVertexD( pv ), m_pIds( pids ), m_pLinks( plinks ), m_nIndex( i )
+	{ }
+
+	/// return a reference of the vertex data
+	VertexDT &vertex_d( void ) const {
+		return *m_pVertexD;
+	}
+
+	/// return iterator pointing to the first edge
+	iterator begin( void ) const {
+		return iterator( id_begin(), m_pLinks, m_nIndex );
+	}
+
+	/// return iterator pointing to the end (not pointting to any endge).
+	iterator end( void ) const {
+		return iterator( id_begin() + m_pIds->size(), m_pLinks, m_nIndex );
+	}
+
+	/** get an edge of this vertex
+	    @param nto destination node (index)
+	    @return a pointer to the edge data, NULL if edge doesn't exist
+	*/
+	typename std::conditional < std::is_const<LinkT>::value,
+			 const EDT *, EDT * >::type get_edge( int nto ) const {
+		for( size_t k = 0; k < m_pIds->size(); ++k ) {
+			LinkT &l = m_pLinks[( *m_pIds )[k]];
+			if( l.other( m_nIndex ) == nto ) {
+				return &l.edge;
+			}
+		}
+		return NULL;
+	}
+
+	/// return the out degree (number of links) of this vertex
+	int out_degree( void ) const {
+		return ( int )m_pIds->size();
+	}
+
+	/// output the vertex in the same format as IVertex
+	std::ostream &output( std::ostream &os ) const {
+		os << vertex_d( ) << "-> ";
+		for( iterator it = begin(); it != end(); ++it ) {
+			if( it != begin() ) {
+				os << ", ";
+			}
+			os << *it;
+		}
+		return os;
+	}
+
+protected:
+	const int *id_begin( void ) const {
+		return m_pIds->empty() ? NULL : &( *m_pIds )[0];
+	}
+};
+
+/// conventional output operator for CuVertex
+template<class VertexDT, class LinkT>
+inline std::ostream &operator<<( std::ostream &os,
+								 const CuVertex<VertexDT, LinkT>& rhs )
+{
+	return rhs.output( os );
+}
+
+/** Undirected graph, each link stored once.
+  Vertices are managed as in CGraph: indices of removed vertices are
+  reused lowest first, pack( ) makes them consecutive, and an optional
+  hash index (f_hash) makes find_index( ) expected O(1).
+
+  Links are kept in one array of CuLink, [0, n_links()-1 ], in no
+  particular order; link( k ) gives direct access, e.g. to update all
+  weights in one pass. Each vertex keeps the ids of its links in
+  insertion order. A self loop (i, i) appears once among the edges of i.
+
+  insert_2e( )/remove_2e( ) and friends work on links. Since a link has
+  no direction, insert_e( )/remove_e( ) are the same as their *_2e
+  counterparts, so code written for a CGraph holding a symmetric graph
+  (e.g. the graph_input.h readers, which give each link in both
+  directions) builds the same CuGraph.
+
+  Changing links invalidates edge iterators and vertex views; removing
+  a link moves the last link into its place.
+
+  @see CGraph
+*/
+template < class VertexDT, class EdgeDT,
+		 class f_eqv = std::equal_to<VertexDT>,
+		 class f_hash = no_hash >
+class CuGraph
+{
+public:
+
+	/**@name type definitions.
+	*/
+	//@{
+
+	/// edge data type
+	typedef EdgeDT EDT;
+
+	/// vertex data type
+	typedef VertexDT VDT;
+
+	/// link type
+	typedef CuLink<EdgeDT> LT;
+
+	/// edge type
+	typedef CuEdge<const LT> iET;
+
+	/// vertex type, a light-weight view returned by value
+	typedef CuVertex<VertexDT, LT> iVT;
+
+	/// vertex type of a const graph
+	typedef CuVertex<const VertexDT, const LT> const_iVT;
+
+	/// graph type, this class itself
+	typedef CuGraph<VertexDT, EdgeDT, f_eqv, f_hash> GT;
+
+	/// type compare function object to determine if two vertex data are equal
+	typedef f_eqv COMPT;
+
+	/// hash function object type for vertex data
+	typedef f_hash HASHT;
+
+	/// edge iterator, edge data can be changed through it
+	typedef cu_e_iterator<LT> e_iterator;
+
+	/// edge iterator, const
+	typedef cu_e_iterator<const LT> const_e_iterator;
+
+	//@}
+
+protected:
+
+	/**@name data members */
+	//@{
+	/// vertex data, one per index; unused indices hold m_vDefault
+	std::vector<VertexDT> m_Vertices;
+
+	/// link ids of each vertex
+	std::vector< std::vector<int> > m_vAdj;
+
+	/// all links
+	std::vector<LT> m_Links;
+
+	/// default vertex value
+	VertexDT m_vDefault;
+
+	/// number of vertices
+	int m_nSize;
+
+	/// growth factor of the vertex table, as in CGraph
+	double m_dGrow;
+
+	/// unused indices
+	afl::slot_bitmap m_sUnused;
+
+	/// index from vertex data to index, empty if f_hash is no_hash
+	CvIndex<VertexDT, f_hash, f_eqv> m_vIndex;
+
+	/// predicate to determine if two vertex data are equivalent
+	f_eqv m_eqv;
+	//@}
+
+public:
+	/** constructor, parameters are as for CGraph.
+	@param size initial capacity of the vertex table.
+	@param v default vertex value.
+	@param dg growth factor of the vertex table.
+	@param eqv predicate to determine if two vertices are equivalent.
+	*/
+	CuGraph( int size = 1, const VertexDT &v = VertexDT(), double dg = 0.25,
+			 const f_eqv &eqv = f_eqv() )
+		: m_Vertices( size, v ), m_vAdj( size ), m_vDefault( v ), m_nSize( 0 ),
+		  m_dGrow( dg ), m_sUnused( size ), m_vIndex( eqv ), m_eqv( eqv )
+	{ }
+
+	/**@name element access and helpers*/
+	//@{
+
+	/// return the default vertex value
+	const VDT &v_default( void ) const {
+		return m_vDefault;
+	}
+
+	/** return vertex at position i.
+	    Behavior is undefined if i is out of range.
+	*/
+	iVT operator[]( int i ) {
+		return iVT( &m_Vertices[i], &m_vAdj[i], links_ptr(), i );
+	}
+
+	/// return vertex at position i, const version
+	const_iVT operator[]( int i ) const {
+		return const_iVT( &m_Vertices[i], &m_vAdj[i], links_ptr(), i );
+	}
+
+	/** return vertex at position i
+	    @exception std::out_of_range.
+	*/
+	iVT at( int i ) {
+		if( !is_in_range( i ) ) {
+			throw std::out_of_range( std::string( "at( ) of CuGraph" ) );
+		}
+		return ( *this )[i];
+	}
+
+	/** return vertex at position i, const version
+	    @exception std::out_of_range.
+	*/
+	const_iVT at( int i ) const {
+		if( !is_in_range( i ) ) {
+			throw std::out_of_range( std::string( "at( ) of CuGraph" ) );
+		}
+		return ( *this )[i];
+	}
+
+	/// return vertex data at position i
+	VDT &vertex_d( int i ) {
+		return m_Vertices[i];
+	}
+
+	/// return vertex data at position i, const version
+	const VDT &vertex_d( int i ) const {
+		return m_Vertices[i];
+	}
+
+	/// return iterator pointing to the first edge of vertex i
+	e_iterator e_begin( int i ) {
+		return e_iterator( id_begin( i ), links_ptr(), i );
+	}
+
+	/// return iterator pointing to the end of edges of vertex i
+	e_iterator e_end( int i ) {
+		return e_iterator( id_begin( i ) + m_vAdj[i].size(), links_ptr(), i );
+	}
+
+	/// return iterator pointing to the first edge of vertex i, const version
+	const_e_iterator e_begin( int i ) const {
+		return const_e_iterator( id_begin( i ), links_ptr(), i );
+	}
+
+	/// return iterator pointing to the end of edges of vertex i, const version
+	const_e_iterator e_end( int i ) const {
+		return const_e_iterator( id_begin( i ) + m_vAdj[i].size(), links_ptr(), i );
+	}
+
+	/// return degree of vertex i
+	int out_degree( int i ) const {
+		return ( int )m_vAdj[i].size();
+	}
+
+	/// return the number of links
+	int n_links( void ) const {
+		return ( int )m_Links.size();
+	}
+
+	/// return link k, k within [0, n_links()-1 ]
+	LT &link( int k ) {
+		return m_Links[k];
+	}
+
+	/// return link k, const version
+	const LT &link( int k ) const {
+		return m_Links[k];
+	}
+
+	/** Get edge data of link (u, v).
+	   @return a pointer to that edge (data), NULL if not found.
+	*/
+	EDT *get_edge( const VDT &u, const VDT &v ) {
+		int k = find_link( find_index( u ), find_index( v ) );
+		return ( k >= 0 ) ? &m_Links[k].edge : NULL;
+	}
+
+	/// get edge data of link (u, v), const version
+	const EDT *get_edge( const VDT &u, const VDT &v ) const {
+		int k = find_link( find_index( u ), find_index( v ) );
+		return ( k >= 0 ) ? &m_Links[k].edge : NULL;
+	}
+
+	/** get edge data of link (i, j) by index.
+	    @return a pointer to that edge (data), NULL if not found.
+	*/
+	EDT *get_edge_byi( int i, int j ) {
+		int k = find_link( i, j );
+		return ( k >= 0 ) ? &m_Links[k].edge : NULL;
+	}
+
+	/// get edge data of link (i, j) by index, const version
+	const EDT *get_edge_byi( int i, int j ) const {
+		int k = find_link( i, j );
+		return ( k >= 0 ) ? &m_Links[k].edge : NULL;
+	}
+
+	/** return the id of link (i, j), -1 if not found.
+	    Searches the links of the end with the smaller degree.
+	*/
+	int find_link( int i, int j ) const {
+		if( !is_valid( i ) || !is_valid( j ) ) {
+			return -1;
+		}
+		if( m_vAdj[j].size() < m_vAdj[i].size() ) {
+			std::swap( i, j );
+		}
+		const std::vector<int> &va = m_vAdj[i];
+		for( size_t k = 0; k < va.size(); ++k ) {
+			if( m_Links[va[k]].other( i ) == j ) {
+				return va[k];
+			}
+		}
+		return -1;
+	}
+
+	/// find the index of vertex v, -1 if not found
+	int find_index( const VDT &v ) const {
+		if( m_vIndex.enabled ) {
+			return m_vIndex.find( v );
+		}
+		for( int i = 0; i < range(); ++i ) {
+			if( is_in_use( i ) && m_eqv( v, m_Vertices[i] ) ) {
+				return i;
+			}
+		}
+		return -1;
+	}
+
+	/// return graph size: number of vertices in the graph
+	int size( void ) const {
+		return m_nSize;
+	}
+
+	/** return upper bound on vertex index range.
+	    Vertex index will be within [0, range()-1 ].
+	*/
+	int range( void ) const {
+		return ( int )m_Vertices.size();
+	}
+
+	/// return if i is within [0, range()-1 ]
+	bool is_in_range( int i ) const {
+		return ( i >= 0 && i < range() );
+	}
+
+	/// return if i is an index used for a vertex (true if out of range)
+	bool is_in_use( int i ) const {
+		return !is_in_range( i ) || !m_sUnused.is_free( i );
+	}
+
+	/// return if i is a valid index: within range and used for a vertex
+	bool is_valid( int i ) const {
+		return is_in_range( i ) && !m_sUnused.is_free( i );
+	}
+
+	//@}
+
+	/// reserve space for at least n vertices
+	void reserve( int n ) {
+		if( n > range() ) {
+			m_Vertices.resize( n, m_vDefault );
+			m_vAdj.resize( n );
+			m_sUnused.resize( n );
+		}
+	}
+
+	/** rearrange vertices to make them stored consecutively, O(V+E).
+	  As CGraph::pack( ns, remap ).
+	  @param ns new capacity; if ns<size( ), size() will be used.
+	  @param remap pointer to receive the old-to-new index table, or NULL.
+	  @return number of index changes that have been made.
+	*/
+	int pack( int ns = 0, std::vector<int> *remap = NULL ) {
+		if( ns < m_nSize ) {
+			ns = m_nSize;
+		}
+		std::vector<int> vlocal;
+		std::vector<int> &vmap = ( remap != NULL ) ? *remap : vlocal;
+		int nold = range(), i, j;
+		vmap.assign( nold, -1 );
+		int nretn = 0;
+		for( i = 0, j = 0; j < nold; ++j ) {
+			if( is_valid( j ) ) {
+				if( i != j ) {
+					m_Vertices[i] = m_Vertices[j];
+					m_vAdj[i].swap( m_vAdj[j] );
+					++nretn;
+				}
+				vmap[j] = i++;
+			}
+		}
+		if( nretn > 0 ) {
+			for( size_t k = 0; k < m_Links.size(); ++k ) {
+				m_Links[k].u = vmap[m_Links[k].u];
+				m_Links[k].v = vmap[m_Links[k].v];
+			}
+		}
+		for( i = m_nSize; i < nold; ++i ) {
+			m_Vertices[i] = m_vDefault;
+			m_vAdj[i].clear();
+		}
+		m_Vertices.resize( ns, m_vDefault );
+		m_vAdj.resize( ns );
+		m_sUnused.assign( ns, m_nSize );
+		if( nretn > 0 ) {
+			rebuild_index();
+		}
+		return nretn;
+	}
+
+	/**@name insertion/deletion */
+	//@{
+
+	/** insert a vertex quickly without checking if it exists.
+	    @return index of the vertex.
+	*/
+	int insert_v_qik( const VDT &v ) {
+		if( m_sUnused.empty() ) {
+			grow();
+		}
+		int i = m_sUnused.acquire();
+		m_Vertices[i] = v;
+		++m_nSize;
+		m_vIndex.insert( v, i );
+		return i;
+	}
+
+	/** insert a vertex of value v.
+	    Vertex data is updated if vertex (v) already exists.
+	    @return index of the vertex.
+	*/
+	int insert_v( const VDT &v ) {
+		int vi = find_index( v );
+		if( vi >= 0 ) {
+			m_Vertices[vi] = v;
+			return vi;
+		}
+		return insert_v_qik( v );
+	}
+
+	/** insert a vertex of value v at position i, as CGraph::insert_v_ati( ).
+	    Links of an existing vertex at i are kept.
+	*/
+	bool insert_v_ati( const VDT &v, int i ) {
+		if( i < 0 ) {
+			return false;
+		}
+		if( i >= range() ) {
+			grow( i + 1 );
+		}
+		if( m_sUnused.is_free( i ) ) {
+			m_sUnused.set_used( i );
+			++m_nSize;
+		} else {
+			m_vIndex.erase( m_Vertices[i], i );
+		}
+		m_Vertices[i] = v;
+		m_vIndex.insert( v, i );
+		return true;
+	}
+
+	/// remove vertex v and all its links
+	void remove_v( const VDT &v ) {
+		remove_v_byi( find_index( v ) );
+	}
+
+	/// remove vertex of index vi and all its links, O(degree)
+	void remove_v_byi( int vi ) {
+		if( is_valid( vi ) ) {
+			remove_alle_byi( vi );
+			m_vIndex.erase( m_Vertices[vi], vi );
+			m_Vertices[vi] = m_vDefault;
+			--m_nSize;
+			m_sUnused.set_free( vi );
+		}
+	}
+
+	/** insert link (i, j) with edge data e, or replace edge data if
+	    the link exists.
+	    @return true if succeeds, false if any vertex is not found.
+	*/
+	bool insert_2e_byi( int i, int j, const EDT &e ) {
+		if( !is_valid( i ) || !is_valid( j ) ) {
+			return false;
+		}
+		int k = find_link( i, j );
+		if( k >= 0 ) {
+			m_Links[k].edge = e;
+		} else {
+			add_link( i, j, e );
+		}
+		return true;
+	}
+
+	/// insert link (u, v), see insert_2e_byi( )
+	bool insert_2e( const VDT &u, const VDT &v, const EDT &e ) {
+		return insert_2e_byi( find_index( u ), find_index( v ), e );
+	}
+
+	/// the same as insert_2e_byi( ): links have no direction
+	bool insert_e_byi( int i, int j, const EDT &e ) {
+		return insert_2e_byi( i, j, e );
+	}
+
+	/// the same as insert_2e( ): links have no direction
+	bool insert_e( const VDT &u, const VDT &v, const EDT &e ) {
+		return insert_2e( u, v, e );
+	}
+
+	/// remove link (i, j), no effect if it doesn't exist
+	void remove_2e_byi( int i, int j ) {
+		int k = find_link( i, j );
+		if( k >= 0 ) {
+			remove_link( k );
+		}
+	}
+
+	/// remove link (u, v)
+	void remove_2e( const VDT &u, const VDT &v ) {
+		remove_2e_byi( find_index( u ), find_index( v ) );
+	}
+
+	/// the same as remove_2e_byi( )
+	void remove_e_byi( int i, int j ) {
+		remove_2e_byi( i, j );
+	}
+
+	/// the same as remove_2e( )
+	void remove_e( const VDT &u, const VDT &v ) {
+		remove_2e( u, v );
+	}
+
+	/// remove all links of vertex i
+	void remove_alle_byi( int i ) {
+		if( is_valid( i ) ) {
+			while( !m_vAdj[i].empty() ) {
+				remove_link( m_vAdj[i].back() );
+			}
+		}
+	}
+
+	/// remove all links of vertex u
+	void remove_alle( const VDT &u ) {
+		remove_alle_byi( find_index( u ) );
+	}
+
+	/// remove all links
+	void remove_all_edges( void ) {
+		m_Links.clear();
+		for( size_t i = 0; i < m_vAdj.size(); ++i ) {
+			m_vAdj[i].clear();
+		}
+	}
+
+	/// clear all vertices and links
+	void clear( void ) {
+		remove_all_edges();
+		m_nSize = 0;
+		m_sUnused.assign( range() );
+		m_vIndex.clear();
+		std::fill( m_Vertices.begin(), m_Vertices.end(), m_vDefault );
+	}
+
+	/** replace all links by those in [first, last), in O(V+E).
+	  As CGraph::assign_edges( ), with (from, to) and (to, from) being the
+	  same link: dp is applied to every repeat of a link, whichever the
+	  direction. Links are grouped by their smaller end, in increasing
+	  order, and only within a group kept in order of first occurrence;
+	  each is stored as (smaller end, larger end). Link order, and so the
+	  order of edge iteration and which of equal paths is taken, does not
+	  follow the input order.
+	  @return number of links in the graph
+	*/
+	template<class FwdIt, class DupPolicy>
+	int assign_edges( FwdIt first, FwdIt last, DupPolicy dp ) {
+		remove_all_edges();
+		int n = range();
+		// bucket tuples by their smaller end
+		std::vector<int> vstart( n + 1, 0 );
+		FwdIt it;
+		for( it = first; it != last; ++it ) {
+			if( is_valid(( *it ).from ) && is_valid(( *it ).to ) ) {
+				++vstart[std::min(( *it ).from, ( *it ).to ) + 1];
+			}
+		}
+		int i, k;
+		for( i = 0; i < n; ++i ) {
+			vstart[i + 1] += vstart[i];
+		}
+		std::vector<const CeTuple<EDT>*> vbkt( vstart[n] );
+		std::vector<int> vnext( vstart.begin(), vstart.end() - 1 );
+		for( it = first; it != last; ++it ) {
+			if( is_valid(( *it ).from ) && is_valid(( *it ).to ) ) {
+				vbkt[vnext[std::min(( *it ).from, ( *it ).to )]++] = &( *it );
+			}
+		}
+		// in order of first occurrence within each bucket
+		std::vector<int> vstamp( n, -1 ), vslot( n );
+		for( i = 0; i < n; ++i ) {
+			for( k = vstart[i]; k < vstart[i + 1]; ++k ) {
+				const CeTuple<EDT> &t = *vbkt[k];
+				int j = std::max( t.from, t.to );
+				if( vstamp[j] != i ) {
+					vstamp[j] = i;
+					vslot[j] = ( int )m_Links.size();
+					m_Links.push_back( LT( i, j, t.edge ) );
+				} else {
+					dp( m_Links[vslot[j]].edge, t.edge );
+				}
+			}
+		}
+		std::vector<LT>( m_Links ).swap( m_Links ); // no spare capacity
+		// link ids of each vertex, each list allocated once
+		std::vector<int> &vdeg = vnext;
+		vdeg.assign( n, 0 );
+		for( k = 0; k < ( int )m_Links.size(); ++k ) {
+			++vdeg[m_Links[k].u];
+			if( m_Links[k].v != m_Links[k].u ) {
+				++vdeg[m_Links[k].v];
+			}
+		}
+		for( i = 0; i < n; ++i ) {
+			std::vector<int>().swap( m_vAdj[i] );
+			m_vAdj[i].reserve( vdeg[i] );
+		}
+		for( k = 0; k < ( int )m_Links.size(); ++k ) {
+			m_vAdj[m_Links[k].u].push_back( k );
+			if( m_Links[k].v != m_Links[k].u ) {
+				m_vAdj[m_Links[k].v].push_back( k );
+			}
+		}
+		return n_links();
+	}
+
+	/// assign_edges( ) with dup_keep_last
+	template<class FwdIt>
+	int assign_edges( FwdIt first, FwdIt last ) {
+		return assign_edges( first, last, dup_keep_last() );
+	}
+
+	/** add the links in [first, last) to those in the graph, as
+	  CGraph::insert_edges( ): assign_edges( ) over the present links
+	  followed by the tuples.
+	  @return number of links in the graph
+	*/
+	template<class FwdIt, class DupPolicy>
+	int insert_edges( FwdIt first, FwdIt last, DupPolicy dp ) {
+		if( m_Links.empty() ) {
+			return assign_edges( first, last, dp );
+		}
+		std::vector< CeTuple<EDT> > vt;
+		vt.reserve( m_Links.size() );
+		for( size_t k = 0; k < m_Links.size(); ++k ) {
+			vt.push_back( CeTuple<EDT>( m_Links[k].u, m_Links[k].v, m_Links[k].edge ) );
+		}
+		vt.insert( vt.end(), first, last );
+		return assign_edges( vt.begin(), vt.end(), dp );
+	}
+
+	/// insert_edges( ) with dup_keep_last
+	template<class FwdIt>
+	int insert_edges( FwdIt first, FwdIt last ) {
+		return insert_edges( first, last, dup_keep_last() );
+	}
+
+	//@}
+
+	/// output graph to a stream, in the same format as IGraph
+	std::ostream &output( std::ostream &os ) const {
+		for( int i = 0; i < range( ); ++i ) {
+			if( is_in_use( i ) ) {
+				os << '(' << i << ')' << ( *this )[i] << std::endl;
+			}
+		}
+		return os;
+	}
+
+protected:
+	LT *links_ptr( void ) {
+		return m_Links.empty() ? NULL : &m_Links[0];
+	}
+
+	const LT *links_ptr( void ) const {
+		return m_Links.empty() ? NULL : &m_Links[0];
+	}
+
+	const int *id_begin( int i ) const {
+		return m_vAdj[i].empty() ? NULL : &m_vAdj[i][0];
+	}
+
+	// grow the vertex table, as CGraph::grow( )
+	void grow( int ns = 0 ) {
+		int nold = range();
+		int n = ( int )( nold * ( 1 + m_dGrow ) );
+		n = ( n > nold ) ? n : nold + 1;
+		n = ( n > ns ) ? n : ns;
+		reserve( n );
+	}
+
+	// append a new link (i, j)
+	void add_link( int i, int j, const EDT &e ) {
+		int k = ( int )m_Links.size();
+		m_Links.push_back( LT( i, j, e ) );
+		m_vAdj[i].push_back( k );
+		if( j != i ) {
+			m_vAdj[j].push_back( k );
+		}
+	}
+
+	// replace link id kold by knew in the links of vertex i
+	void replace_id( int i, int kold, int knew ) {
+		std::vector<int> &va = m_vAdj[i];
+		std::vector<int>::iterator it = std::find( va.begin(), va.end(), kold );
+		if( knew < 0 ) {
+			va.erase( it );
+		} else {
+			*it = knew;
+		}
+	}
+
+	// remove link k, the last link takes its id
+	void remove_link( int k ) {
+		LT &l = m_Links[k];
+		replace_id( l.u, k, -1 );
+		if( l.v != l.u ) {
+			replace_id( l.v, k, -1 );
+		}
+		int nlast = ( int )m_Links.size() - 1;
+		if( k != nlast ) {
+			LT &ll = m_Links[nlast];
+			replace_id( ll.u, nlast, k );
+			if( ll.v != ll.u ) {
+				replace_id( ll.v, nlast, k );
+			}
+			m_Links[k] = ll;
+		}
+		m_Links.pop_back();
+	}
+
+	// rebuild the hash index of vertex data
+	void rebuild_index( void ) {
+		m_vIndex.clear();
+		for( int i = 0; i < range(); ++i ) {
+			if( is_valid( i ) ) {
+				m_vIndex.insert( m_Vertices[i], i );
+			}
+		}
+	}
+};
+// end of CuGraph
+
+/// conventional output operator for CuGraph
+template<class VertexDT, class EdgeDT, class f_eqv, class f_hash>
+inline std::ostream &operator<<( std::ostream &os,
+								 const CuGraph<VertexDT, EdgeDT, f_eqv, f_hash>& rhs )
+{
+	return rhs.output( os );
+}
+
+/**@}*/
+
+}// end of namespace afg
+
+#endif
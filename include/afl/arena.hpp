@@ -0,0 +1,252 @@
+/*@copyright
+
+Copyright (c) 2000-2012 Aiguo Fei
+All rights reserved.
+
+Permission to use and re-distribute this code in source and binary forms
+with or without modifications is therefore granted provided that
+the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Information regarding where to obtain the original source code must be
+      included with the redistrbution.
+
+*NO WARRANTY*
+THIS CODE OR PROGRAM IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S)
+"AS IS" WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE. THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S) MUST NOT BE
+HELD RESPONSIBLE FOR ANY DAMAGE OR UNDESIRED EFFECT CAUSED DIRECTLY OR
+INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
+
+*/
+
+/**
+@file arena.hpp
+
+@author Aiguo Fei
+
+*/
+
+#ifndef _AFL_ARENA_H_
+#define _AFL_ARENA_H_
+
+#include <cstddef>
+#include <vector>
+#include <new>
+
+namespace afl
+{
+
+/** A monotonic memory arena.
+
+  Memory is handed out from large blocks by bumping a pointer; individual
+  deallocation does nothing. reset( ) makes all memory available again in
+  one shot (blocks are kept for reuse), release( ) gives the blocks back
+  to the heap. Nothing allocated from the arena may be used after reset( )
+  or release( ); objects are not destroyed by the arena, so containers
+  using it must be destroyed (or cleared) before that.
+
+  Not thread safe; use one arena per thread.
+*/
+class arena
+{
+protected:
+	struct block {
+		char *p;
+		std::size_t size;
+	};
+
+	// blocks, m_vBlocks[m_nCur] is being allocated from
+	std::vector<block> m_vBlocks;
+	std::size_t m_nCur;
+	// bump pointer and end of the current block
+	char *m_pPos;
+	char *m_pEnd;
+	// size of a new block
+	std::size_t m_nBlock;
+	// bytes handed out since the last reset( )
+	std::size_t m_nUsed;
+
+public:
+	/// constructor, bsize is the size of each block in bytes
+	explicit arena( std::size_t bsize = 64 * 1024 )
+		: m_nCur( 0 ), m_pPos( NULL ), m_pEnd( NULL ),
+		  m_nBlock( bsize ), m_nUsed( 0 )
+	{ }
+
+	~arena() {
+		release();
+	}
+
+	/** allocate n bytes aligned to align (a power of 2).
+	    Throws std::bad_alloc if the heap is exhausted.
+	*/
+	void *allocate( std::size_t n, std::size_t align = alignof( std::max_align_t ) ) {
+		char *p = align_up( m_pPos, align );
+		if( m_pPos == NULL || p + n > m_pEnd ) {
+			p = next_block( n, align );
+		}
+		m_pPos = p + n;
+		m_nUsed += n;
+		return p;
+	}
+
+	/// does nothing, memory is only returned by reset( ) or release( )
+	void deallocate( void *, std::size_t )
+	{ }
+
+	/// make all memory available again, keeping the blocks
+	void reset( void ) {
+		m_nCur = 0;
+		m_nUsed = 0;
+		if( m_vBlocks.empty() ) {
+			m_pPos = m_pEnd = NULL;
+		} else {
+			m_pPos = m_vBlocks[0].p;
+			m_pEnd = m_pPos + m_vBlocks[0].size;
+		}
+	}
+
+	/// give all blocks back to the heap
+	void release( void ) {
+		for( std::size_t i = 0; i < m_vBlocks.size(); ++i ) {
+			::operator delete( m_vBlocks[i].p );
+		}
+		m_vBlocks.clear();
+		m_nCur = 0;
+		m_nUsed = 0;
+		m_pPos = m_pEnd = NULL;
+	}
+
+	/// bytes handed out since the last reset( )
+	std::size_t used( void ) const {
+		return m_nUsed;
+	}
+
+	/// bytes held in blocks
+	std::size_t capacity( void ) const {
+		std::size_t n = 0;
+		for( std::size_t i = 0; i < m_vBlocks.size(); ++i ) {
+			n += m_vBlocks[i].size;
+		}
+		return n;
+	}
+
+	/// number of blocks held
+	std::size_t n_blocks( void ) const {
+		return m_vBlocks.size();
+	}
+
+protected:
+	static char *align_up( char *p, std::size_t align ) {
+		std::size_t u = reinterpret_cast<std::size_t>( p );
+		return reinterpret_cast<char *>(( u + align - 1 ) & ~( align - 1 ) );
+	}
+
+	// move on to the next block that can hold n bytes aligned to align;
+	// kept blocks too small for the request are skipped
+	char *next_block( std::size_t n, std::size_t align ) {
+		std::size_t i = m_pPos == NULL ? 0 : m_nCur + 1;
+		for( ; i < m_vBlocks.size(); ++i ) {
+			char *p = align_up( m_vBlocks[i].p, align );
+			if( p + n <= m_vBlocks[i].p + m_vBlocks[i].size ) {
+				set_current( i );
+				return p;
+			}
+		}
+		std::size_t sz = n + align > m_nBlock ? n + align : m_nBlock;
+		block b;
+		b.p = static_cast<char *>( ::operator new( sz ) );
+		b.size = sz;
+		m_vBlocks.push_back( b );
+		set_current( m_vBlocks.size() - 1 );
+		return align_up( b.p, align );
+	}
+
+	void set_current( std::size_t i ) {
+		m_nCur = i;
+		m_pPos = m_vBlocks[i].p;
+		m_pEnd = m_pPos + m_vBlocks[i].size;
+	}
+
+private:
+	// not copyable
+	arena( const arena & );
+	const arena &operator=( const arena & );
+};
+
+/** standard allocator drawing memory from an arena.
+
+  Copies (and rebound copies) share the arena. deallocate( ) is a no-op,
+  memory comes back with arena::reset( ). A default constructed
+  arena_allocator has no arena and uses the global operator new/delete,
+  so types requiring a default allocator still work.
+*/
+template<class T>
+class arena_allocator
+{
+public:
+	typedef T value_type;
+	typedef T *pointer;
+	typedef const T *const_pointer;
+	typedef T &reference;
+	typedef const T &const_reference;
+	typedef std::size_t size_type;
+	typedef std::ptrdiff_t difference_type;
+
+	template<class U> struct rebind {
+		typedef arena_allocator<U> other;
+	};
+
+protected:
+	arena *m_pArena;
+
+	template<class U> friend class arena_allocator;
+
+public:
+	/// constructor, memory from pa (global heap if NULL)
+	arena_allocator( arena *pa = NULL )
+		: m_pArena( pa )
+	{ }
+
+	template<class U>
+	arena_allocator( const arena_allocator<U> &rhs )
+		: m_pArena( rhs.m_pArena )
+	{ }
+
+	/// the arena, NULL if none
+	arena *get_arena( void ) const {
+		return m_pArena;
+	}
+
+	T *allocate( size_type n ) {
+		if( m_pArena == NULL ) {
+			return static_cast<T *>( ::operator new( n * sizeof( T ) ) );
+		}
+		return static_cast<T *>( m_pArena->allocate( n * sizeof( T ), alignof( T ) ) );
+	}
+
+	void deallocate( T *p, size_type ) {
+		if( m_pArena == NULL ) {
+			::operator delete( p );
+		}
+	}
+
+	template<class U>
+	bool operator==( const arena_allocator<U> &rhs ) const {
+		return m_pArena == rhs.m_pArena;
+	}
+
+	template<class U>
+	bool operator!=( const arena_allocator<U> &rhs ) const {
+		return m_pArena != rhs.m_pArena;
+	}
+};
+
+}// end of namespace afl
+
+#endif
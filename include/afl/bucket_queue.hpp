@@ -0,0 +1,329 @@
+/*@copyright
+
+Copyright (c) 2000-2012 Aiguo Fei
+All rights reserved.
+
+Permission to use and re-distribute this code in source and binary forms
+with or without modifications is therefore granted provided that
+the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Information regarding where to obtain the original source code must be
+      included with the redistrbution.
+
+*NO WARRANTY*
+THIS CODE OR PROGRAM IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S)
+"AS IS" WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE. THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S) MUST NOT BE
+HELD RESPONSIBLE FOR ANY DAMAGE OR UNDESIRED EFFECT CAUSED DIRECTLY OR
+INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
+
+*/
+
+/**
+@file bucket_queue.hpp
+
+@author Aiguo Fei
+
+*/
+
+#ifndef _AFL_BUCKET_QUEUE_H_
+#define _AFL_BUCKET_QUEUE_H_
+
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <stdexcept>
+
+namespace afl
+{
+
+/** monotone priority queues of ids [0, n-1] with non-negative integer keys.
+
+  Both are "monotone": a key pushed must not be smaller than the last key
+  taken out, as in Dijkstra's algorithm with non-negative edge weights;
+  push( ) throws std::out_of_range for a key out of range, as it could
+  not come out in order.
+  push( ) of an id already in the queue changes its key; the old entry is
+  left behind and dropped when it comes up (lazy deletion). empty( )
+  drops such entries, so it is not const, and must be called (and return
+  false) before top( ) and pop( ).
+
+  Among equal keys the id pushed last comes out first, as with
+  indexed_heap and sorted_list.
+*/
+//@{
+
+/** Dial's bucket queue: one bucket per key value, in a circular array.
+  Keys in the queue must be within [m, m+C], m the last key taken out and
+  C given to the constructor (e.g. the largest edge weight); push( ) and
+  pop( ) are O(1), finding the next key is O(C) at most.
+*/
+template<class KeyT>
+class dial_queue
+{
+protected:
+	std::vector< std::vector<int> > m_vBuckets;
+	// current key of each id, valid if m_vIn[id]
+	std::vector<KeyT> m_vKey;
+	std::vector<char> m_vIn;
+	// smallest key possibly in the queue
+	KeyT m_Cur;
+	// number of entries, including stale ones
+	int m_nCount;
+
+public:
+	/// constructor, ids within [0, n-1], keys within [m, m+c]
+	explicit dial_queue( int n = 0, KeyT c = 0 )
+		: m_vBuckets(( size_t )c + 1 ), m_vKey( n ), m_vIn( n, 0 ),
+		  m_Cur( 0 ), m_nCount( 0 )
+	{ }
+
+	/// empty the queue and take ids within [0, n-1], keys within [m, m+c]
+	void reset( int n, KeyT c ) {
+		clear();
+		m_vBuckets.resize(( size_t )c + 1 );
+		m_vKey.resize( n );
+		m_vIn.resize( n, 0 );
+	}
+
+	/// empty the queue, O(number of entries + c)
+	void clear( void ) {
+		for( size_t b = 0; b < m_vBuckets.size(); ++b ) {
+			std::vector<int> &vb = m_vBuckets[b];
+			for( size_t k = 0; k < vb.size(); ++k ) {
+				m_vIn[vb[k]] = 0;
+			}
+			vb.clear();
+		}
+		m_Cur = 0;
+		m_nCount = 0;
+	}
+
+	/** insert id with key k, or change its key to k.
+	  @exception std::out_of_range if k is not within [m, m+c].
+	*/
+	void push( int id, KeyT k ) {
+		if( k < m_Cur || !( k - m_Cur < ( KeyT )m_vBuckets.size() ) ) {
+			throw std::out_of_range( std::string( "key out of range in dial_queue" ) );
+		}
+		m_vKey[id] = k;
+		m_vIn[id] = 1;
+		m_vBuckets[bucket( k )].push_back( id );
+		++m_nCount;
+	}
+
+	/// if there is no (valid) entry, drops stale entries on the way
+	bool empty( void ) {
+		while( m_nCount > 0 ) {
+			std::vector<int> &b = m_vBuckets[bucket( m_Cur )];
+			if( b.empty() ) {
+				++m_Cur;
+				continue;
+			}
+			int id = b.back();
+			if( m_vIn[id] && m_vKey[id] == m_Cur ) {
+				return false;
+			}
+			b.pop_back();
+			--m_nCount;
+		}
+		return true;
+	}
+
+	/// id with the smallest key
+	int top( void ) const {
+		return m_vBuckets[bucket( m_Cur )].back();
+	}
+
+	/// the smallest key
+	KeyT top_key( void ) const {
+		return m_Cur;
+	}
+
+	/// remove the id with the smallest key
+	void pop( void ) {
+		std::vector<int> &b = m_vBuckets[bucket( m_Cur )];
+		m_vIn[b.back()] = 0;
+		b.pop_back();
+		--m_nCount;
+	}
+
+protected:
+	size_t bucket( KeyT k ) const {
+		return ( size_t )( k % ( KeyT )m_vBuckets.size() );
+	}
+};
+
+/** radix heap: a bucket for each bit position of the keys.
+  Key k is kept in the bucket of the highest bit where it differs from
+  the last key taken out; a bucket is split into lower ones when it
+  becomes the first non-empty one. push( ) is O(1), pop( ) amortized
+  O(number of bits), for any range of keys.
+*/
+template<class KeyT>
+class radix_heap
+{
+protected:
+	typedef unsigned long long ukey_t;
+	enum { NBITS = 64 };
+
+	struct entry {
+		KeyT key;
+		// push order, for ties
+		unsigned int stamp;
+		int id;
+
+		bool operator<( const entry &rhs ) const {
+			return stamp < rhs.stamp;
+		}
+	};
+
+	// m_vBuckets[0] holds keys equal to m_Last, newest at the back
+	std::vector<entry> m_vBuckets[NBITS + 1];
+	std::vector<KeyT> m_vKey;
+	std::vector<char> m_vIn;
+	KeyT m_Last;
+	unsigned int m_nStamp;
+	int m_nCount;
+
+public:
+	/// constructor, ids within [0, n-1]
+	explicit radix_heap( int n = 0 )
+		: m_vKey( n ), m_vIn( n, 0 ), m_Last( 0 ), m_nStamp( 0 ), m_nCount( 0 )
+	{ }
+
+	/// empty the heap and take ids within [0, n-1]
+	void reset( int n ) {
+		clear();
+		m_vKey.resize( n );
+		m_vIn.resize( n, 0 );
+	}
+
+	/// empty the heap, O(number of entries)
+	void clear( void ) {
+		for( int b = 0; b <= NBITS; ++b ) {
+			std::vector<entry> &vb = m_vBuckets[b];
+			for( size_t k = 0; k < vb.size(); ++k ) {
+				m_vIn[vb[k].id] = 0;
+			}
+			vb.clear();
+		}
+		m_Last = 0;
+		m_nStamp = 0;
+		m_nCount = 0;
+	}
+
+	/** insert id with key k, or change its key to k.
+	  @exception std::out_of_range if k is smaller than the last key
+	    taken out.
+	*/
+	void push( int id, KeyT k ) {
+		if( k < m_Last ) {
+			throw std::out_of_range( std::string( "key out of range in radix_heap" ) );
+		}
+		m_vKey[id] = k;
+		m_vIn[id] = 1;
+		entry e;
+		e.key = k;
+		e.stamp = ++m_nStamp;
+		e.id = id;
+		m_vBuckets[bucket( k )].push_back( e );
+		++m_nCount;
+	}
+
+	/// if there is no (valid) entry, drops stale entries on the way
+	bool empty( void ) {
+		std::vector<entry> &b0 = m_vBuckets[0];
+		while( m_nCount > 0 ) {
+			while( !b0.empty() && !valid( b0.back() ) ) {
+				b0.pop_back();
+				--m_nCount;
+			}
+			if( !b0.empty() ) {
+				return false;
+			}
+			if( m_nCount > 0 ) {
+				split();
+			}
+		}
+		return true;
+	}
+
+	/// id with the smallest key
+	int top( void ) const {
+		return m_vBuckets[0].back().id;
+	}
+
+	/// the smallest key
+	KeyT top_key( void ) const {
+		return m_Last;
+	}
+
+	/// remove the id with the smallest key
+	void pop( void ) {
+		m_vIn[m_vBuckets[0].back().id] = 0;
+		m_vBuckets[0].pop_back();
+		--m_nCount;
+	}
+
+protected:
+	bool valid( const entry &e ) const {
+		return m_vIn[e.id] && m_vKey[e.id] == e.key;
+	}
+
+	int bucket( KeyT k ) const {
+		ukey_t x = ( ukey_t )k ^ ( ukey_t )m_Last;
+#if defined(__GNUC__)
+		return x ? NBITS - __builtin_clzll( x ) : 0;
+#else
+		int nb = 0;
+		while( x ) {
+			x >>= 1;
+			++nb;
+		}
+		return nb;
+#endif
+	}
+
+	// bucket 0 is empty: take the smallest key of the first non-empty
+	// bucket as the new m_Last and spread that bucket over lower ones
+	void split( void ) {
+		int i = 1;
+		while( m_vBuckets[i].empty() ) {
+			++i;
+		}
+		std::vector<entry> vb;
+		vb.swap( m_vBuckets[i] );
+		bool found = false;
+		for( size_t k = 0; k < vb.size(); ++k ) {
+			if( valid( vb[k] ) && ( !found || vb[k].key < m_Last ) ) {
+				m_Last = vb[k].key;
+				found = true;
+			}
+		}
+		for( size_t k = 0; k < vb.size(); ++k ) {
+			if( !found || !valid( vb[k] ) ) {
+				--m_nCount;
+			} else {
+				m_vBuckets[bucket( vb[k].key )].push_back( vb[k] );
+			}
+		}
+		// equal keys come out newest first
+		std::sort( m_vBuckets[0].begin(), m_vBuckets[0].end() );
+		// give the (largest) buffer back for reuse
+		vb.clear();
+		if( vb.capacity() > m_vBuckets[i].capacity() ) {
+			vb.swap( m_vBuckets[i] );
+		}
+	}
+};
+//@}
+
+}// end of namespace afl
+
+#endif
@@ -0,0 +1,209 @@
+/*@copyright
+
+Copyright (c) 2000-2012 Aiguo Fei
+All rights reserved.
+
+Permission to use and re-distribute this code in source and binary forms
+with or without modifications is therefore granted provided that
+the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Information regarding where to obtain the original source code must be
+      included with the redistrbution.
+
+*NO WARRANTY*
+THIS CODE OR PROGRAM IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S)
+"AS IS" WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE. THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S) MUST NOT BE
+HELD RESPONSIBLE FOR ANY DAMAGE OR UNDESIRED EFFECT CAUSED DIRECTLY OR
+INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
+
+*/
+
+/**
+@file indexed_heap.hpp
+
+@author Aiguo Fei
+
+*/
+
+#ifndef _AFL_INDEXED_HEAP_H_
+#define _AFL_INDEXED_HEAP_H_
+
+#include <vector>
+#include <functional>
+
+namespace afl
+{
+
+/** An indexed D-ary min-heap of ids [0, n-1] with keys.
+
+  Each id is in the heap at most once; push( ) of an id already in the
+  heap changes its key in place (decrease-key), so the heap never holds
+  more than n entries. push( ), pop( ) and a key change are O(log n)
+  (base D), top( ) and contains( ) are O(1).
+
+  Among equal keys the id pushed (or whose key was changed) last comes
+  out first, the same order as sorted_list::push( ) gives; algorithms
+  moved from a sorted_list to indexed_heap keep their results exactly.
+
+  @version 0.1, 2026
+*/
+template < class KeyT, int D = 4, class Compare = std::less<KeyT> >
+class indexed_heap
+{
+protected:
+	struct entry {
+		KeyT key;
+		// push order, for ties
+		unsigned int stamp;
+		int id;
+	};
+
+	std::vector<entry> m_vHeap;
+	// position of each id in m_vHeap, -1 if not in the heap
+	std::vector<int> m_vPos;
+	unsigned int m_nStamp;
+	Compare m_comp;
+
+public:
+	/// constructor, ids are within [0, n-1]
+	explicit indexed_heap( int n = 0, const Compare &comp = Compare() )
+		: m_vPos( n, -1 ), m_nStamp( 0 ), m_comp( comp )
+	{ }
+
+	/// empty the heap and take ids within [0, n-1]
+	void reset( int n ) {
+		clear();
+		m_vPos.resize( n, -1 );
+	}
+
+	/// empty the heap, O(size( ))
+	void clear( void ) {
+		for( size_t i = 0; i < m_vHeap.size(); ++i ) {
+			m_vPos[m_vHeap[i].id] = -1;
+		}
+		m_vHeap.clear();
+		m_nStamp = 0;
+	}
+
+	/// reserve room for n entries
+	void reserve( int n ) {
+		m_vHeap.reserve( n );
+	}
+
+	bool empty( void ) const {
+		return m_vHeap.empty();
+	}
+
+	int size( void ) const {
+		return ( int )m_vHeap.size();
+	}
+
+	/// if id is in the heap
+	bool contains( int id ) const {
+		return m_vPos[id] >= 0;
+	}
+
+	/// id with the smallest key
+	int top( void ) const {
+		return m_vHeap[0].id;
+	}
+
+	/// the smallest key
+	const KeyT &top_key( void ) const {
+		return m_vHeap[0].key;
+	}
+
+	/// key of an id in the heap
+	const KeyT &key( int id ) const {
+		return m_vHeap[m_vPos[id]].key;
+	}
+
+	/** insert id with key k, or change its key to k if it is in the heap.
+	*/
+	void push( int id, const KeyT &k ) {
+		entry e;
+		e.key = k;
+		e.stamp = ++m_nStamp;
+		e.id = id;
+		int i = m_vPos[id];
+		if( i < 0 ) {
+			i = ( int )m_vHeap.size();
+			m_vHeap.push_back( e );
+			sift_up( i, e );
+		} else if( before( e, m_vHeap[i] ) ) {
+			sift_up( i, e );
+		} else {
+			sift_down( i, e );
+		}
+	}
+
+	/// remove the id with the smallest key
+	void pop( void ) {
+		m_vPos[m_vHeap[0].id] = -1;
+		entry e = m_vHeap.back();
+		m_vHeap.pop_back();
+		if( !m_vHeap.empty() ) {
+			sift_down( 0, e );
+		}
+	}
+
+protected:
+	// a comes out before b
+	bool before( const entry &a, const entry &b ) const {
+		if( m_comp( a.key, b.key ) ) {
+			return true;
+		}
+		return !m_comp( b.key, a.key ) && a.stamp > b.stamp;
+	}
+
+	// put e at hole i or above
+	void sift_up( int i, const entry &e ) {
+		while( i > 0 ) {
+			int p = ( i - 1 ) / D;
+			if( !before( e, m_vHeap[p] ) ) {
+				break;
+			}
+			m_vHeap[i] = m_vHeap[p];
+			m_vPos[m_vHeap[i].id] = i;
+			i = p;
+		}
+		m_vHeap[i] = e;
+		m_vPos[e.id] = i;
+	}
+
+	// put e at hole i or below
+	void sift_down( int i, const entry &e ) {
+		int n = ( int )m_vHeap.size();
+		for( ;; ) {
+			int c = i * D + 1;
+			if( c >= n ) {
+				break;
+			}
+			int cend = c + D < n ? c + D : n;
+			int best = c;
+			for( ++c; c < cend; ++c ) {
+				if( before( m_vHeap[c], m_vHeap[best] ) ) {
+					best = c;
+				}
+			}
+			if( !before( m_vHeap[best], e ) ) {
+				break;
+			}
+			m_vHeap[i] = m_vHeap[best];
+			m_vPos[m_vHeap[i].id] = i;
+			i = best;
+		}
+		m_vHeap[i] = e;
+		m_vPos[e.id] = i;
+	}
+};
+
+}// end of namespace afl
+
+#endif
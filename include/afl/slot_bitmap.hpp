@@ -0,0 +1,230 @@
+/*@copyright
+
+Copyright (c) 2000-2012 Aiguo Fei
+All rights reserved.
+
+Permission to use and re-distribute this code in source and binary forms
+with or without modifications is therefore granted provided that
+the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Information regarding where to obtain the original source code must be
+      included with the redistrbution.
+
+*NO WARRANTY*
+THIS CODE OR PROGRAM IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S)
+"AS IS" WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE. THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S) MUST NOT BE
+HELD RESPONSIBLE FOR ANY DAMAGE OR UNDESIRED EFFECT CAUSED DIRECTLY OR
+INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
+
+*/
+
+/**
+@file slot_bitmap.hpp
+
+@author Aiguo Fei
+
+*/
+
+#ifndef _AFL_SLOT_BITMAP_H_
+#define _AFL_SLOT_BITMAP_H_
+
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace afl
+{
+
+/** index of the lowest set bit of a non-zero 64-bit word.
+*/
+inline int lowest_bit( unsigned long long w )
+{
+#if defined(__GNUC__)
+	return __builtin_ctzll( w );
+#elif defined(_MSC_VER) && defined(_WIN64)
+	unsigned long n;
+	_BitScanForward64( &n, w );
+	return ( int )n;
+#else
+	int n = 0;
+	while( !( w & 1ULL ) ) {
+		w >>= 1;
+		++n;
+	}
+	return n;
+#endif
+}
+
+/** A set of slots [0, size( )-1], each either free or used.
+
+  Kept as a bitmap (one bit per slot, 1 for free) plus a hint of the
+  lowest word that may have a free slot, so that is_free( ),
+  set_free( ) and set_used( ) are O(1), and first_free( )/acquire( ),
+  which always return the lowest free slot, are amortized O(1)
+  (a scan over 64 slots at a time, starting from the hint).
+
+  @version 0.1, 2026
+*/
+class slot_bitmap
+{
+	typedef unsigned long long word_type;
+
+	enum { WBITS = 64 };
+
+	std::vector<word_type> m_vWords;
+	int m_nSize;
+	int m_nFree;
+	// no free slot in words before this one
+	mutable int m_nHint;
+
+public:
+	/// constructor, n slots all free
+	explicit slot_bitmap( int n = 0 )
+		: m_nSize( 0 ), m_nFree( 0 ), m_nHint( 0 ) {
+		resize( n );
+	}
+
+	/// number of slots
+	int size( void ) const {
+		return m_nSize;
+	}
+
+	/// number of free slots
+	int n_free( void ) const {
+		return m_nFree;
+	}
+
+	/// true if there is no free slot
+	bool empty( void ) const {
+		return m_nFree == 0;
+	}
+
+	/// true if i is a free slot; false if used or out of range
+	bool is_free( int i ) const {
+		if( i < 0 || i >= m_nSize ) {
+			return false;
+		}
+		return ( m_vWords[i / WBITS] >> ( i % WBITS ) ) & 1ULL;
+	}
+
+	/** change the number of slots to n.
+	    Slots added are free, existing slots keep their state.
+	*/
+	void resize( int n ) {
+		if( n < m_nSize ) {
+			for( int i = n; i < m_nSize; ++i ) {
+				if( is_free( i ) ) {
+					--m_nFree;
+				}
+			}
+			m_vWords.resize(( n + WBITS - 1 ) / WBITS );
+			if( n % WBITS ) {
+				m_vWords.back() &= ( 1ULL << ( n % WBITS ) ) - 1;
+			}
+		} else if( n > m_nSize ) {
+			m_vWords.resize(( n + WBITS - 1 ) / WBITS, 0ULL );
+			for( int i = m_nSize; i < n; ) {
+				if( i % WBITS == 0 && n - i >= WBITS ) {
+					m_vWords[i / WBITS] = ~0ULL;
+					i += WBITS;
+				} else {
+					m_vWords[i / WBITS] |= 1ULL << ( i % WBITS );
+					++i;
+				}
+			}
+			m_nFree += n - m_nSize;
+			if( m_nHint > m_nSize / WBITS ) {
+				m_nHint = m_nSize / WBITS;
+			}
+		}
+		m_nSize = n;
+	}
+
+	/** make all n slots free, or, if nused>0, slots [0, nused-1] used
+	    and the rest free.
+	*/
+	void assign( int n, int nused = 0 ) {
+		m_vWords.clear();
+		m_nSize = 0;
+		m_nFree = 0;
+		m_nHint = 0;
+		resize( n );
+		for( int i = 0; i < nused && i < n; ++i ) {
+			set_used( i );
+		}
+	}
+
+	/// mark slot i as free, no effect if out of range or already free
+	void set_free( int i ) {
+		if( i < 0 || i >= m_nSize || is_free( i ) ) {
+			return;
+		}
+		m_vWords[i / WBITS] |= 1ULL << ( i % WBITS );
+		++m_nFree;
+		if( i / WBITS < m_nHint ) {
+			m_nHint = i / WBITS;
+		}
+	}
+
+	/// mark slot i as used, no effect if out of range or already used
+	void set_used( int i ) {
+		if( !is_free( i ) ) {
+			return;
+		}
+		m_vWords[i / WBITS] &= ~( 1ULL << ( i % WBITS ) );
+		--m_nFree;
+	}
+
+	/// return the lowest free slot, -1 if none
+	int first_free( void ) const {
+		if( m_nFree == 0 ) {
+			return -1;
+		}
+		int nw = ( int )m_vWords.size();
+		while( m_nHint < nw && m_vWords[m_nHint] == 0ULL ) {
+			++m_nHint;
+		}
+		return m_nHint * WBITS + lowest_bit( m_vWords[m_nHint] );
+	}
+
+	/// return the lowest free slot which is not less than i, -1 if none
+	int next_free( int i ) const {
+		if( i < 0 ) {
+			i = 0;
+		}
+		if( i >= m_nSize ) {
+			return -1;
+		}
+		int nw = ( int )m_vWords.size();
+		int k = i / WBITS;
+		word_type w = m_vWords[k] & ( ~0ULL << ( i % WBITS ) );
+		while( w == 0ULL ) {
+			if( ++k >= nw ) {
+				return -1;
+			}
+			w = m_vWords[k];
+		}
+		return k * WBITS + lowest_bit( w );
+	}
+
+	/// take the lowest free slot (mark it as used) and return it, -1 if none
+	int acquire( void ) {
+		int i = first_free();
+		if( i >= 0 ) {
+			set_used( i );
+		}
+		return i;
+	}
+};
+
+}// end of namespace afl
+
+#endif
@@ -0,0 +1,264 @@
+/*@copyright
+
+Copyright (c) 2000-2012 Aiguo Fei
+All rights reserved.
+
+Permission to use and re-distribute this code in source and binary forms
+with or without modifications is therefore granted provided that
+the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Information regarding where to obtain the original source code must be
+      included with the redistrbution.
+
+*NO WARRANTY*
+THIS CODE OR PROGRAM IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S)
+"AS IS" WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE. THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S) MUST NOT BE
+HELD RESPONSIBLE FOR ANY DAMAGE OR UNDESIRED EFFECT CAUSED DIRECTLY OR
+INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
+
+*/
+
+/**
+@file small_vector.hpp
+
+@author Aiguo Fei
+
+*/
+
+#ifndef _AFL_SMALL_VECTOR_H_
+#define _AFL_SMALL_VECTOR_H_
+
+#include <cstddef>
+#include <new>
+#include <memory>
+#include <algorithm>
+#include <type_traits>
+
+namespace afl
+{
+
+/** A vector with the first N elements stored inline.
+
+  small_vector keeps up to N elements in a buffer inside the object
+  itself, so a short sequence needs no heap allocation at all;
+  when it grows beyond N the elements are moved to the heap
+  (obtained from allocator A) and it behaves like std::vector.
+
+  Only the common sequence operations are provided: iteration
+  (iterators are plain pointers), push_back( ), pop_back( ), erase( ),
+  clear( ), reserve( ) and element access. As with std::vector, insertion
+  and erasure invalidate iterators.
+
+  @version 0.1, 2026
+*/
+template < class T, int N, class A = std::allocator<T> >
+class small_vector: protected A
+{
+public:
+	typedef T value_type;
+	typedef T &reference;
+	typedef const T &const_reference;
+	typedef T *pointer;
+	typedef const T *const_pointer;
+	typedef T *iterator;
+	typedef const T *const_iterator;
+	typedef std::size_t size_type;
+	typedef std::ptrdiff_t difference_type;
+	typedef A allocator_type;
+
+protected:
+	typedef typename std::aligned_storage < sizeof( T ),
+			std::alignment_of<T>::value >::type slot_type;
+
+	// the allocator is a (usually empty) base class, sizes are kept in
+	// 32 bits: the header is only a pointer plus two integers
+	T *m_pBegin;
+	unsigned int m_nSize;
+	unsigned int m_nCap;
+	slot_type m_Buf[N > 0 ? N : 1];
+
+public:
+	/// constructor, empty
+	explicit small_vector( const A &a = A() )
+		: A( a ), m_pBegin( inline_buf() ), m_nSize( 0 ), m_nCap( N )
+	{ }
+
+	small_vector( const small_vector &rhs )
+		: A( rhs.get_allocator() ), m_pBegin( inline_buf() ), m_nSize( 0 ), m_nCap( N ) {
+		reserve( rhs.m_nSize );
+		for( const_iterator it = rhs.begin(); it != rhs.end(); ++it ) {
+			push_back( *it );
+		}
+	}
+
+	const small_vector &operator=( const small_vector &rhs ) {
+		if( this != &rhs ) {
+			clear();
+			reserve( rhs.m_nSize );
+			for( const_iterator it = rhs.begin(); it != rhs.end(); ++it ) {
+				push_back( *it );
+			}
+		}
+		return *this;
+	}
+
+	~small_vector() {
+		clear();
+		release();
+	}
+
+	/**@name element access */
+	//@{
+	iterator begin( void ) {
+		return m_pBegin;
+	}
+	iterator end( void ) {
+		return m_pBegin + m_nSize;
+	}
+	const_iterator begin( void ) const {
+		return m_pBegin;
+	}
+	const_iterator end( void ) const {
+		return m_pBegin + m_nSize;
+	}
+	reference operator[]( size_type i ) {
+		return m_pBegin[i];
+	}
+	const_reference operator[]( size_type i ) const {
+		return m_pBegin[i];
+	}
+	reference front( void ) {
+		return m_pBegin[0];
+	}
+	const_reference front( void ) const {
+		return m_pBegin[0];
+	}
+	reference back( void ) {
+		return m_pBegin[m_nSize - 1];
+	}
+	const_reference back( void ) const {
+		return m_pBegin[m_nSize - 1];
+	}
+	//@}
+
+	/// number of elements
+	size_type size( void ) const {
+		return m_nSize;
+	}
+
+	/// true if there is no element
+	bool empty( void ) const {
+		return m_nSize == 0;
+	}
+
+	/// number of elements that can be held without reallocation
+	size_type capacity( void ) const {
+		return m_nCap;
+	}
+
+	/// true if elements are still kept in the inline buffer
+	bool is_inline( void ) const {
+		return m_pBegin == inline_buf();
+	}
+
+	/// return a copy of the allocator
+	allocator_type get_allocator( void ) const {
+		return static_cast<const A &>( *this );
+	}
+
+	/// make sure n elements can be held without reallocation
+	void reserve( size_type n ) {
+		if( n <= m_nCap ) {
+			return;
+		}
+		T *pnew = A::allocate( n );
+		size_type i = 0;
+		try {
+			for( ; i < m_nSize; ++i ) {
+				new( pnew + i ) T( m_pBegin[i] );
+			}
+		} catch( ... ) {
+			while( i > 0 ) {
+				pnew[--i].~T();
+			}
+			A::deallocate( pnew, n );
+			throw;
+		}
+		for( i = 0; i < m_nSize; ++i ) {
+			m_pBegin[i].~T();
+		}
+		release();
+		m_pBegin = pnew;
+		m_nCap = ( unsigned int )n;
+	}
+
+	/// append an element at the end
+	void push_back( const T &x ) {
+		if( m_nSize == m_nCap ) {
+			T tmp( x ); // x may refer to an element of this vector
+			reserve( m_nCap > 0 ? m_nCap * 2 : 4 );
+			new( m_pBegin + m_nSize ) T( tmp );
+		} else {
+			new( m_pBegin + m_nSize ) T( x );
+		}
+		++m_nSize;
+	}
+
+	/// remove the last element
+	void pop_back( void ) {
+		m_pBegin[--m_nSize].~T();
+	}
+
+	/** remove the element at position it.
+	    @return iterator pointing to the element after the removed one
+	*/
+	iterator erase( iterator it ) {
+		return erase( it, it + 1 );
+	}
+
+	/// remove elements within [first, last)
+	iterator erase( iterator first, iterator last ) {
+		iterator inew = std::copy( last, end(), first );
+		for( iterator it = inew; it != end(); ++it ) {
+			it->~T();
+		}
+		m_nSize -= ( last - first );
+		return first;
+	}
+
+	/// remove all elements, the heap buffer (if any) is kept
+	void clear( void ) {
+		for( size_type i = 0; i < m_nSize; ++i ) {
+			m_pBegin[i].~T();
+		}
+		m_nSize = 0;
+	}
+
+protected:
+	T *inline_buf( void ) {
+		return reinterpret_cast<T *>( m_Buf );
+	}
+
+	const T *inline_buf( void ) const {
+		return reinterpret_cast<const T *>( m_Buf );
+	}
+
+	// give back the heap buffer, if any; elements must have been destroyed
+	void release( void ) {
+		if( m_pBegin != inline_buf() ) {
+			A::deallocate( m_pBegin, m_nCap );
+			m_pBegin = inline_buf();
+			m_nCap = N;
+		}
+	}
+};
+
+}// end of namespace afl
+
+#endif
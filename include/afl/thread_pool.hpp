@@ -0,0 +1,186 @@
+/*@copyright
+
+Copyright (c) 2000-2012 Aiguo Fei
+All rights reserved.
+
+Permission to use and re-distribute this code in source and binary forms
+with or without modifications is therefore granted provided that
+the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Information regarding where to obtain the original source code must be
+      included with the redistrbution.
+
+*NO WARRANTY*
+THIS CODE OR PROGRAM IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S)
+"AS IS" WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE. THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S) MUST NOT BE
+HELD RESPONSIBLE FOR ANY DAMAGE OR UNDESIRED EFFECT CAUSED DIRECTLY OR
+INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
+
+*/
+
+/**
+@file thread_pool.hpp
+
+@author Aiguo Fei
+
+*/
+
+#ifndef _AFL_THREAD_POOL_H_
+#define _AFL_THREAD_POOL_H_
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <exception>
+
+namespace afl
+{
+
+/** A fixed set of threads for running loops in parallel.
+
+  parallel_for( n, fn ) calls fn( i, t ) for every i in [0, n), spread
+  over the threads, and returns when all calls are done; t is the number
+  of the thread making the call, within [0, size( )), so fn can keep
+  per-thread buffers in a vector indexed by t. The calling thread is
+  thread 0 and works too, so a pool of size 1 runs everything in the
+  caller with no extra thread. Iterations are handed out in chunks of
+  nchunk as threads become free, which balances uneven iterations.
+
+  If fn throws, the remaining chunks are skipped and the first exception
+  is thrown again by parallel_for( ). parallel_for( ) may be called from
+  one thread at a time, and not from within fn.
+  Programs using it link with -pthread.
+*/
+class thread_pool
+{
+protected:
+	std::vector<std::thread> m_vThreads;
+	std::mutex m_Mutex;
+	std::condition_variable m_cvWork, m_cvDone;
+	// the loop being run, called as m_Job( t ) by each thread
+	std::function<void( int )> m_Job;
+	// incremented for each loop, so a thread knows there is a new one
+	unsigned long m_nGen;
+	// threads still working on the current loop
+	int m_nBusy;
+	bool m_bStop;
+
+public:
+	/// constructor, nthreads 0 for std::thread::hardware_concurrency( )
+	explicit thread_pool( int nthreads = 0 )
+		: m_nGen( 0 ), m_nBusy( 0 ), m_bStop( false ) {
+		if( nthreads <= 0 ) {
+			nthreads = ( int )std::thread::hardware_concurrency();
+		}
+		for( int t = 1; t < nthreads; ++t ) {
+			m_vThreads.push_back( std::thread( &thread_pool::work, this, t ) );
+		}
+	}
+
+	~thread_pool() {
+		{
+			std::lock_guard<std::mutex> lk( m_Mutex );
+			m_bStop = true;
+		}
+		m_cvWork.notify_all();
+		for( size_t t = 0; t < m_vThreads.size(); ++t ) {
+			m_vThreads[t].join();
+		}
+	}
+
+	/// number of threads, including the calling one
+	int size( void ) const {
+		return ( int )m_vThreads.size() + 1;
+	}
+
+	/// call fn( i, t ) for i in [0, n), in chunks of nchunk
+	template<class F>
+	void parallel_for( int n, F fn, int nchunk = 1 ) {
+		if( nchunk < 1 ) {
+			nchunk = 1;
+		}
+		std::atomic<int> next( 0 );
+		std::exception_ptr perr;
+		std::mutex merr;
+		auto job = [&]( int t ) {
+			try {
+				int i0;
+				while(( i0 = next.fetch_add( nchunk ) ) < n ) {
+					int i1 = n - i0 < nchunk ? n : i0 + nchunk;
+					for( int i = i0; i < i1; ++i ) {
+						fn( i, t );
+					}
+				}
+			} catch( ... ) {
+				std::lock_guard<std::mutex> lk( merr );
+				if( !perr ) {
+					perr = std::current_exception();
+				}
+				next = n;
+			}
+		};
+
+		if( m_vThreads.empty() || n <= nchunk ) {
+			job( 0 );
+		} else {
+			{
+				std::lock_guard<std::mutex> lk( m_Mutex );
+				m_Job = job;
+				m_nBusy = ( int )m_vThreads.size();
+				++m_nGen;
+			}
+			m_cvWork.notify_all();
+			job( 0 );
+			std::unique_lock<std::mutex> lk( m_Mutex );
+			while( m_nBusy > 0 ) {
+				m_cvDone.wait( lk );
+			}
+			m_Job = std::function<void( int )>();
+		}
+		if( perr ) {
+			std::rethrow_exception( perr );
+		}
+	}
+
+protected:
+	// thread t: wait for a loop, take part in it, and so on
+	void work( int t ) {
+		unsigned long ngen = 0;
+		for( ;; ) {
+			std::function<void( int )> job;
+			{
+				std::unique_lock<std::mutex> lk( m_Mutex );
+				while( !m_bStop && m_nGen == ngen ) {
+					m_cvWork.wait( lk );
+				}
+				if( m_bStop ) {
+					return;
+				}
+				ngen = m_nGen;
+				job = m_Job;
+			}
+			job( t );
+			std::lock_guard<std::mutex> lk( m_Mutex );
+			if( --m_nBusy == 0 ) {
+				m_cvDone.notify_one();
+			}
+		}
+	}
+
+private:
+	thread_pool( const thread_pool & );
+	thread_pool &operator=( const thread_pool & );
+};
+
+}// end of namespace afl
+
+#endif
@@ -37,6 +37,9 @@ INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
 #include <iostream>
 
 #include <sstream>
+#include <vector>
+
+#include "afgraph/graph.h"
 
 namespace afg
 {
@@ -55,9 +58,13 @@ File format per line: as_index -> #_of_neighbors : a list of
 The imported graph will have vertex data of int type (AS index), each
   edge will have weight 1(type int). All links are assumed to
   be bi-directional.
+A link is usually listed by both of its ends, dp decides the edge data of
+  such duplicates and of links already in gra (see
+  CGraph::insert_edges( )); e.g. dup_combine with std::plus<int> counts
+  how many times a link is listed.
 */
-template< class GT>
-void import_asconnect( GT &gra, std::istream &is )
+template< class GT, class DupPolicy >
+void import_asconnect( GT &gra, std::istream &is, DupPolicy dp )
 {
 	std::string sbuf;
 	int node;
@@ -73,9 +80,11 @@ void import_asconnect( GT &gra, std::istream &is )
 
 	std::istringstream isall( sall );
 
+	typedef typename GT::EDT EDT;
+	std::vector< CeTuple<EDT> > vedges;
 	std::string sgarb;
 	char c;
-	int nt, n2;
+	int nt, n2, i, j;
 	while( isall && std::getline( isall, sbuf ) ) {
 
 		std::istringstream iste( sbuf );
@@ -86,9 +95,14 @@ void import_asconnect( GT &gra, std::istream &is )
 		while( c != ':' ) {
 			iste >> c;
 		}
+		i = gra.find_index( node );
 		while( iste ) {
 			iste >> n2;
-			gra.insert_2e( node, n2, 1 );
+			j = gra.find_index( n2 );
+			if( i >= 0 && j >= 0 ) {
+				vedges.push_back( CeTuple<EDT>( i, j, 1 ) );
+				vedges.push_back( CeTuple<EDT>( j, i, 1 ) );
+			}
 			if( iste ) {
 				iste >> c;
 			}
@@ -96,6 +110,14 @@ void import_asconnect( GT &gra, std::istream &is )
 		}
 		//cout<<endl;
 	}
+	gra.insert_edges( vedges.begin(), vedges.end(), dp );
+}
+
+/// import graph from an "asconnect" file, keeping the last of duplicates
+template< class GT>
+void import_asconnect( GT &gra, std::istream &is )
+{
+	import_asconnect( gra, is, dup_keep_last() );
 }
 
 /**@}*/
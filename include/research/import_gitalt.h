@@ -38,8 +38,10 @@ INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
 #include <cstring>
 
 #include <sstream>
+#include <vector>
 
 #include "afgraph/vertex.h"
+#include "afgraph/graph.h"
 
 /**@defgroup research Stuff for Research Work
 */
@@ -96,13 +98,19 @@ bool import_gitalt_ts( GT &gra, std::istream &is )
 					std::getline( is, sbuf );
 				}
 				int nfrom, nto, nleng, nweight;
+				typedef typename GT::EDT EDT;
+				std::vector< CeTuple<EDT> > vedges;
+				vedges.reserve( nedges );
 				for( i = 0; i < nedges / 2; ++i ) {
 					is >> nfrom >> nto >> nleng >> nweight;
 					//std::cout<<nfrom<<", "<<nto<<", "<<nweight<<std::endl;
-					if( !gra.insert_2e_byi( nfrom, nto, nweight ) ) {
+					if( !gra.is_valid( nfrom ) || !gra.is_valid( nto ) ) {
 						return false;
 					}
+					vedges.push_back( CeTuple<EDT>( nfrom, nto, nweight ) );
+					vedges.push_back( CeTuple<EDT>( nto, nfrom, nweight ) );
 				}
+				gra.insert_edges( vedges.begin(), vedges.end() );
 				return true;
 			}
 		}
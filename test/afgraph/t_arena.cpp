@@ -0,0 +1,170 @@
+/*@copyright
+
+Copyright (c) 2012 Aiguo Fei
+All rights reserved.
+
+Permission to use and re-distribute this code in source and binary forms
+with or without modifications is therefore granted provided that
+the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Information regarding where to obtain the original source code must be
+      included with the redistrbution.
+
+*NO WARRANTY*
+THIS CODE OR PROGRAM IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S)
+"AS IS" WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE. THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S) MUST NOT BE
+HELD RESPONSIBLE FOR ANY DAMAGE OR UNDESIRED EFFECT CAUSED DIRECTLY OR
+INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
+
+*/
+
+
+
+/* t_arena.cpp
+
+  test afl::arena and arena_allocator (afl/arena.hpp), and CGraph/CrTree
+  with an arena allocator: same results as with the default allocator.
+
+*/
+
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "afl/arena.hpp"
+#include "afl/util_tl.hpp"
+
+#include "afgraph/graph.h"
+#include "afgraph/rtree.h"
+#include "afgraph/vertex.h"
+#include "afgraph/graph_gen.h"
+#include "afgraph/tree_alg.h"
+
+using namespace std;
+using namespace afg;
+
+template<class GraphT>
+string to_str( const GraphT &g )
+{
+	ostringstream os;
+	os << g;
+	return os.str();
+}
+
+// same small graph in any CGraph
+template<class GraphT>
+void build( GraphT &g )
+{
+	for( int i = 0; i < 6; ++i ) {
+		g.insert_v( 'a' + i );
+	}
+	g.insert_e( 'a', 'b', 3 );
+	g.insert_e( 'a', 'c', 1 );
+	g.insert_e( 'c', 'b', 1 );
+	g.insert_e( 'b', 'd', 2 );
+	g.insert_e( 'c', 'e', 7 );
+	g.insert_e( 'd', 'e', 1 );
+	g.insert_e( 'e', 'f', 2 );
+	g.remove_e( 'c', 'e' );
+	g.remove_v( 'f' );
+}
+
+template<class EdgeC>
+void cmp_policy( const char *name, afl::arena &ar )
+{
+	typedef afl::arena_allocator<char> AT;
+	CGraph<char, int, std::equal_to<char>, no_hash, EdgeC> g0( 4, ' ' );
+	CGraph<char, int, std::equal_to<char>, no_hash, EdgeC, AT> g1( 4, ' ',
+			0.25, std::equal_to<char>(), AT( &ar ) );
+	build( g0 );
+	build( g1 );
+	cout << name << ": same " << ( to_str( g0 ) == to_str( g1 ) )
+		 << ", from arena " << ( g1.get_allocator().get_arena() == &ar )
+		 << ", arena used " << ( ar.used() > 0 ) << endl;
+}
+
+int main()
+{
+	afl::arena ar( 1024 );
+
+	cout << "raw arena:" << endl;
+	char *p1 = static_cast<char *>( ar.allocate( 3, 1 ) );
+	double *p2 = static_cast<double *>( ar.allocate( sizeof( double ), alignof( double ) ) );
+	cout << "  aligned " << ( reinterpret_cast<size_t>( p2 ) % alignof( double ) == 0 )
+		 << ", after " << ( static_cast<void *>( p2 ) > static_cast<void *>( p1 ) )
+		 << ", used " << ar.used() << ", blocks " << ar.n_blocks() << endl;
+	ar.allocate( 4000 );   // larger than a block
+	cout << "  big: blocks " << ar.n_blocks() << endl;
+	ar.reset();
+	char *p3 = static_cast<char *>( ar.allocate( 3, 1 ) );
+	cout << "  reset: used " << ar.used() << ", blocks " << ar.n_blocks()
+		 << ", reused " << ( p3 == p1 ) << endl;
+	ar.release();
+	cout << "  release: blocks " << ar.n_blocks() << ", capacity " << ar.capacity() << endl;
+
+	cout << "graph with arena allocator:" << endl;
+	cmp_policy<elist_policy>( "  elist", ar );
+	ar.reset();
+	cmp_policy<evector_policy>( "  evector", ar );
+	ar.reset();
+	cmp_policy< esmall_policy<1> >( "  esmall<1>", ar );
+	ar.reset();
+
+	typedef afl::arena_allocator<char> AT;
+	typedef CGraph<char, int, std::equal_to<char>, no_hash, elist_policy, AT> AGT;
+	{
+		afl::arena ar2;
+		AGT g1( 4, ' ', 0.25, std::equal_to<char>(), AT( &ar ) );
+		build( g1 );
+		AGT g2( g1 );
+		AGT g3( 1, ' ', 0.25, std::equal_to<char>(), AT( &ar2 ) );
+		g3 = g1;
+		cout << "  copy: same " << ( to_str( g2 ) == to_str( g1 ) )
+			 << ", shares arena " << ( g2.get_allocator() == g1.get_allocator() ) << endl;
+		cout << "  assign: same " << ( to_str( g3 ) == to_str( g1 ) )
+			 << ", keeps its arena " << ( g3.get_allocator().get_arena() == &ar2 )
+			 << ", arena used " << ( ar2.used() > 0 ) << endl;
+		g3.pack();
+		g3.insert_e( 'a', 'e', 9 );
+		cout << g3 << endl;
+	}
+	ar.reset();
+
+	// default arena_allocator: global heap
+	{
+		AGT g4( 4, ' ' );
+		build( g4 );
+		cout << "  no arena: " << ( g4.get_allocator().get_arena() == NULL ) << endl;
+	}
+
+	cout << "shortest path trees:" << endl;
+	CGraph<xyVertex<int>, int> grid( 16 );
+	grid_graph_gen( grid, 4, 4 );
+	typedef CrTree<int, int, std::equal_to<int>, no_hash, elist_policy, AT> ATT;
+	bool same = true;
+	size_t used = 0;
+	for( int s = 0; s < grid.range(); ++s ) {
+		CrTree<int, int> t0( grid.range(), -1 );
+		sptree_all_s( grid, s, t0, afl::pointer2value<int>(), 1000 );
+		{
+			ATT t1( grid.range(), -1, 0.25, std::equal_to<int>(), AT( &ar ) );
+			sptree_all_s( grid, s, t1, afl::pointer2value<int>(), 1000 );
+			same = same && to_str( t0 ) == to_str( t1 ) && t0.root() == t1.root();
+			if( s == 5 ) {
+				cout << t1 << endl;
+			}
+			used = used > ar.used() ? used : ar.used();
+		}
+		ar.reset();
+	}
+	cout << "  same " << same << ", blocks " << ar.n_blocks()
+		 << ", peak use under 64K " << ( used < 64 * 1024 ) << endl;
+
+	return 0;
+}
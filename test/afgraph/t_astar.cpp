@@ -0,0 +1,128 @@
+/*@copyright
+
+Copyright (c) 2012 Aiguo Fei
+All rights reserved.
+
+Permission to use and re-distribute this code in source and binary forms
+with or without modifications is therefore granted provided that
+the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Information regarding where to obtain the original source code must be
+      included with the redistrbution.
+
+*NO WARRANTY*
+THIS CODE OR PROGRAM IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S)
+"AS IS" WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE. THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S) MUST NOT BE
+HELD RESPONSIBLE FOR ANY DAMAGE OR UNDESIRED EFFECT CAUSED DIRECTLY OR
+INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
+
+*/
+
+
+/* t_astar.cpp
+
+  test A* search (astar.h): same path lengths as dijkstra_t( ), fewer
+  nodes settled, on a grid (Manhattan) and a Waxman graph (Euclidean).
+
+*/
+
+#include <iostream>
+#include <cmath>
+
+#include "afl/util_tl.hpp"
+
+#include "afgraph/graph.h"
+#include "afgraph/vertex.h"
+#include "afgraph/graph_gen.h"
+#include "afgraph/shortest_path.h"
+#include "afgraph/astar.h"
+
+using namespace std;
+using namespace afg;
+
+// length of path lp in g, -1 if some edge is missing
+template<class GraphT>
+double path_len( const GraphT &g, const CPath &lp )
+{
+	double len = 0;
+	CPath::const_iterator it = lp.begin(), inext = it;
+	for( ++inext; inext != lp.end(); ++it, ++inext ) {
+		const typename GraphT::EDT *pe = g.get_edge_byi( *it, *inext );
+		if( !pe ) {
+			return -1;
+		}
+		len += *pe;
+	}
+	return len;
+}
+
+// A* vs. dijkstra_t( ) (early exit) over pairs (s, t), s and t stepping by k
+template<class GraphT, class Fun, class Heuristic>
+void compare( const char *name, const GraphT &g, Fun f, typename Fun::result_type w_infty,
+			  Heuristic h, int k, bool counts )
+{
+	bool same = true, valid = true, fewer = true;
+	long ns_a = 0, ns_d = 0;
+	for( int s = 0; s < g.range(); s += k ) {
+		for( int t = 0; t < g.range(); t += k + 2 ) {
+			CPath l1, l2;
+			int n1, n2;
+			double d1 = dijkstra_t( g, s, t, f, w_infty, l1, sp_options::sp_early_exit, &n1 );
+			double d2 = astar( g, s, t, f, w_infty, h, l2, &n2 );
+			same = same && fabs( d1 - d2 ) < 1e-9;
+			valid = valid && !l2.empty() && l2.front() == s && l2.back() == t
+					&& fabs( path_len( g, l2 ) - d2 ) < 1e-9;
+			fewer = fewer && n2 <= n1;
+			ns_a += n2;
+			ns_d += n1;
+		}
+	}
+	cout << name << ": same length " << same << ", paths valid " << valid
+		 << ", never more settled " << fewer;
+	if( counts ) {
+		cout << ", settled: dijkstra " << ns_d << ", A* " << ns_a;
+	}
+	cout << endl;
+}
+
+int main()
+{
+	CGraph<xyVertex<int>, int> grid( 400 );
+	grid_graph_gen( grid, 20, 20 );
+	compare( "grid, Manhattan", grid, afl::pointer2value<int>(), 1 << 30,
+			 manhattan_heuristic<int>(), 7, true );
+	compare( "grid, Euclidean", grid, afl::pointer2value<int>(), 1 << 30,
+			 euclid_heuristic<int>(), 7, true );
+	compare( "grid, none", grid, afl::pointer2value<int>(), 1 << 30,
+			 zero_heuristic<int>(), 7, true );
+
+	CGraph<xyVertex<int>, double> bmw( 100 );
+	bmw_graph_gen( bmw, 100, 100 );
+	compare( "Waxman, Euclidean", bmw, afl::pointer2value<double>(), 1e30,
+			 euclid_heuristic<double>(), 3, false );
+
+	// no path, invalid nodes, source is destination
+	CGraph<xyVertex<int>, int> g2( 4 );
+	g2.insert_v( xyVertex<int>( 0, 0 ) );
+	g2.insert_v( xyVertex<int>( 1, 0 ) );
+	g2.insert_v( xyVertex<int>( 5, 5 ) );
+	g2.insert_e( xyVertex<int>( 0, 0 ), xyVertex<int>( 1, 0 ), 1 );
+	CPath lp;
+	int ns;
+	cout << "no path: " << astar( g2, 0, 2, afl::pointer2value<int>(), 100,
+								  euclid_heuristic<int>(), lp, &ns ) << " " << lp.size()
+		 << ", settled " << ns << endl;
+	cout << "invalid: " << astar( g2, 0, 3, afl::pointer2value<int>(), 100,
+								  euclid_heuristic<int>(), lp ) << endl;
+	cout << "to itself: " << astar( g2, 1, 1, afl::pointer2value<int>(), 100,
+									euclid_heuristic<int>(), lp ) << " " << lp << endl;
+	cout << "one edge: " << astar( g2, 0, 1, afl::pointer2value<int>(), 100,
+								   euclid_heuristic<int>(), lp ) << " " << lp << endl;
+	return 0;
+}
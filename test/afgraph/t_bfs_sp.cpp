@@ -0,0 +1,141 @@
+/*@copyright
+
+Copyright (c) 2012 Aiguo Fei
+All rights reserved.
+
+Permission to use and re-distribute this code in source and binary forms
+with or without modifications is therefore granted provided that
+the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Information regarding where to obtain the original source code must be
+      included with the redistrbution.
+
+*NO WARRANTY*
+THIS CODE OR PROGRAM IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S)
+"AS IS" WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE. THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S) MUST NOT BE
+HELD RESPONSIBLE FOR ANY DAMAGE OR UNDESIRED EFFECT CAUSED DIRECTLY OR
+INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
+
+*/
+
+
+
+
+/* t_bfs_sp.cpp
+
+  test shortest paths by hop count by breadth-first search (bfs_sp.h):
+  the same distances as dijkstra_heap( ) with afl::runit_p from every
+  source of random graphs (sparse, and dense enough for bottom-up steps),
+  with in-edges from a transposed copy, from the in-edge index and of a
+  CcsrGraph; exactly the same pred with top-down steps only; valid
+  predecessors otherwise.
+
+*/
+
+#include <iostream>
+#include <vector>
+
+#include "afl/util_tl.hpp"
+
+#include "afgraph/graph.h"
+#include "afgraph/csr_graph.h"
+#include "afgraph/shortest_path.h"
+#include "afgraph/bfs_sp.h"
+
+#include "test_util.h"
+
+using namespace std;
+using namespace afg;
+
+// pred are edges of g, one hop closer
+template<class GraphT>
+bool valid_pred( const GraphT &g, int s, const vector<int> &p, const vector<int> &d )
+{
+	for( int x = 0; x < g.range(); ++x ) {
+		if( p[x] >= 0 ) {
+			if( !g.get_edge_byi( p[x], x ) || d[p[x]] + 1 != d[x] ) {
+				return false;
+			}
+		} else if( x != s && d[x] != 1 << 30 ) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// every source of g by bfs against dijkstra_heap( )
+template<class GraphT, class BfsT>
+void compare( const char *name, const GraphT &g, BfsT &bfs, bool exact )
+{
+	bool same = true, valid = true;
+	int nlevel = 0, nup = 0;
+	for( int s = 0; s < g.range(); ++s ) {
+		vector<int> p0, d0, p1, d1;
+		bool b0 = dijkstra_heap( g, s, afl::runit_p<int>(), 1 << 30, p0, d0 );
+		bool b1 = bfs.run( s, 1 << 30, p1, d1 );
+		same = same && b0 == b1 && ( !b0 || ( d0 == d1 && ( !exact || p0 == p1 ) ) );
+		valid = valid && ( !b1 || valid_pred( g, s, p1, d1 ) );
+		nlevel += bfs.levels();
+		nup += bfs.bottom_up_levels();
+	}
+	cout << name << ": same " << same << ", pred valid " << valid
+		 << ", bottom-up levels " << ( nup > 0 ? "some" : "none" )
+		 << ( nup < nlevel ? ", top-down levels some" : "" ) << endl;
+}
+
+int main()
+{
+	CGraph<int, int> g( 400, -1 );
+	const int ms[] = { 600, 1600, 8000 };
+	for( int k = 0; k < 3; ++k ) {
+		test_random_graph( g, 400, ms[k], 1, 5 + k );
+		cout << ms[k] << " edges" << endl;
+		CspBfs<CGraph<int, int> > b0( g, false );
+		compare( "  top-down only", g, b0, true );
+		CspBfs<CGraph<int, int> > b1( g );
+		compare( "  transposed", g, b1, false );
+		g.enable_in_index();
+		CspBfs<CGraph<int, int> > b2( g );
+		compare( "  in-edge index", g, b2, false );
+		// as dijkstra( ) runs it
+		CspBfs<CGraph<int, int> > b3( g );
+		b3.set_top_down();
+		compare( "  in-edge index, top-down", g, b3, true );
+		g.enable_in_index( false );
+	}
+	test_random_graph( g, 400, 4000, 1, 9 );
+	CcsrGraph<int, int> csr( g );
+	CspBfs<CcsrGraph<int, int> > bc( csr );
+	compare( "CcsrGraph", g, bc, false );
+	CspBfs<CGraph<int, int> > b( g );
+	b.set_switch( 1000, 1 );
+	compare( "bottom-up early", g, b, false );
+
+	// dijkstra( ) with runit_p, levels limited by w_infty, bad source
+	CGraph<int, int> g2( 5, -1 );
+	for( int i = 0; i < 5; ++i ) {
+		g2.insert_v_ati( i, i );
+	}
+	g2.insert_e_byi( 0, 1, 7 );
+	g2.insert_e_byi( 1, 2, 7 );
+	g2.insert_e_byi( 0, 2, 7 );
+	g2.insert_e_byi( 2, 3, 7 );
+	g2.insert_e_byi( 3, 3, 7 );
+	g2.remove_v_byi( 4 );
+	vector<int> p, d;
+	dijkstra( g2, 0, afl::runit_p<int>(), 100, p, d );
+	cout << "dijkstra:";
+	for( int i = 0; i < 5; ++i ) {
+		cout << " " << i << ": " << d[i] << ", " << p[i] << ";";
+	}
+	bool bl = bfs_sp( g2, 0, 2, p, d );
+	cout << " w_infty 2: " << bl << " " << d[2] << " " << d[3] << " " << p[3];
+	cout << ", bad source " << bfs_sp( g2, 4, 100, p, d ) << bfs_sp( g2, 9, 100, p, d ) << endl;
+	return 0;
+}
@@ -0,0 +1,202 @@
+/*@copyright
+
+Copyright (c) 2012 Aiguo Fei
+All rights reserved.
+
+Permission to use and re-distribute this code in source and binary forms
+with or without modifications is therefore granted provided that
+the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Information regarding where to obtain the original source code must be
+      included with the redistrbution.
+
+*NO WARRANTY*
+THIS CODE OR PROGRAM IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S)
+"AS IS" WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE. THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S) MUST NOT BE
+HELD RESPONSIBLE FOR ANY DAMAGE OR UNDESIRED EFFECT CAUSED DIRECTLY OR
+INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
+
+*/
+
+
+/* t_ch_index.cpp
+
+  test contraction hierarchies (ch_index.h): the same distances as
+  dijkstra( ) for all pairs of random graphs (integer weights with zeros,
+  hop count, double weights), paths of the graph of that length, and
+  the same answers from an index saved and loaded back.
+
+*/
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <cmath>
+#include <cstring>
+
+#include "afl/util_tl.hpp"
+
+#include "afgraph/graph.h"
+#include "afgraph/shortest_path.h"
+#include "afgraph/ch_index.h"
+
+#include "test_util.h"
+
+using namespace std;
+using namespace afg;
+
+// length of path lp in g by the lightest edges, -1 if some edge is missing
+template<class GraphT, class Fun>
+double path_len( const GraphT &g, Fun f, const CPath &lp )
+{
+	typedef graph_view<GraphT> GV;
+	double len = 0;
+	CPath::const_iterator it = lp.begin(), inext = it;
+	for( ++inext; inext != lp.end(); ++it, ++inext ) {
+		double w = -1;
+		typename GV::const_e_iterator ite, iend = GV::e_end( g, *it );
+		for( ite = GV::e_begin( g, *it ); ite != iend; ++ite ) {
+			double we = ( double )f( &( GV::edge_d( ite ) ) );
+			if( GV::to( ite ) == *inext && ( w < 0 || we < w ) ) {
+				w = we;
+			}
+		}
+		if( w < 0 ) {
+			return -1;
+		}
+		len += w;
+	}
+	return len;
+}
+
+// all pairs by the hierarchy of g against dijkstra( )
+template<class GraphT, class Fun>
+void compare( const char *name, const GraphT &g, Fun f, typename Fun::result_type w_infty )
+{
+	typedef typename Fun::result_type WeightT;
+	CchIndex<WeightT> idx;
+	bool b = idx.build( g, f, w_infty );
+	stringstream ss;
+	idx.save( ss );
+	CchIndex<WeightT> idx2;
+	bool bl = idx2.load( ss );
+	CchQuery<WeightT> q( idx ), q2( idx2 );
+	bool same = true, valid = true, same_l = true;
+	int npath = 0;
+	for( int s = 0; s < g.range(); ++s ) {
+		vector<int> vp;
+		vector<WeightT> vd;
+		bool bs = dijkstra( g, s, f, w_infty, vp, vd );
+		for( int t = 0; t < g.range(); ++t ) {
+			CPath lp;
+			WeightT d = q.query( s, t, lp );
+			WeightT d0 = bs ? vd[t] : ( t == s ? WeightT() : w_infty );
+			same = same && fabs(( double )( d - d0 ) ) < 1e-9 && q.distance( s, t ) == d;
+			if( d < w_infty ) {
+				++npath;
+				valid = valid && lp.front() == s && lp.back() == t
+						&& fabs( path_len( g, f, lp ) - ( double )d ) < 1e-9;
+			} else {
+				valid = valid && lp.empty();
+			}
+			CPath lp2;
+			same_l = same_l && q2.query( s, t, lp2 ) == d && lp2 == lp;
+		}
+	}
+	cout << name << ": built " << b << ", same distances " << same << ", " << npath
+		 << " paths valid " << valid << ", loaded " << bl << " same " << same_l << endl;
+}
+
+int main()
+{
+	CGraph<int, int> g( 150, -1 );
+	test_random_graph( g, 150, 600, 100, 5 );
+	compare( "int weights [0, 99]", g, afl::pointer2value<int>(), 1 << 30 );
+	compare( "hop count", g, afl::runit_p<int>(), 1 << 30 );
+	test_random_graph( g, 150, 450, 2, 6 );
+	compare( "int weights [0, 1]", g, afl::pointer2value<int>(), 1 << 30 );
+	CGraph<int, double> gd( 150, -1 );
+	test_random_graph( gd, 150, 750, 1000, 7 );
+	compare( "double weights", gd, afl::pointer2value<double>(), 1e30 );
+
+	// small graph: one way, parallel edges, self loop, a removed node
+	CGraph<int, int> g2( 5, -1 );
+	for( int i = 0; i < 5; ++i ) {
+		g2.insert_v_ati( i, i );
+	}
+	g2.insert_e_byi( 0, 1, 5 );
+	g2.insert_e_byi( 1, 2, 5 );
+	g2.insert_e_byi( 0, 2, 20 );
+	g2.insert_e_byi( 2, 2, 1 );
+	g2.insert_e_byi( 2, 4, 1 );
+	g2.remove_v_byi( 3 );
+	CchIndex<int> idx;
+	idx.build( g2, afl::pointer2value<int>(), 100 );
+	CchQuery<int> q( idx );
+	CPath lp;
+	cout << "0 to 4: " << q.query( 0, 4, lp ) << " " << lp;
+	cout << ", 4 to 0: " << q.query( 4, 0, lp ) << " (" << lp.size() << ")";
+	cout << ", 2 to 2: " << q.query( 2, 2, lp ) << " " << lp;
+	cout << ", 0 to 3: " << q.query( 0, 3, lp );
+	cout << ", out of range: " << q.query( 0, 9, lp ) << endl;
+
+	// bad files
+	stringstream ss;
+	idx.save( ss );
+	string s = ss.str();
+	CchIndex<int> idx2;
+	stringstream ss1( s.substr( 0, s.size() - 3 ) );
+	bool b1 = idx2.load( ss1 );
+	s[20] ^= 1;
+	stringstream ss2( s );
+	bool b2 = idx2.load( ss2 );
+	stringstream ss3( "not an index" );
+	bool b3 = idx2.load( ss3 );
+	CchIndex<double> idxd;
+	stringstream ss4( ss.str() );
+	bool b4 = idxd.load( ss4 );
+	cout << "loaded: truncated " << b1 << ", changed " << b2 << ", garbage " << b3
+		 << ", other weight type " << b4 << ", left empty " << idx2.size() << endl;
+
+	// changed within range, sizes right: a shortcut through another node
+	// (of the lowest rank) and two nodes of one rank
+	{
+		CGraph<int, int> g3( 200, -1 );
+		test_random_graph( g3, 200, 800, 20, 7 );
+		CchIndex<int> idx3;
+		idx3.build( g3, afl::pointer2value<int>(), 1 << 30 );
+		stringstream ss5;
+		idx3.save( ss5 );
+		string s5 = ss5.str(), s6 = s5;
+		// data of the k-th vector (rank, up offsets, up to, up mid, ...)
+		size_t pos = 8 + 3 * sizeof( int ), vpos[4];
+		for( int k = 0; k < 4; ++k ) {
+			long long len;
+			memcpy( &len, &s5[pos], sizeof( len ) );
+			vpos[k] = pos + sizeof( len );
+			pos = vpos[k] + ( size_t )len * sizeof( int );
+		}
+		int n3 = idx3.size(), nlow = 0, mid = -1;
+		for( int i = 0; i < n3; ++i ) {
+			nlow = idx3.rank( i ) == 0 ? i : nlow;
+		}
+		size_t k = vpos[3];
+		for( ; k < pos && mid < 0; k += sizeof( int ) ) {
+			memcpy( &mid, &s5[k], sizeof( int ) );
+		}
+		k -= sizeof( int );
+		memcpy( &s5[k], &nlow, sizeof( int ) );
+		memcpy( &s6[vpos[0]], &s6[vpos[0] + sizeof( int )], sizeof( int ) );
+		stringstream ss6( s5 ), ss7( s6 );
+		bool b5 = idx2.load( ss6 ), b6 = idx2.load( ss7 );
+		cout << "loaded: shortcut through " << mid << " changed to " << nlow << " " << b5
+			 << ", ranks not an order " << b6 << endl;
+	}
+	return 0;
+}
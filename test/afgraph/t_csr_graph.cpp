@@ -0,0 +1,139 @@
+/*@copyright
+
+Copyright (c) 2012 Aiguo Fei
+All rights reserved.
+
+Permission to use and re-distribute this code in source and binary forms
+with or without modifications is therefore granted provided that
+the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Information regarding where to obtain the original source code must be
+      included with the redistrbution.
+
+*NO WARRANTY*
+THIS CODE OR PROGRAM IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S)
+"AS IS" WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE. THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S) MUST NOT BE
+HELD RESPONSIBLE FOR ANY DAMAGE OR UNDESIRED EFFECT CAUSED DIRECTLY OR
+INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
+
+*/
+
+
+/* t_csr_graph.cpp
+
+  test CcsrGraph (csr_graph.h): freeze a CGraph and run the same
+  algorithms on both, results should be identical.
+
+*/
+
+#include <iostream>
+#include <vector>
+#include <iterator>
+#include <string>
+
+#include "afl/util_tl.hpp"
+
+#include "afgraph/graph.h"
+#include "afgraph/csr_graph.h"
+#include "afgraph/rtree.h"
+#include "afgraph/path.h"
+#include "afgraph/graph_alg.h"
+#include "afgraph/shortest_path.h"
+#include "afgraph/tree_alg.h"
+
+using namespace std;
+using namespace afg;
+
+int main()
+{
+	typedef CGraph<char, int> GT;
+	typedef CcsrGraph<char, int> CT;
+
+	GT gra( 6, 'z' );
+	gra.insert_v( 'a' );
+	gra.insert_v( 'b' );
+	gra.insert_v( 'x' );
+	gra.insert_v( 'c' );
+	gra.insert_v( 'd' );
+	gra.insert_2e( 'a', 'b', 2 );
+	gra.insert_2e( 'b', 'c', 3 );
+	gra.insert_2e( 'c', 'd', 4 );
+	gra.insert_2e( 'd', 'a', 5 );
+	gra.insert_e( 'a', 'c', 9 );
+	gra.insert_2e( 'x', 'a', 1 );
+	gra.remove_v( 'x' ); // leave an unused index
+	cout << "graph: size " << gra.size() << ", range " << gra.range()
+		 << endl << gra << endl;
+
+	CT csr = freeze( gra );
+	cout << "snapshot: size " << csr.size() << ", range " << csr.range()
+		 << ", edges " << csr.n_edges() << endl << csr << endl;
+
+	int i;
+	for( i = 0; i < csr.range(); ++i ) {
+		cout << i << ": in use " << csr.is_in_use( i )
+			 << ", out degree " << csr[i].out_degree() << endl;
+	}
+	cout << "find_index( 'c' ): " << csr.find_index( 'c' )
+		 << ", edge c->d: " << *csr.get_edge( 'c', 'd' )
+		 << ", edge 0->3: " << *csr.get_edge_byi( 0, 3 )
+		 << ", edge 0->1: " << *csr.get_edge_byi( 0, 1 ) << endl;
+	cout << "edge 3->0 exists? " << ( csr.get_edge_byi( 3, 0 ) != NULL ) << endl;
+
+	cout << "connected?: " << is_connected( gra ) << ", " << is_connected( csr ) << endl;
+	cout << "cost: " << graph_cost( gra, afl::pointer2value<int>() ) << ", "
+		 << graph_cost( csr, afl::pointer2value<int>() ) << endl;
+
+	int n = gra.range();
+	vector<int> vpred( n ), vdist( n ), vpred2( n ), vdist2( n );
+	dijkstra( gra, 0, afl::pointer2value<int>(), 100, vpred, vdist );
+	dijkstra( csr, 0, afl::pointer2value<int>(), 100, vpred2, vdist2 );
+	cout << "dijkstra: " << endl;
+	for( i = 0; i < n; ++i ) {
+		cout << i << ": " << vdist[i] << ", " << vpred[i] << " | "
+			 << vdist2[i] << ", " << vpred2[i] << endl;
+	}
+	cout << "same: " << ( vpred == vpred2 && vdist == vdist2 ) << endl;
+
+	CPath lp;
+	cout << "find path from node 0 to 4 result: "
+		 << dijkstra_t( csr, 0, 4, afl::pointer2value<int>(), 100, lp )
+		 << endl << "path: " << lp << endl;
+
+	vector<int> vapred( n * n ), vadist( n * n );
+	vector<int> vapred2( n * n ), vadist2( n * n );
+	floyd_warshall_allsp( gra, afl::pointer2value<int>(), 100, vapred, vadist );
+	floyd_warshall_allsp( csr, afl::pointer2value<int>(), 100, vapred2, vadist2 );
+	cout << "floyd-warshall same: "
+		 << ( vapred == vapred2 && vadist == vadist2 ) << endl;
+
+	CrTree<char, int> tr( 6, 'z' );
+	sptree_all( csr, 0, tr, afl::pointer2value<int>(), 100 );
+	cout << "sp tree from snapshot: " << endl << tr << endl;
+
+	// copy and re-freeze
+	CT csr2( csr );
+	gra.insert_v( 'e' );
+	gra.insert_2e( 'e', 'd', 7 );
+	csr.freeze( gra );
+	cout << "copy: " << endl << csr2 << "refrozen: " << endl << csr << endl;
+
+	// non-trivial edge data
+	CGraph<int, string> gs( 3, -1 );
+	gs.insert_v( 10 );
+	gs.insert_v( 20 );
+	gs.insert_v( 30 );
+	gs.insert_e( 10, 20, "ten-twenty" );
+	gs.insert_e( 20, 30, "twenty-thirty" );
+	gs.insert_e( 10, 30, "ten-thirty" );
+	CcsrGraph<int, string> cs( gs );
+	cout << "string edges: " << endl << cs << endl;
+
+	return 0;
+}
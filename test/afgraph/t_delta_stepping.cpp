@@ -0,0 +1,151 @@
+/*@copyright
+
+Copyright (c) 2012 Aiguo Fei
+All rights reserved.
+
+Permission to use and re-distribute this code in source and binary forms
+with or without modifications is therefore granted provided that
+the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Information regarding where to obtain the original source code must be
+      included with the redistrbution.
+
+*NO WARRANTY*
+THIS CODE OR PROGRAM IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S)
+"AS IS" WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE. THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S) MUST NOT BE
+HELD RESPONSIBLE FOR ANY DAMAGE OR UNDESIRED EFFECT CAUSED DIRECTLY OR
+INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
+
+*/
+
+
+/* t_delta_stepping.cpp
+
+  test delta_stepping( ) (delta_stepping.h): same distances as dijkstra( )
+  for integer, hop count and double weights, zero weights, several delta
+  and thread counts; predecessors on shortest paths and the same for any
+  number of threads.
+
+*/
+
+#include <iostream>
+#include <vector>
+
+#include "afl/util_tl.hpp"
+
+#include "afgraph/graph.h"
+#include "afgraph/graph_view.h"
+#include "afgraph/shortest_path.h"
+#include "afgraph/delta_stepping.h"
+
+#include "test_util.h"
+
+using namespace std;
+using namespace afg;
+
+// every reached node but s has an edge from pred on a shortest path
+template<class GraphT, class Fun>
+bool valid_pred( const GraphT &g, int s, Fun f, typename Fun::result_type w_infty,
+				 const vector<int> &pred, const vector<typename Fun::result_type> &dist )
+{
+	typedef graph_view<GraphT> GV;
+	for( int v = 0; v < g.range(); ++v ) {
+		int p = pred[v];
+		if( v == s || !( dist[v] < w_infty ) ) {
+			if( p != -1 ) {
+				return false;
+			}
+			continue;
+		}
+		bool found = false;
+		typename GV::const_e_iterator ite, iend = GV::e_end( g, p );
+		for( ite = GV::e_begin( g, p ); ite != iend; ++ite ) {
+			found = found || ( GV::to( ite ) == v
+							   && dist[p] + f( &( GV::edge_d( ite ) ) ) == dist[v] );
+		}
+		if( !found ) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// delta_stepping( ) from every k-th node with the given delta on 1 and 4
+// threads, against dijkstra( )
+template<class GraphT, class Fun>
+void compare( const char *name, const GraphT &g, Fun f, typename Fun::result_type w_infty,
+			  typename Fun::result_type delta, int k )
+{
+	bool same = true, valid = true, same_t = true;
+	for( int s = 0; s < g.range(); s += k ) {
+		vector<int> p0, p1, p4;
+		vector<typename Fun::result_type> d0, d1, d4;
+		bool b0 = dijkstra( g, s, f, w_infty, p0, d0 );
+		bool b1 = delta_stepping( g, s, f, w_infty, p1, d1, delta, 1 );
+		bool b4 = delta_stepping( g, s, f, w_infty, p4, d4, delta, 4 );
+		same = same && b0 == b1 && b0 == b4 && ( !b0 || ( d0 == d1 && d0 == d4 ) );
+		valid = valid && ( !b1 || valid_pred( g, s, f, w_infty, p1, d1 ) );
+		same_t = same_t && p1 == p4;
+	}
+	cout << name << ", delta " << delta << ": same distances " << same
+		 << ", predecessors valid " << valid << ", same on 4 threads " << same_t << endl;
+}
+
+int main()
+{
+	CGraph<int, int> g( 300, -1 );
+	test_random_graph( g, 300, 1500, 100, 5 );
+	const int deltas[4] = { 0, 1, 20, 1000 };
+	for( int k = 0; k < 4; ++k ) {
+		compare( "int weights [0, 99]", g, afl::pointer2value<int>(), 1 << 30, deltas[k], 7 );
+	}
+	compare( "hop count", g, afl::runit_p<int>(), 1 << 30, 0, 7 );
+	compare( "hop count", g, afl::runit_p<int>(), 1 << 30, 3, 7 );
+
+	// many ties and zero weight cycles
+	test_random_graph( g, 300, 1500, 2, 6 );
+	compare( "int weights [0, 1]", g, afl::pointer2value<int>(), 1 << 30, 1, 7 );
+
+	CGraph<int, double> gd( 300, -1 );
+	test_random_graph( gd, 300, 1200, 1000, 7 );
+	compare( "double weights", gd, afl::pointer2value<double>(), 1e30, 0.0, 7 );
+	compare( "double weights", gd, afl::pointer2value<double>(), 1e30, 0.3, 7 );
+	compare( "double weights", gd, afl::pointer2value<double>(), 1e30, 50.0, 7 );
+
+	// unreachable nodes, invalid source, relaxation count, exception
+	CGraph<int, int> g2( 4, -1 );
+	for( int i = 0; i < 4; ++i ) {
+		g2.insert_v_ati( i, i );
+	}
+	g2.insert_e_byi( 0, 1, 5 );
+	g2.insert_e_byi( 1, 2, 5 );
+	g2.insert_e_byi( 0, 2, 20 );
+	g2.insert_e_byi( 2, 2, 1 );
+	g2.remove_v_byi( 3 );
+	vector<int> vp, vd;
+	afl::thread_pool pool( 2 );
+	long long nrelax = 0;
+	bool b = delta_stepping( g2, 1, afl::pointer2value<int>(), 100, vp, vd, 0, pool, &nrelax );
+	cout << "from 1: " << b << ", dist " << vd[0] << " " << vd[1] << " " << vd[2]
+		 << ", pred " << vp[0] << " " << vp[1] << " " << vp[2] << ", relaxations " << nrelax << endl;
+	b = delta_stepping( g2, 0, afl::pointer2value<int>(), 100, vp, vd, 0, pool, &nrelax );
+	cout << "from 0: " << b << ", dist " << vd[0] << " " << vd[1] << " " << vd[2]
+		 << ", pred " << vp[0] << " " << vp[1] << " " << vp[2] << ", relaxations " << nrelax << endl;
+	cout << "invalid source: " << delta_stepping( g2, 3, afl::pointer2value<int>(), 100, vp, vd )
+		 << endl;
+	g2.insert_v_ati( 3, 3 );
+	g2.insert_e_byi( 3, 0, -1 );
+	try {
+		delta_stepping( g2, 0, afl::pointer2value<int>(), 100, vp, vd );
+		cout << "negative weight: no exception" << endl;
+	} catch( afl::general_except<std::string> &e ) {
+		cout << "negative weight: " << e.what() << endl;
+	}
+	return 0;
+}
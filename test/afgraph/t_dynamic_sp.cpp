@@ -0,0 +1,177 @@
+/*@copyright
+
+Copyright (c) 2012 Aiguo Fei
+All rights reserved.
+
+Permission to use and re-distribute this code in source and binary forms
+with or without modifications is therefore granted provided that
+the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Information regarding where to obtain the original source code must be
+      included with the redistrbution.
+
+*NO WARRANTY*
+THIS CODE OR PROGRAM IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S)
+"AS IS" WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE. THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S) MUST NOT BE
+HELD RESPONSIBLE FOR ANY DAMAGE OR UNDESIRED EFFECT CAUSED DIRECTLY OR
+INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
+
+*/
+
+
+
+
+/* t_dynamic_sp.cpp
+
+  test shortest paths kept up to date under edge changes (dynamic_sp.h):
+  after each of a random sequence of heavier, lighter, removed and new
+  edges, the same distances as a new dijkstra( ) run, a valid shortest
+  path tree, and a tree kept up to date by update_sptree( ) the same as
+  one made from pred( ).
+
+*/
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+
+#include "afl/util_tl.hpp"
+
+#include "afgraph/graph.h"
+#include "afgraph/rtree.h"
+#include "afgraph/tree_util.h"
+#include "afgraph/shortest_path.h"
+#include "afgraph/dynamic_sp.h"
+
+#include "test_util.h"
+
+using namespace std;
+using namespace afg;
+
+unsigned long long rnd_state = 11;
+
+int rnd( int n )
+{
+	rnd_state = rnd_state * 6364136223846793005ULL + 1442695040888963407ULL;
+	return ( int )(( rnd_state >> 33 ) % n );
+}
+
+// nchange random changes to the paths from source 0 of g; check each
+template<class GraphT, class Fun>
+void run( const char *name, GraphT &g, Fun f, typename Fun::result_type w_infty,
+		  int maxw, int nchange )
+{
+	typedef typename Fun::result_type WeightT;
+	typedef typename GraphT::EDT EDT;
+	CspDynamic<GraphT, Fun> dsp( g, 0, f, w_infty );
+	CrTree<int, EDT> tree;
+	pred2tree( g, dsp.pred(), tree );
+	int n = g.range(), nok[4] = { 0, 0, 0, 0 }, nfail = 0;
+	bool same = true, valid = true, same_t = true;
+	long long ntouched = 0;
+	for( int k = 0; k < nchange; ++k ) {
+		int i = rnd( n ), j = rnd( n ), op = rnd( 4 );
+		// changes to the edges of the tree most of the time
+		if( op < 2 && rnd( 4 ) > 0 && g.is_valid( j ) && dsp.pred()[j] >= 0 ) {
+			i = dsp.pred()[j];
+		}
+		// and to edges which are there
+		if( op == 2 && g.is_valid( j ) && g.in_begin( j ) != g.in_end( j ) ) {
+			i = g.in_begin( j )[rnd( ( int )( g.in_end( j ) - g.in_begin( j ) ) )];
+		}
+		EDT e = ( EDT )rnd( maxw );
+		bool b;
+		if( op == 0 ) {
+			const EDT *pe = g.get_edge_byi( i, j );
+			b = dsp.update_edge( i, j, pe ? *pe + e : e );
+		} else if( op == 1 ) {
+			b = dsp.remove_edge( i, j );
+		} else if( op == 2 ) {
+			const EDT *pe = g.get_edge_byi( i, j );
+			b = dsp.update_edge( i, j, pe ? *pe / 2 : e );
+		} else {
+			b = dsp.insert_edge( i, j, e );
+		}
+		if( !b ) {
+			++nfail;
+			continue;
+		}
+		++nok[op];
+		ntouched += dsp.changed().size();
+		vector<int> vp;
+		vector<WeightT> vd;
+		dijkstra( g, 0, f, w_infty, vp, vd );
+		const vector<int> &pred = dsp.pred();
+		const vector<WeightT> &dist = dsp.dist();
+		for( int x = 0; x < n; ++x ) {
+			if( !g.is_valid( x ) ) {
+				continue;
+			}
+			same = same && fabs(( double )( dist[x] - vd[x] ) ) < 1e-9;
+			if( pred[x] >= 0 ) {
+				const EDT *pe = g.get_edge_byi( pred[x], x );
+				valid = valid && pe
+						&& fabs(( double )( dist[pred[x]] + f( pe ) - dist[x] ) ) < 1e-9;
+			} else {
+				valid = valid && ( x == 0 || dist[x] == w_infty );
+			}
+		}
+		dsp.update_sptree( tree );
+		for( int x = 0; x < n; ++x ) {
+			if( g.is_valid( x ) ) {
+				int p = tree.parent_byi( x );
+				same_t = same_t && p == pred[x]
+						 && ( p < 0 || *tree.get_edge_byi( p, x ) == *g.get_edge_byi( p, x ) );
+			}
+		}
+	}
+	cout << name << ": " << nok[0] << " heavier, " << nok[1] << " removed, " << nok[2]
+		 << " lighter, " << nok[3] << " new edges (" << nfail << " not there), "
+		 << ( double )ntouched / ( nchange - nfail ) << " nodes changed on average" << endl;
+	cout << "  same distances " << same << ", tree valid " << valid
+		 << ", tree kept the same " << same_t << endl;
+}
+
+int main()
+{
+	CGraph<int, int> g( 300, -1 );
+	test_random_graph( g, 300, 1200, 100, 5 );
+	run( "int weights", g, afl::pointer2value<int>(), 1 << 30, 100, 2000 );
+	test_random_graph( g, 300, 900, 3, 6 );
+	run( "int weights [0, 2]", g, afl::pointer2value<int>(), 1 << 30, 3, 2000 );
+	test_random_graph( g, 300, 700, 1, 7 );
+	run( "hop count", g, afl::runit_p<int>(), 1 << 30, 1, 2000 );
+	CGraph<int, double> gd( 300, -1 );
+	test_random_graph( gd, 300, 1500, 1000, 8 );
+	run( "double weights", gd, afl::pointer2value<double>(), 1e30, 1000, 2000 );
+
+	// small graph: the path 0->1->2 made heavier, removed, put back
+	CGraph<int, int> g2( 4, -1 );
+	for( int i = 0; i < 4; ++i ) {
+		g2.insert_v_ati( i, i );
+	}
+	g2.insert_e_byi( 0, 1, 1 );
+	g2.insert_e_byi( 1, 2, 1 );
+	g2.insert_e_byi( 0, 2, 5 );
+	g2.insert_e_byi( 2, 3, 1 );
+	typedef afl::pointer2value<int> FW;
+	CspDynamic<CGraph<int, int>, FW> dsp( g2, 0, FW(), 100 );
+	cout << "dist to 3: " << dsp.dist()[3];
+	dsp.update_edge( 1, 2, 3 );
+	cout << ", 1->2 of 3: " << dsp.dist()[3] << " (" << dsp.changed().size() << " changed)";
+	dsp.remove_edge( 0, 2 );
+	cout << ", 0->2 removed: " << dsp.dist()[3] << " by " << dsp.pred()[2];
+	dsp.remove_edge( 1, 2 );
+	cout << ", 1->2 removed: " << dsp.dist()[3] << " " << dsp.pred()[3];
+	dsp.insert_edge( 1, 2, 0 );
+	cout << ", 1->2 of 0: " << dsp.dist()[3];
+	cout << ", no edge " << dsp.update_edge( 3, 0, 1 ) << dsp.remove_edge( 3, 0 )
+		 << ", bad node " << dsp.insert_edge( 0, 9, 1 ) << endl;
+	return 0;
+}
@@ -39,6 +39,8 @@ INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
 #include <iostream>
 #include <vector>
 #include <functional>
+#include <algorithm>
+#include <iterator>
 
 #include "afgraph/graph.h"
 
@@ -51,6 +53,24 @@ void outputw( ET *pe, Fun fw )
 	std::cout << "weight of edge: " << fw( pe ) << std::endl;
 }
 
+// build the same small graph with any edge container policy
+template<class GT>
+void build_policy_graph( GT &g )
+{
+	const char *vs = "abcdef";
+	int k;
+	for( k = 0; k < 6; ++k ) {
+		g.insert_v( vs[k] );
+	}
+	for( k = 0; k < 6; ++k ) {
+		g.insert_2e( vs[k], vs[( k + 1 ) % 6], k );
+		g.insert_e( 'a', vs[k], 10 + k );
+	}
+	g.insert_e( 'a', 'b', 99 ); // replace
+	g.remove_v( 'c' );
+	g.pack();
+}
+
 int main()
 {
 	CiVertex<int, int> vx0;
@@ -242,5 +262,210 @@ int main()
 		cout << "exception accessing node indexed " << xi << ": " << ore.what() << endl;
 	}
 
+	// graph with a hash index on vertex data
+	typedef CGraph<int, int, std::equal_to<int>, std::hash<int> > HGT;
+	HGT hg( 4, -1 );
+	CGraph<int, int> lg( 4, -1 );
+	int k;
+	for( k = 0; k < 10; ++k ) {
+		hg.insert_v( 200 + k );
+		lg.insert_v( 200 + k );
+	}
+	hg.insert_2e( 200, 205, 1 );
+	hg.insert_2e( 205, 209, 2 );
+	hg.insert_v_ati( 300, 3 ); // replace 203
+	lg.insert_v_ati( 300, 3 );
+	hg.insert_v_ati( 301, 12 ); // new position
+	lg.insert_v_ati( 301, 12 );
+	hg.set_v_ati( 302, 4 ); // replace 204, edges kept
+	lg.set_v_ati( 302, 4 );
+	hg.remove_v( 201 );
+	lg.remove_v( 201 );
+	hg.insert_v_ati( 207, 1 ); // duplicate of 207 at a smaller index
+	lg.insert_v_ati( 207, 1 );
+	cout << "hashed graph: size " << hg.size() << ", range " << hg.range()
+		 << endl << hg << endl;
+	cout << "find_index (hashed, linear): ";
+	int vfind[] = { 200, 201, 203, 204, 207, 209, 300, 301, 302, 999, -1 };
+	for( k = 0; k < ( int )( sizeof( vfind ) / sizeof( int ) ); ++k ) {
+		cout << vfind[k] << ": " << hg.find_index( vfind[k] ) << " "
+			 << lg.find_index( vfind[k] ) << "; ";
+	}
+	cout << endl;
+	hg.pack();
+	lg.pack();
+	cout << "after pack: " << endl << hg;
+	cout << "find_index (hashed, linear): ";
+	for( k = 0; k < ( int )( sizeof( vfind ) / sizeof( int ) ); ++k ) {
+		cout << vfind[k] << ": " << hg.find_index( vfind[k] ) << " "
+			 << lg.find_index( vfind[k] ) << "; ";
+	}
+	cout << endl;
+	HGT hg2( hg );
+	hg.clear();
+	cout << "after clear: " << hg.find_index( 200 ) << ", copy: "
+		 << hg2.find_index( 200 ) << " " << *hg2.get_edge( 205, 209 ) << endl;
+
+	// edge container policies, the same graph in each
+	CGraph<char, int> gl( 4, 'z' );
+	CGraph<char, int, std::equal_to<char>, no_hash, evector_policy> gv( 4, 'z' );
+	CGraph<char, int, std::equal_to<char>, no_hash, esmall_policy<2> > gs( 4, 'z' );
+	build_policy_graph( gl );
+	build_policy_graph( gv );
+	build_policy_graph( gs );
+	cout << "list edges: " << endl << gl << "vector edges: " << endl << gv
+		 << "small-buffer edges: " << endl << gs;
+	CGraph<char, int, std::equal_to<char>, no_hash, esmall_policy<2> > gs2( gs );
+	gs.remove_all_edges();
+	cout << "copy: " << endl << gs2 << "out degree of 0: " << gs2[0].out_degree()
+		 << ", " << gs[0].out_degree() << endl;
+
+	// unused slots: removed indices are reused lowest first
+	CGraph<int, int> gu( 100, -1 );
+	vector<bool> vused( 200, false );
+	bool bok = true;
+	for( k = 0; k < 150; ++k ) {
+		int ni = gu.insert_v_qik( k );
+		vused[ni] = true;
+	}
+	for( k = 3; k < 150; k += 7 ) {
+		gu.remove_v_byi( k );
+		vused[k] = false;
+	}
+	gu.insert_v_ati( 1000, 10 );
+	vused[10] = true;
+	gu.insert_v_ati( 1001, 180 );
+	vused[180] = true;
+	for( k = 0; k < 5; ++k ) {
+		int ni = gu.insert_v_qik( 2000 + k );
+		int nexp = ( int )( std::find( vused.begin(), vused.end(), false ) - vused.begin() );
+		bok = bok && ( ni == nexp );
+		vused[ni] = true;
+	}
+	for( k = 0; k < gu.range(); ++k ) {
+		bok = bok && ( gu.is_in_use( k ) == vused[k] );
+	}
+	cout << "unused slots: size " << gu.size() << ", range " << gu.range()
+		 << ", consistent " << bok << endl;
+	gu.pack();
+	cout << "after pack: size " << gu.size() << ", range " << gu.range()
+		 << ", last in use " << gu.is_in_use( gu.size() - 1 ) << endl;
+
+	// in-edge index, checked against a scan of all edges
+	CGraph<int, int> gi( 20, -1 );
+	for( k = 0; k < 20; ++k ) {
+		gi.insert_v( k );
+	}
+	for( k = 0; k < 60; ++k ) {
+		gi.insert_e_byi(( k * 7 ) % 20, ( k * 13 + 5 ) % 20, k );
+	}
+	gi.enable_in_index();
+	gi.insert_2e( 1, 2, 100 );
+	gi.insert_e( 3, 3, 101 );
+	gi.remove_e( 5, 18 );
+	gi.remove_2e( 0, 5 );
+	gi.remove_alle_byi( 7 );
+	gi.remove_v( 11 );
+	gi.remove_v( 3 );
+	gi.insert_v( 50 );
+	gi.insert_2e( 50, 4, 102 );
+	cout << "in-edge index: " << gi.has_in_index() << endl << gi;
+	bok = true;
+	for( k = 0; k < gi.range(); ++k ) {
+		vector<int> vin( gi.in_begin( k ), gi.in_end( k ) ), vscan;
+		for( int i = 0; i < gi.range(); ++i ) {
+			if( gi.get_edge_byi( i, k ) != NULL ) {
+				vscan.push_back( i );
+			}
+		}
+		std::sort( vin.begin(), vin.end() );
+		bok = bok && ( vin == vscan );
+	}
+	cout << "in-neighbours of 4: ";
+	vector<int> vin4( gi.in_begin( 4 ), gi.in_end( 4 ) );
+	std::sort( vin4.begin(), vin4.end() );
+	copy( vin4.begin(), vin4.end(), ostream_iterator<int>( cout, " " ) );
+	cout << endl << "in-edge index consistent " << bok << endl;
+
+	// pack with remap table, edges checked against the old graph
+	CGraph<int, int> gp( 12, -1 );
+	for( k = 0; k < 12; ++k ) {
+		gp.insert_v( 100 + k );
+	}
+	for( k = 0; k < 12; ++k ) {
+		gp.insert_e_byi( k, ( k * 5 + 3 ) % 12, k );
+		gp.insert_e_byi( k, ( k + 1 ) % 12, 20 + k );
+	}
+	gp.remove_v_byi( 0 );
+	gp.remove_v_byi( 4 );
+	gp.remove_v_byi( 5 );
+	gp.remove_v_byi( 9 );
+	gp.remove_v_byi( 11 );
+	CGraph<int, int> gp0( gp );
+	vector<int> vremap;
+	int nch = gp.pack( 0, &vremap );
+	cout << "pack with remap: " << nch << " changes, remap: ";
+	copy( vremap.begin(), vremap.end(), ostream_iterator<int>( cout, " " ) );
+	cout << endl << gp;
+	bok = ( gp.size() == gp0.size() );
+	for( k = 0; k < gp0.range(); ++k ) {
+		if( !gp0.is_in_use( k ) ) {
+			bok = bok && ( vremap[k] == -1 );
+			continue;
+		}
+		bok = bok && ( gp[vremap[k]].vertex_d() == gp0[k].vertex_d() )
+			  && ( gp[vremap[k]].out_degree() == gp0[k].out_degree() );
+		for( CGraph<int, int>::const_e_iterator it = gp0.e_begin( k );
+			 it != gp0.e_end( k ); ++it ) {
+			const int *pe = gp.get_edge_byi( vremap[k], vremap[( *it ).to()] );
+			bok = bok && pe != NULL && *pe == ( *it ).edge_d();
+		}
+	}
+	cout << "pack remap consistent " << bok << endl;
+
+	// bulk edge loading, checked against insert_e_byi( ) one by one
+	CGraph<int, int> gb( 8, -1 ), gb0( 8, -1 );
+	for( k = 0; k < 8; ++k ) {
+		gb.insert_v( k );
+		gb0.insert_v( k );
+	}
+	vector< CeTuple<int> > vte;
+	for( k = 0; k < 40; ++k ) {
+		vte.push_back( CeTuple<int>(( k * 3 ) % 8, ( k * k + k / 3 ) % 8, k ) );
+	}
+	vte.push_back( CeTuple<int>( 2, 9, 100 ) ); // invalid, ignored
+	for( k = 0; k < ( int )vte.size(); ++k ) {
+		gb0.insert_e_byi( vte[k].from, vte[k].to, vte[k].edge );
+	}
+	int ne = gb.assign_edges( vte.begin(), vte.end() );
+	cout << "assign_edges (keep last): " << ne << " edges" << endl << gb;
+	bok = true;
+	for( k = 0; k < gb.range(); ++k ) {
+		CGraph<int, int>::const_e_iterator it1 = gb.e_begin( k ), it0 = gb0.e_begin( k );
+		for( ; it1 != gb.e_end( k ) && it0 != gb0.e_end( k ); ++it1, ++it0 ) {
+			bok = bok && ( *it1 ).to() == ( *it0 ).to()
+				  && ( *it1 ).edge_d() == ( *it0 ).edge_d();
+		}
+		bok = bok && it1 == gb.e_end( k ) && it0 == gb0.e_end( k );
+	}
+	cout << "same as insert_e_byi: " << bok << endl;
+	gb.assign_edges( vte.begin(), vte.end(), dup_keep_first() );
+	cout << "keep first: " << endl << gb;
+	gb.assign_edges( vte.begin(), vte.end(), make_dup_combine( std::plus<int>() ) );
+	cout << "combine (sum): " << endl << gb;
+	// in two parts: insert_edges( ) adds the second to the first
+	gb.assign_edges( vte.begin(), vte.begin() + 20 );
+	ne = gb.insert_edges( vte.begin() + 20, vte.end() );
+	bok = true;
+	for( k = 0; k < gb.range(); ++k ) {
+		CGraph<int, int>::const_e_iterator it1 = gb.e_begin( k ), it0 = gb0.e_begin( k );
+		for( ; it1 != gb.e_end( k ) && it0 != gb0.e_end( k ); ++it1, ++it0 ) {
+			bok = bok && ( *it1 ).to() == ( *it0 ).to()
+				  && ( *it1 ).edge_d() == ( *it0 ).edge_d();
+		}
+		bok = bok && it1 == gb.e_end( k ) && it0 == gb0.e_end( k );
+	}
+	cout << "insert_edges: " << ne << " edges, same as insert_e_byi: " << bok << endl;
+
 	return 0;
 }
@@ -0,0 +1,121 @@
+/*@copyright
+
+Copyright (c) 2012 Aiguo Fei
+All rights reserved.
+
+Permission to use and re-distribute this code in source and binary forms
+with or without modifications is therefore granted provided that
+the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Information regarding where to obtain the original source code must be
+      included with the redistrbution.
+
+*NO WARRANTY*
+THIS CODE OR PROGRAM IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S)
+"AS IS" WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE. THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S) MUST NOT BE
+HELD RESPONSIBLE FOR ANY DAMAGE OR UNDESIRED EFFECT CAUSED DIRECTLY OR
+INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
+
+*/
+
+
+
+
+/* t_graph_view.cpp
+
+  test graph_view (graph_view.h): algorithms give the same results with
+  static access (CGraph, CrTree) and virtual access (IGraph reference).
+
+*/
+
+#include <iostream>
+#include <vector>
+
+#include "afl/util_tl.hpp"
+
+#include "afgraph/graph.h"
+#include "afgraph/rtree.h"
+#include "afgraph/csr_graph.h"
+#include "afgraph/graph_view.h"
+#include "afgraph/graph_alg.h"
+#include "afgraph/shortest_path.h"
+
+using namespace std;
+using namespace afg;
+
+int main()
+{
+	typedef CGraph<char, int> GT;
+	typedef GT::igraph_base_type IGT;
+
+	cout << "is_cgraph: CGraph " << is_cgraph<GT>::value
+		 << ", CrTree " << is_cgraph< CrTree<char, int> >::value
+		 << ", IGraph " << is_cgraph<IGT>::value
+		 << ", CcsrGraph " << is_cgraph< CcsrGraph<char, int> >::value << endl;
+
+	GT gra( 6, 'z' );
+	gra.insert_v( 'a' );
+	gra.insert_v( 'b' );
+	gra.insert_v( 'x' );
+	gra.insert_v( 'c' );
+	gra.insert_v( 'd' );
+	gra.insert_2e( 'a', 'b', 2 );
+	gra.insert_2e( 'b', 'c', 3 );
+	gra.insert_2e( 'c', 'd', 4 );
+	gra.insert_e( 'a', 'c', 9 );
+	gra.insert_2e( 'x', 'a', 1 );
+	gra.remove_v( 'x' );
+	const IGT &igra = gra;
+
+	int i;
+	cout << "view: range " << graph_view<GT>::range( gra ) << ", valid: ";
+	for( i = 0; i < gra.range(); ++i ) {
+		cout << graph_view<GT>::is_valid( gra, i ) << graph_view<IGT>::is_valid( igra, i ) << " ";
+	}
+	cout << endl << "out edges of 0: ";
+	for( graph_view<GT>::const_e_iterator it = graph_view<GT>::e_begin( gra, 0 );
+		 it != graph_view<GT>::e_end( gra, 0 ); ++it ) {
+		cout << graph_view<GT>::to( it ) << ": " << graph_view<GT>::edge_d( it ) << " ";
+	}
+	cout << endl;
+
+	cout << "cost: " << graph_cost( gra, afl::pointer2value<int>() ) << ", "
+		 << graph_cost( igra, afl::pointer2value<int>() ) << endl;
+	cout << "connected: " << is_connected( gra ) << ", " << is_connected( igra ) << endl;
+
+	int n = gra.range();
+	vector<int> vpred, vdist, vpred2, vdist2;
+	dijkstra( gra, 0, afl::pointer2value<int>(), 100, vpred, vdist );
+	dijkstra( igra, 0, afl::pointer2value<int>(), 100, vpred2, vdist2 );
+	cout << "dijkstra: ";
+	for( i = 0; i < n; ++i ) {
+		cout << vdist[i] << "/" << vpred[i] << " ";
+	}
+	cout << endl << "same: " << ( vpred == vpred2 && vdist == vdist2 ) << endl;
+
+	CrTree<char, int> tr( 6, 'z' );
+	tr.copy_vertices( gra );
+	tr.insert_e_byi( 0, 1, 2 );
+	tr.insert_e_byi( 1, 3, 3 );
+	tr.insert_e_byi( 0, 4, 5 );
+	dijkstra( tr, 0, afl::pointer2value<int>(), 100, vpred, vdist );
+	cout << "tree cost: " << graph_cost( tr, afl::pointer2value<int>() )
+		 << ", dijkstra on tree: ";
+	for( i = 0; i < n; ++i ) {
+		cout << vdist[i] << "/" << vpred[i] << " ";
+	}
+	cout << endl;
+
+	vector<int> vapred, vadist, vapred2, vadist2;
+	floyd_warshall_allsp( gra, afl::pointer2value<int>(), 100, vapred, vadist );
+	floyd_warshall_allsp( igra, afl::pointer2value<int>(), 100, vapred2, vadist2 );
+	cout << "floyd-warshall same: " << ( vapred == vapred2 && vadist == vadist2 ) << endl;
+
+	return 0;
+}
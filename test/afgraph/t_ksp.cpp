@@ -0,0 +1,250 @@
+/*@copyright
+
+Copyright (c) 2012 Aiguo Fei
+All rights reserved.
+
+Permission to use and re-distribute this code in source and binary forms
+with or without modifications is therefore granted provided that
+the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Information regarding where to obtain the original source code must be
+      included with the redistrbution.
+
+*NO WARRANTY*
+THIS CODE OR PROGRAM IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S)
+"AS IS" WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE. THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S) MUST NOT BE
+HELD RESPONSIBLE FOR ANY DAMAGE OR UNDESIRED EFFECT CAUSED DIRECTLY OR
+INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
+
+*/
+
+
+
+
+/* t_ksp.cpp
+
+  test k shortest paths (ksp.h): CkspEppstein against the k shortest
+  path lengths found by letting Dijkstra's search settle each node k
+  times, with valid and distinct paths, and on the graph of t_kthsp.cpp
+  against CkthSP; CkspYen against all loopless paths found by
+  depth-first search.
+
+*/
+
+#include <iostream>
+#include <vector>
+#include <set>
+#include <queue>
+#include <functional>
+#include <algorithm>
+
+#include "afl/util_tl.hpp"
+
+#include "afgraph/graph.h"
+#include "afgraph/kthsp.h"
+#include "afgraph/ksp.h"
+
+#include "test_util.h"
+
+using namespace std;
+using namespace afg;
+
+typedef CGraph<int, int> GT;
+typedef afl::pointer2value<int> FW;
+
+// k shortest path lengths from s to each node: each node settled k times
+vector<vector<int> > k_lengths( const GT &g, int s, int k )
+{
+	vector<vector<int> > vl( g.range() );
+	priority_queue<pair<int, int>, vector<pair<int, int> >, greater<pair<int, int> > > pq;
+	pq.push( make_pair( 0, s ) );
+	while( !pq.empty() ) {
+		pair<int, int> p = pq.top();
+		pq.pop();
+		if(( int )vl[p.second].size() >= k ) {
+			continue;
+		}
+		vl[p.second].push_back( p.first );
+		GT::const_e_iterator ite;
+		for( ite = g[p.second].begin(); ite != g[p.second].end(); ++ite ) {
+			pq.push( make_pair( p.first + ( *ite ).edge_d(), ( *ite ).to() ) );
+		}
+	}
+	return vl;
+}
+
+// length of path lp by edges of g, -1 if some edge is missing
+int path_len( const GT &g, const CPath &lp )
+{
+	int len = 0;
+	CPath::const_iterator it = lp.begin(), inext = it;
+	for( ++inext; inext != lp.end(); ++it, ++inext ) {
+		const int *pe = g.get_edge_byi( *it, *inext );
+		if( !pe ) {
+			return -1;
+		}
+		len += *pe;
+	}
+	return len;
+}
+
+// all loopless paths from u to t, lengths into vl
+void dfs_paths( const GT &g, int u, int t, int len, vector<char> &von, vector<int> &vl )
+{
+	if( u == t ) {
+		vl.push_back( len );
+		return;
+	}
+	von[u] = 1;
+	GT::const_e_iterator ite;
+	for( ite = g[u].begin(); ite != g[u].end(); ++ite ) {
+		if( !von[( *ite ).to()] ) {
+			dfs_paths( g, ( *ite ).to(), t, len + ( *ite ).edge_d(), von, vl );
+		}
+	}
+	von[u] = 0;
+}
+
+void test_eppstein( const char *name, const GT &g, int s, int k )
+{
+	CkspEppstein<GT, FW> ksp( g, s, k, FW(), 1 << 30 );
+	ksp.get_first();
+	for( int i = 1; i < k; ++i ) {
+		ksp.get_next();
+	}
+	vector<vector<int> > vl = k_lengths( g, s, k );
+	bool same = true, valid = true, distinct = true;
+	int npath = 0;
+	for( int t = 0; t < g.range(); ++t ) {
+		set<CPath> sp;
+		for( int i = 1; i <= k; ++i ) {
+			CPath lp;
+			int d = ksp.get_path( t, i, lp );
+			if( i > ( int )vl[t].size() ) {
+				same = same && d == 1 << 30 && lp.empty();
+				continue;
+			}
+			++npath;
+			same = same && d == vl[t][i - 1];
+			valid = valid && !lp.empty() && lp.front() == s && lp.back() == t && path_len( g, lp ) == d;
+			distinct = distinct && sp.insert( lp ).second;
+		}
+	}
+	cout << name << ": " << npath << " paths, same lengths " << same
+		 << ", valid " << valid << ", distinct " << distinct << endl;
+}
+
+int main()
+{
+	GT g( 200, -1 );
+	test_random_graph( g, 200, 800, 50, 3 );
+	test_eppstein( "k=20, weights [0, 49]", g, 0, 20 );
+	test_random_graph( g, 200, 500, 3, 4 );
+	test_eppstein( "k=30, weights [0, 2]", g, 5, 30 );
+	test_random_graph( g, 60, 120, 10, 7 );
+	test_eppstein( "k=10, sparse", g, 0, 10 );
+
+	// the graph of t_kthsp.cpp (both ways), against CkthSP
+	GT g2( 13, -1 );
+	for( int i = 0; i < 13; ++i ) {
+		g2.insert_v_ati( i, i );
+	}
+	const int e2[][3] = { { 0, 1, 20 }, { 0, 4, 15 }, { 0, 5, 20 }, { 1, 2, 30 }, { 1, 6, 10 },
+		{ 2, 3, 20 }, { 2, 7, 10 }, { 3, 7, 10 }, { 4, 6, 15 }, { 5, 6, 20 }, { 5, 9, 10 },
+		{ 6, 7, 10 }, { 6, 10, 10 }, { 7, 8, 10 }, { 7, 11, 20 }, { 9, 10, 10 },
+		{ 10, 11, 10 }, { 10, 12, 10 }
+	};
+	for( int i = 0; i < 18; ++i ) {
+		g2.insert_2e( e2[i][0], e2[i][1], e2[i][2] );
+	}
+	test_eppstein( "t_kthsp graph, k=7", g2, 0, 7 );
+	CkthSP<GT, FW> k0( g2, 0, 7, FW(), 1 << 30 );
+	CkspEppstein<GT, FW> k1( g2, 0, 7, FW(), 1 << 30 );
+	k0.get_first();
+	k1.get_first();
+	int nsame = 0;
+	for( int i = 1; i <= 7; ++i ) {
+		if( i > 1 ) {
+			k0.get_next();
+			k1.get_next();
+		}
+		for( int t = 0; t < g2.range(); ++t ) {
+			CPath lp;
+			nsame += k0.get_path( t, i, lp ) == k1.get_path( t, i, lp );
+		}
+		CPath lp;
+		int d = k1.get_path( 11, i, lp );
+		cout << "  " << i << ": " << lp << " " << d << endl;
+	}
+	cout << "  lengths the same as CkthSP: " << nsame << " of " << 7 * 13 << endl;
+
+	// Yen: all loopless paths of small graphs
+	bool sameY = true, validY = true;
+	int npath = 0;
+	for( int r = 0; r < 20; ++r ) {
+		GT gs( 12, -1 );
+		test_random_graph( gs, 12, 40, 10, 100 + r );
+		int s = r % 3, t = 12 - 1 - r % 4;
+		vector<char> von( 12, 0 );
+		vector<int> vl;
+		dfs_paths( gs, s, t, 0, von, vl );
+		sort( vl.begin(), vl.end() );
+		int k = 25;
+		CkspYen<GT, FW> yen( gs, s, t, k, FW(), 1 << 30 );
+		yen.get_first();
+		set<CPath> sp;
+		for( int i = 1; i <= k; ++i ) {
+			if( i > 1 ) {
+				yen.get_next();
+			}
+			CPath lp;
+			int d = yen.get_path( t, i, lp );
+			if( i > ( int )vl.size() ) {
+				sameY = sameY && d == 1 << 30 && lp.empty();
+				continue;
+			}
+			++npath;
+			sameY = sameY && d == vl[i - 1];
+			set<int> nodes( lp.begin(), lp.end() );
+			validY = validY && lp.front() == s && lp.back() == t && path_len( gs, lp ) == d
+					 && nodes.size() == lp.size() && sp.insert( lp ).second;
+		}
+	}
+	cout << "Yen: " << npath << " paths, same lengths " << sameY
+		 << ", valid, loopless and distinct " << validY << endl;
+
+	// small graph: cycles, source as destination, no path, wrong arguments
+	GT g3( 4, -1 );
+	for( int i = 0; i < 4; ++i ) {
+		g3.insert_v_ati( i, i );
+	}
+	g3.insert_e_byi( 0, 1, 1 );
+	g3.insert_e_byi( 1, 0, 2 );
+	g3.insert_e_byi( 1, 2, 5 );
+	g3.insert_e_byi( 1, 1, 1 );
+	CkspEppstein<GT, FW> k3( g3, 0, 4, FW(), 100 );
+	k3.get_first();
+	k3.get_next();
+	k3.get_next();
+	CPath lp;
+	for( int i = 1; i <= 3; ++i ) {
+		int d = k3.get_path( 2, i, lp );
+		cout << "to 2, " << i << ": " << lp << " " << d << "; ";
+		d = k3.get_path( 0, i, lp );
+		cout << "to 0: " << lp << " " << d << endl;
+	}
+	cout << "to 3: " << k3.get_path( 3, 1, lp ) << ", 4th before get_next( ): "
+		 << k3.get_path( 2, 4, lp ) << ", bad node " << k3.get_path( 7, 1, lp ) << endl;
+	CkspYen<GT, FW> y3( g3, 0, 2, 3, FW(), 100 );
+	y3.get_first();
+	y3.get_next();
+	cout << "Yen 0 to 2: " << y3.get_path( 2, 1, lp ) << " " << lp;
+	cout << ", 2nd: " << y3.get_path( 2, 2, lp ) << ", other node " << y3.get_path( 1, 1, lp ) << endl;
+	return 0;
+}
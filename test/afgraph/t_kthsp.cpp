@@ -201,5 +201,16 @@ int main()
 		 << path_length( gra3, lp, mem_fun( &T_d3Edge::weight1 ) )
 		 << endl << endl;
 
+	// a copy goes on by itself, on a thread pool of its own
+	CkthSP< T_d3Graph, const_mem_fun_t<double, T_d3Edge> > ksp2( ksp );
+	ksp.get_next();
+	ksp2.get_next();
+	CPath lp2;
+	double dretn2 = ksp2.get_path( 11, 9, lp2 );
+	dretn = ksp.get_path( 11, 9, lp );
+	cout << "9th sp from 0 to 11 by a copy: " << lp2 << ": " << dretn2
+		 << ", same as the original: " << ( lp == lp2 && dretn == dretn2 )
+		 << endl << endl;
+
 	return 0;
 }
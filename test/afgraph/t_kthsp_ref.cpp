@@ -0,0 +1,358 @@
+/*@copyright
+
+Copyright (c) 2012 Aiguo Fei
+All rights reserved.
+
+Permission to use and re-distribute this code in source and binary forms
+with or without modifications is therefore granted provided that
+the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Information regarding where to obtain the original source code must be
+      included with the redistrbution.
+
+*NO WARRANTY*
+THIS CODE OR PROGRAM IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S)
+"AS IS" WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE. THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S) MUST NOT BE
+HELD RESPONSIBLE FOR ANY DAMAGE OR UNDESIRED EFFECT CAUSED DIRECTLY OR
+INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
+
+*/
+
+
+
+
+/* t_kthsp_ref.cpp
+
+  regression test of CkthSP (kthsp.h) against its earlier version (kept
+  here as CkthSP_ref: all pairs of nodes looked up for each round) on the
+  topologies of this directory and a random graph, from a few sources,
+  with 1 and 3 threads. The earlier version, going through the nodes in
+  index order, read the kth path of a node of higher index before it was
+  computed; the paths are the same up to the first round in which it
+  missed one that way (and took a longer one). Lengths are checked
+  against CkspEppstein, 3 threads against 1, and a second run of the
+  same object (get_first( ) again) against the first.
+  Run from this directory.
+
+*/
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "afl/util_tl.hpp"
+
+#include "afgraph/graph.h"
+#include "afgraph/graph_input.h"
+#include "afgraph/kthsp.h"
+#include "afgraph/ksp.h"
+
+using namespace std;
+using namespace afg;
+
+typedef CGraph<int, int> GT;
+typedef afl::pointer2value<int> FW;
+
+// CkthSP as it was: V^2 table of edge uses, all pairs (i, j) each round
+template<class GraphT, class Fun >
+class CkthSP_ref
+{
+public:
+	/**
+	@param thegra graph on which to run the algorithm;
+	  a reference to that graph is kept internally, reference graph
+	  can't change before running to the ith path wanted (i<=k).
+	@param source source node
+	@param k desired kth
+	@param fw function object used to get edge weight, pass pointer
+	@param winfty an "upper bound" value of weight which should be larger
+		than the path length of any valid path; used to initialize distance
+		to all nodes.
+	*/
+	CkthSP_ref( const GraphT &thegra, int source, int k, Fun fw,
+			typename Fun::result_type winfty ):
+		m_gra( thegra ), m_nSource( source ), m_nK( k ),
+		f_Weight( fw ), m_wInfty( winfty ),
+		m_kCurrent( 0 ), m_nSize( thegra.range() ),
+		m_vDist( thegra.range()*( k + 1 ), winfty ),
+		m_vp( thegra.range()*thegra.range(), -1 ),
+		m_vPred( thegra.range()*( k + 1 ), -1 ),
+		m_vPath( thegra.range()*( k + 1 ) )
+
+	{ }
+
+	~CkthSP_ref()
+	{}
+
+	///
+	typedef typename Fun::result_type  WT;
+
+private:
+	const GraphT &m_gra;
+	int m_nSource;
+	int m_nK;
+	Fun f_Weight;
+	WT m_wInfty;
+
+private:
+	int m_kCurrent;
+	int m_nSize;
+	std::vector<WT> m_vDist;
+	std::vector<int> m_vp;
+	std::vector<int> m_vPred;
+	std::vector<CPath> m_vPath;
+
+public:
+
+	/** get the first shortest path.
+	    This should be the first function to call after constructor.
+	*/
+	void get_first( ) {
+		m_kCurrent = 1;
+		int k = m_kCurrent;
+		std::vector<WT> vd( m_nSize, m_wInfty );
+		std::vector<int> vpred( m_nSize, -1 );
+		dijkstra<GraphT, Fun>( m_gra, m_nSource, f_Weight, m_wInfty, vpred, vd );
+		m_vDist[m_nSource] = ( WT )0;
+		int i, j;
+		for( i = 0; i < m_nSize; i++ )
+			for( j = 0; j < m_nSize; j++ ) {
+				m_vp[m_nSize *i+j] = 0;
+			}
+
+		for( j = 0; j < m_nSize; j++ ) {
+			m_vDist[m_nSize *k+j] = vd[j];
+			if( vpred[j] >= 0 ) {
+				m_vp[m_nSize *vpred[j] + j] = 1;
+				m_vPred[m_nSize *k+j] = vpred[j];
+			}
+		}
+
+		for( j = 0; j < m_nSize; j++ ) {
+			pred2path( vpred, m_nSource, j, m_vPath[m_nSize*k+j] );
+		}
+	}
+
+	/// call this one to compute the next shortest path (from ith to (i+1)th ).
+	void get_next( ) {
+		m_kCurrent++;
+		if( m_kCurrent > m_nK ) {
+			m_kCurrent--;
+			return ;
+		}
+
+		int i, j, k = m_kCurrent;
+		const typename GraphT::EDT *pedg;
+
+		//cerr<<"k="<<k<<endl;
+
+		for( j = 0; j < m_nSize; j++ ) {
+			//bool isupdated=false;
+			for( i = 0; i < m_nSize; i++ ) {
+				if( i != j ) {
+					if(( pedg = m_gra.get_edge( i, j ) ) ) {
+						int k2 = m_vp[m_nSize*i+j] + 1;
+
+						//cerr<<j<<": "<<m_vDist[ m_nSize*k+j]<<", i="<<i<<", k2="<<k2<<", "
+						//<<m_vDist[ m_nSize*k2 +i ]<<", w="<<f_Weight( pedg)<<endl;
+
+						if( m_vDist[ m_nSize*k+j]
+							> m_vDist[ m_nSize*k2 +i ] + f_Weight( pedg ) ) {
+							m_vDist[ m_nSize *k+j] = m_vDist[ m_nSize*k2 +i ] + f_Weight( pedg ) ;
+							m_vPath[ m_nSize *k+j] = m_vPath[m_nSize*k2+i];
+							m_vPath[ m_nSize*k+j].push_back( j );
+							m_vPred[ m_nSize *k+j] = i;
+							//isupdated=true;
+
+							//cerr<<"update to "<<i<<", "<<m_vDist[ m_nSize*k+j]<<endl;
+
+						}
+					}
+
+				}
+			}// for (i)
+		}// for( j)
+
+		// update m_vp
+		for( j = 0; j < m_nSize; j++ )
+			if( m_vPred[m_nSize *k+j] >= 0 ) {
+				m_vp[ m_nSize*m_vPred[m_nSize*k+j] + j]++;
+			}
+	}
+
+	/** return the ith shortest path to node nt.
+		get_next( ) should have been already called (nk-1) times.
+	@param nt destination node
+	@param nk the nkth shortest-path to nt
+	@param lp the path retrieved
+	@return the total "weight" (distance) of the path
+	*/
+	WT get_path( int nt, int nk, CPath &lp ) {
+		if( nt < 0 || nt >= m_nSize || nk < 1 || nk > m_nK || nk > m_kCurrent ) {
+			lp.clear();
+			return m_wInfty;
+		}
+
+		lp = m_vPath[ m_nSize*nk+nt];
+		return m_vDist[ m_nSize*nk+nt];
+	}
+
+	/// increase k value to newk, no effect if newk<=old k
+	bool increase_k( int newk ) {
+		if( newk <= m_nK ) {
+			return true;
+		}
+
+		m_vDist.resize( m_nSize*( newk + 1 ), m_wInfty );
+		if(( int )m_vDist.size() < m_nSize*( newk + 1 ) ) {
+			return false;    // failed to allocate additional memory
+		}
+
+		m_vPath.resize( m_nSize*( newk + 1 ) );
+		if(( int )m_vPath.size() < m_nSize*( newk + 1 ) ) {
+			return false;
+		}
+
+		m_vPred.resize( m_nSize*( newk + 1 ), -1 );
+		if(( int )m_vPred.size() < m_nSize*( newk + 1 ) ) {
+			return false;
+		}
+
+		m_nK = newk;
+		return true;
+	}
+
+};
+
+// a graph with the same edges whose vertex values are the indices (the
+// earlier version looked edges up by value)
+template<class GraphT>
+void int_graph( const GraphT &g, GT &gi )
+{
+	gi.clear();
+	for( int i = 0; i < g.range(); ++i ) {
+		gi.insert_v_ati( i, i );
+	}
+	for( int i = 0; i < g.range(); ++i ) {
+		typename GraphT::const_e_iterator ite;
+		for( ite = g[i].begin(); ite != g[i].end(); ++ite ) {
+			gi.insert_e_byi( i, ( *ite ).to(), ( *ite ).edge_d() );
+		}
+	}
+}
+
+// rounds the same as the earlier version until it missed a path; from
+// then on it takes other paths
+void compare( const char *name, const GT &g, int k )
+{
+	int nround = 0, nsame = 0, npath = 0;
+	bool bright = true, bmissed = true, brerun = true;
+	for( int s = 0; s < g.range(); s += g.range() / 3 + 1 ) {
+		CkthSP_ref<GT, FW> k0( g, s, k, FW(), 1 << 30 );
+		CkthSP<GT, FW> k1( g, s, k, FW(), 1 << 30, 1 );
+		CkthSP<GT, FW> k3( g, s, k, FW(), 1 << 30, 3 );
+		CkspEppstein<GT, FW> ke( g, s, k, FW(), 1 << 30 );
+		k0.get_first();
+		k1.get_first();
+		k3.get_first();
+		ke.get_first();
+		bool bsame = true;
+		vector<int> vd1;
+		vector<CPath> vl1;
+		for( int i = 1; i <= k; ++i ) {
+			if( i > 1 ) {
+				k0.get_next();
+				k1.get_next();
+				k3.get_next();
+				ke.get_next();
+			}
+			bool bround = true, blonger = false, bshorter = false;
+			for( int t = 0; t < g.range(); ++t ) {
+				CPath l0, l1, l3, le;
+				int d0 = k0.get_path( t, i, l0 ), d1 = k1.get_path( t, i, l1 );
+				int d3 = k3.get_path( t, i, l3 ), de = ke.get_path( t, i, le );
+				vd1.push_back( d1 );
+				vl1.push_back( l1 );
+				bright = bright && d1 == de && d3 == d1 && l3 == l1;
+				npath += d1 < ( 1 << 30 );
+				bround = bround && d0 == d1 && l0 == l1;
+				blonger = blonger || d1 < d0;
+				bshorter = bshorter || d0 < d1;
+			}
+			++nround;
+			if( bsame && bround ) {
+				++nsame;
+			} else if( bsame ) {
+				// the first round that differs: some path missed, none shorter
+				bmissed = bmissed && blonger && !bshorter;
+				bsame = false;
+			}
+		}
+		// run again on the same object
+		k1.get_first();
+		for( int i = 1, x = 0; i <= k; ++i ) {
+			if( i > 1 ) {
+				k1.get_next();
+			}
+			for( int t = 0; t < g.range(); ++t, ++x ) {
+				CPath l1;
+				int d1 = k1.get_path( t, i, l1 );
+				brerun = brerun && d1 == vd1[x] && l1 == vl1[x];
+			}
+		}
+	}
+	cout << name << ": " << npath << " paths, lengths right " << bright << ", rounds the same as before "
+		 << nsame << " of " << nround << ", then a path missed before " << bmissed
+		 << ", same on a rerun " << brerun << endl;
+}
+
+int main()
+{
+	GT gi( 16, -1 );
+	{
+		ifstream fs( "gra2.vie" );
+		GT g( 5, -1 );
+		input_gra_vie( g, fs );
+		int_graph( g, gi );
+		compare( "gra2.vie, k=10", gi, 10 );
+	}
+	{
+		ifstream fs( "indn_edcnet.vie" );
+		CGraph<string, int> g( 31, "null" );
+		input_gra_vie( g, fs );
+		int_graph( g, gi );
+		compare( "indn_edcnet.vie, k=10", gi, 10 );
+	}
+	const char *files[] = { "mbone-us-199405.vve", "mbone-all-199405.vve" };
+	for( int f = 0; f < 2; ++f ) {
+		ifstream fs( files[f] );
+		CGraph<string, int> g( 84, "null" );
+		input_gra_vve< CGraph<string, int>, string>( g, fs );
+		int_graph( g, gi );
+		string name = string( files[f] ) + ", k=10";
+		compare( name.c_str(), gi, 10 );
+	}
+	GT g( 120, -1 );
+	for( int i = 0; i < 120; ++i ) {
+		g.insert_v_ati( i, i );
+	}
+	unsigned long long r = 7;
+	for( int q = 0; q < 480; ++q ) {
+		r = r * 6364136223846793005ULL + 1442695040888963407ULL;
+		int u = ( int )(( r >> 33 ) % 120 );
+		r = r * 6364136223846793005ULL + 1442695040888963407ULL;
+		int v = ( int )(( r >> 33 ) % 120 );
+		if( u != v ) {
+			g.insert_e_byi( u, v, ( int )(( r >> 20 ) % 20 ) );
+		}
+	}
+	compare( "random, 120 nodes, weights [0, 19], k=20", g, 20 );
+	return 0;
+}
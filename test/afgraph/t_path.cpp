@@ -28,7 +28,7 @@ INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
 
 /* t_path.cpp
 
-  test CPath defined in path.h
+  test CPath and CPathStore defined in path.h
 
   Aiguo Fei
 
@@ -65,5 +65,21 @@ int main()
 	std::cout << "pred2path result: " << afg::pred2path( vpred, 0, 4, p )
 			  << ", " << p << std::endl;
 
+	// paths extending each other
+	afg::CPathStore ps;
+	int a = ps.add( p );
+	int b = ps.extend( a, 7 );
+	int c = ps.extend( ps.extend( a, 8 ), 9 );
+	int d = ps.extend( -1, 6 );
+	ps.get( b, p );
+	std::cout << "CPathStore, " << ps.size() << " paths: " << p;
+	ps.get( c, p );
+	std::cout << "| " << p << "(last " << ps.last( c ) << ", prefix ends with "
+			  << ps.last( ps.prefix( c ) ) << ")";
+	ps.get( d, p );
+	std::cout << " | " << p << "| " << ps.add( CPath() ) << " ";
+	ps.get( -1, p );
+	std::cout << p.size() << std::endl;
+
 	return 0;
 }
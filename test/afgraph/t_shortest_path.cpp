@@ -39,21 +39,65 @@ INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
 */
 
 #include <iostream>
+#include <sstream>
 #include <vector>
 #include <functional>
+#include <stdexcept>
 
 #include "afl/util_tl.hpp"
+#include "afl/indexed_heap.hpp"
 
 #include "afgraph/edge.h"
 #include "afgraph/path.h"
 #include "afgraph/graph.h"
 #include "afgraph/graph_alg.h"
 #include "afgraph/shortest_path.h"
+#include "afgraph/rtree.h"
+#include "afgraph/tree_alg.h"
+
+#include "test_util.h"
 
 using namespace std;
 using namespace afl;
 using namespace afg;
 
+// edge weight plus one: weights within [1, maxw]
+struct plus_one {
+	typedef int result_type;
+	int operator()( const int *pe ) const {
+		return *pe + 1;
+	}
+};
+
+// edge weight as double: weights within [0.25, maxw / 4], sums exact
+struct quarter_w {
+	typedef double result_type;
+	double operator()( const int *pe ) const {
+		return ( *pe + 1 ) / 4.0;
+	}
+};
+
+// pred[i*n+j] on a shortest path from i to j, for all reachable i != j
+template<class WeightT>
+bool valid_pred( int n, WeightT w_infty, const vector<int> &pred,
+				 const vector<WeightT> &dist )
+{
+	for( int i = 0; i < n; ++i ) {
+		for( int j = 0; j < n; ++j ) {
+			size_t ij = ( size_t )i * n + j;
+			if( i == j || !( dist[ij] < w_infty ) ) {
+				continue;
+			}
+			int p = pred[ij];
+			if( p < 0 || p >= n || p == j || dist[( size_t )i * n + p]
+					+ dist[( size_t )p * n + j] != dist[ij] ) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
 int main()
 {
 	CGraph<char, int> gra2( 4, 'z' );
@@ -117,5 +161,393 @@ int main()
 	copy( vadist.begin(), vadist.end(), ostream_iterator<int>( std::cout, " " ) );
 	cout << endl;
 
+	// indexed_heap: ties come out last pushed first, as with sorted_list
+	indexed_heap<int> hp( 6 );
+	hp.push( 0, 5 );
+	hp.push( 1, 3 );
+	hp.push( 2, 5 );
+	hp.push( 3, 3 );
+	hp.push( 4, 9 );
+	hp.push( 4, 3 );	// decrease-key
+	hp.push( 2, 7 );	// increase
+	cout << "heap order:";
+	while( !hp.empty() ) {
+		cout << " " << hp.top() << "(" << hp.top_key() << ")";
+		hp.pop();
+	}
+	cout << endl;
+
+	// all queues of dijkstra give the same pred and dist as dijkstra_sl( ),
+	// with many ties (small weights) and zero weight edges
+	int maxws[] = { 1, 2, 5, 1000, 1000000 };
+	for( int k = 0; k < 5; ++k ) {
+		CGraph<int, int> g( 300, -1 );
+		test_random_graph( g, 300, 1200, maxws[k], 17 + k, false );
+		bool same = true, same_d = true, same_r = true, same_h = true;
+		int nreach = 0;
+		for( int s = 0; s < g.range(); ++s ) {
+			vector<int> p0, d0, p1, d1;
+			bool b0 = dijkstra_sl( g, s, afl::pointer2value<int>(), 1 << 30, p0, d0 );
+			bool b1 = dijkstra( g, s, afl::pointer2value<int>(), 1 << 30, p1, d1 );
+			same = same && b0 == b1 && p0 == p1 && d0 == d1;
+			dijkstra_heap( g, s, afl::pointer2value<int>(), 1 << 30, p1, d1 );
+			same_h = same_h && ( !b0 || ( p0 == p1 && d0 == d1 ) );
+			if( maxws[k] <= dial_max_weight ) {
+				dijkstra_dial( g, s, afl::pointer2value<int>(), 1 << 30, p1, d1, maxws[k] );
+				same_d = same_d && ( !b0 || ( p0 == p1 && d0 == d1 ) );
+			}
+			dijkstra_radix( g, s, afl::pointer2value<int>(), 1 << 30, p1, d1 );
+			same_r = same_r && ( !b0 || ( p0 == p1 && d0 == d1 ) );
+			if( b0 ) {
+				nreach += ( int )( d0.size() - count( d0.begin(), d0.end(), 1 << 30 ) );
+			}
+		}
+		cout << "weights [0, " << maxws[k] - 1 << "]: same as sorted_list: dijkstra "
+			 << same << ", heap " << same_h << ", dial " << same_d << ", radix "
+			 << same_r << ", reached " << nreach << endl;
+	}
+
+	// keys out of range of the monotone queues: a weight above the bound of
+	// Dial's buckets, a negative weight (dijkstra( ) takes the heap then)
+	{
+		CGraph<int, int> g( 300, -1 );
+		test_random_graph( g, 300, 1200, 20, 41, false );
+		vector<int> p0, d0, p1, d1;
+		bool bdial = false, bradix = false;
+		try {
+			dijkstra_dial( g, 0, afl::pointer2value<int>(), 1 << 30, p1, d1, 5 );
+		} catch( std::out_of_range & ) {
+			bdial = true;
+		}
+		g.insert_e_byi( 1, 2, -3 );
+		try {
+			dijkstra_radix( g, 0, afl::pointer2value<int>(), 1 << 30, p1, d1 );
+		} catch( std::out_of_range & ) {
+			bradix = true;
+		}
+		dijkstra_heap( g, 0, afl::pointer2value<int>(), 1 << 30, p0, d0 );
+		bool b = dijkstra( g, 0, afl::pointer2value<int>(), 1 << 30, p1, d1 );
+		cout << "out of range: dial throws " << bdial << ", radix throws " << bradix
+			 << ", negative weight same as heap " << ( b && p0 == p1 && d0 == d1 ) << endl;
+	}
+
+	// hop count: unit weights, runit_p
+	{
+		CGraph<int, int> g( 300, -1 );
+		test_random_graph( g, 300, 900, 1, 5, false );
+		bool same = true;
+		for( int s = 0; s < g.range(); ++s ) {
+			vector<int> p0, d0, p1, d1;
+			dijkstra_sl( g, s, afl::runit_p<int>(), 1 << 30, p0, d0 );
+			dijkstra( g, s, afl::runit_p<int>(), 1 << 30, p1, d1 );
+			same = same && p0 == p1 && d0 == d1;
+		}
+		cout << "hop count: same " << same << endl;
+	}
+
+	// double weights go to the heap, a negative int weight too
+	{
+		CGraph<int, double> g( 4, -1 );
+		for( int i = 0; i < 4; ++i ) {
+			g.insert_v( i );
+		}
+		g.insert_e( 0, 1, 0.5 );
+		g.insert_e( 0, 2, 2.5 );
+		g.insert_e( 1, 2, 1.5 );
+		g.insert_e( 2, 3, 0.25 );
+		vector<int> p0;
+		vector<double> d0;
+		dijkstra( g, 0, afl::pointer2value<double>(), 100.0, p0, d0 );
+		cout << "double:";
+		for( int i = 0; i < 4; ++i ) {
+			cout << " " << i << ": " << d0[i] << ", " << p0[i] << ";";
+		}
+		cout << endl;
+		CGraph<int, int> gn( 4, -1 );
+		for( int i = 0; i < 4; ++i ) {
+			gn.insert_v( i );
+		}
+		gn.insert_e( 0, 1, 4 );
+		gn.insert_e( 0, 2, 2 );
+		gn.insert_e( 1, 2, -3 );
+		gn.insert_e( 2, 3, 1 );
+		vector<int> p1, d1, p2, d2;
+		dijkstra_sl( gn, 0, afl::pointer2value<int>(), 100, p1, d1 );
+		dijkstra( gn, 0, afl::pointer2value<int>(), 100, p2, d2 );
+		cout << "negative weight: same " << ( p1 == p2 && d1 == d2 ) << ", dist to 3: "
+			 << d2[3] << endl;
+	}
+
+	// point to point: early exit gives the same path as a full search,
+	// bidirectional the same length; backward over the in-edge index or
+	// over a transposed copy
+	{
+		CGraph<int, int> g( 300, -1 );
+		test_random_graph( g, 300, 1000, 20, 99, false );
+		CGraph<int, int> gi( g );
+		gi.enable_in_index();
+		CspReverse<CGraph<int, int>, afl::pointer2value<int> > rt( g, afl::pointer2value<int>() );
+		CspReverse<CGraph<int, int>, afl::pointer2value<int> > ri( gi, afl::pointer2value<int>() );
+		cout << "reverse: transposed " << rt.transposed() << ", " << ri.transposed() << endl;
+		bool same_e = true, same_b = true, same_bi = true, valid = true;
+		long nset[3] = { 0, 0, 0 };
+		int npath = 0;
+		for( int s = 0; s < g.range(); s += 7 ) {
+			for( int t = 0; t < g.range(); t += 5 ) {
+				CPath l0, l1, l2, l3;
+				int ns0, ns1, ns2;
+				int d0 = dijkstra_t( g, s, t, afl::pointer2value<int>(), 1 << 30, l0,
+									 sp_options(), &ns0 );
+				int d1 = dijkstra_t( g, s, t, afl::pointer2value<int>(), 1 << 30, l1,
+									 sp_options::sp_early_exit, &ns1 );
+				int d2 = dijkstra_t( g, s, t, afl::pointer2value<int>(), 1 << 30, l2,
+									 sp_options::sp_bidirectional, &ns2 );
+				int d3 = dijkstra_bidir( gi, s, t, afl::pointer2value<int>(), 1 << 30, l3, ri );
+				same_e = same_e && d0 == d1 && l0 == l1;
+				same_b = same_b && d0 == d2 && l0.empty() == l2.empty();
+				same_bi = same_bi && d0 == d3 && l0.empty() == l3.empty();
+				if( !l2.empty() ) {
+					++npath;
+					// the path is there and is that long
+					int len = 0;
+					CPath::iterator it = l2.begin(), inext = it;
+					for( ++inext; inext != l2.end(); ++it, ++inext ) {
+						const int *pe = g.get_edge_byi( *it, *inext );
+						len += pe ? *pe : 1 << 30;
+					}
+					valid = valid && l2.front() == s && l2.back() == t && len == d2;
+				}
+				nset[0] += ns0;
+				nset[1] += ns1;
+				nset[2] += ns2;
+			}
+		}
+		cout << "point to point: " << npath << " paths, early exit same " << same_e
+			 << ", bidirectional same length " << same_b << ", " << same_bi
+			 << ", paths valid " << valid << endl
+			 << "  settled: full " << nset[0] << ", early exit " << nset[1]
+			 << ", bidirectional " << nset[2] << endl;
+		CPath lp;
+		cout << "bidirectional 0->0: " << dijkstra_bidir( g, 0, 0, afl::pointer2value<int>(), 1 << 30, lp )
+			 << " " << lp << ", to removed node: "
+			 << dijkstra_bidir( g, 0, 3, afl::pointer2value<int>(), 1 << 30, lp )
+			 << " " << lp.size() << endl;
+	}
+
+	// one workspace for many searches: same results as new vectors each
+	// time, whatever the search before (full, early exit, bidirectional,
+	// another w_infty); Dial's buckets, radix heap, and a heap (double)
+	{
+		const int maxws[2] = { 20, 100000 };
+		for( int k = 0; k < 2; ++k ) {
+			CGraph<int, int> g( 300, -1 );
+			test_random_graph( g, 300, 1000, maxws[k], 5 + k, false );
+			CSPWorkspace<int> ws;
+			bool same = true, same_t = true, reached = true;
+			long ntouched = 0;
+			for( int q = 0; q < 120; ++q ) {
+				int s = ( q * 37 ) % g.range(), t = ( q * 53 + 11 ) % g.range();
+				int winf = q % 3 == 2 ? 1 << 29 : 1 << 30;
+				vector<int> p0;
+				vector<int> d0;
+				bool b0 = dijkstra( g, s, afl::pointer2value<int>(), winf, p0, d0 );
+				bool b1 = dijkstra( g, s, afl::pointer2value<int>(), winf, ws );
+				same = same && b0 == b1 && ( !b0 || ( p0 == ws.pred() && d0 == ws.dist() ) );
+				if( b1 ) {
+					reached = reached && ( int )ws.touched().size()
+							  == ( int )( d0.size() - std::count( d0.begin(), d0.end(), winf ) );
+					ntouched += ws.touched().size();
+				}
+				// leave a partial search behind for the next round
+				CPath l0, l1;
+				sp_options::mode_type m = q % 2 ? sp_options::sp_early_exit : sp_options::sp_bidirectional;
+				int dt0 = dijkstra_t( g, s, t, afl::pointer2value<int>(), winf, l0, m );
+				int dt1 = dijkstra_t( g, s, t, afl::pointer2value<int>(), winf, l1, ws, m );
+				same_t = same_t && dt0 == dt1 && l0 == l1;
+			}
+			cout << "workspace, weights [0, " << maxws[k] - 1 << "]: same " << same
+				 << ", point to point same " << same_t << ", touched = reached " << reached
+				 << ", " << ntouched << " touched" << endl;
+		}
+
+		// weights changed after the workspace picked Dial's buckets: above
+		// their range, then negative; the search starts over with a queue
+		// that takes them
+		CGraph<int, int> gw( 4, -1 );
+		for( int i = 0; i < 4; ++i ) {
+			gw.insert_v_ati( i, i );
+		}
+		gw.insert_e_byi( 0, 1, 2 );
+		gw.insert_e_byi( 0, 2, 3 );
+		gw.insert_e_byi( 2, 3, 1 );
+		gw.insert_e_byi( 1, 3, 5 );
+		CSPWorkspace<int> wsw;
+		dijkstra( gw, 0, afl::pointer2value<int>(), 1 << 30, wsw );
+		cout << "workspace, weights changed: " << wsw.dist()[3];
+		*gw.get_edge_byi( 0, 1 ) = 8;
+		*gw.get_edge_byi( 1, 3 ) = 1;
+		gw.remove_e_byi( 0, 2 );
+		dijkstra( gw, 0, afl::pointer2value<int>(), 1 << 30, wsw );
+		cout << ", " << wsw.dist()[3];
+		*gw.get_edge_byi( 1, 3 ) = -4;
+		dijkstra( gw, 0, afl::pointer2value<int>(), 1 << 30, wsw );
+		cout << ", " << wsw.dist()[3] << endl;
+
+		CGraph<int, double> gd( 10, -1 );
+		for( int i = 0; i < 10; ++i ) {
+			gd.insert_v_ati( i, i );
+		}
+		for( int i = 0; i < 10; ++i ) {
+			gd.insert_e_byi( i, ( i + 1 ) % 10, 1.5 );
+			gd.insert_e_byi( i, ( i + 3 ) % 10, 4.0 );
+		}
+		CSPWorkspace<double> wsd;
+		bool same = true;
+		for( int s = 0; s < 10; ++s ) {
+			vector<int> p0;
+			vector<double> d0;
+			dijkstra( gd, s, afl::pointer2value<double>(), 1e10, p0, d0 );
+			int ns = 0;
+			dijkstra( gd, ( s + 5 ) % 10, afl::pointer2value<double>(), 1e10, wsd, s, &ns );
+			dijkstra( gd, s, afl::pointer2value<double>(), 1e10, wsd );
+			same = same && p0 == wsd.pred() && d0 == wsd.dist();
+		}
+		cout << "workspace, double: same " << same << endl;
+
+		// sptree with a workspace; after clear( ) on another graph
+		CGraph<int, int> g( 300, -1 );
+		test_random_graph( g, 300, 1000, 20, 5, false );
+		CSPWorkspace<int> ws;
+		bool same_tr = true;
+		for( int s = 0; s < 60; s += 7 ) {
+			CrTree<int, int> t0( g.range(), -1 ), t1( g.range(), -1 );
+			sptree_all_s( g, s, t0, afl::pointer2value<int>(), 1 << 30 );
+			sptree_all_s( g, s, t1, afl::pointer2value<int>(), 1 << 30, ws );
+			ostringstream os0, os1;
+			os0 << t0;
+			os1 << t1;
+			same_tr = same_tr && os0.str() == os1.str();
+		}
+		test_random_graph( g, 200, 600, 5000, 8, false );
+		ws.clear();
+		vector<int> p0;
+		vector<int> d0;
+		dijkstra( g, 1, afl::pointer2value<int>(), 1 << 30, p0, d0 );
+		dijkstra( g, 1, afl::pointer2value<int>(), 1 << 30, ws );
+		cout << "workspace: sptree same " << same_tr << ", after clear( ) same "
+			 << ( p0 == ws.pred() && d0 == ws.dist() ) << ", invalid source "
+			 << dijkstra( g, 3, afl::pointer2value<int>(), 1 << 30, ws ) << endl;
+	}
+
+	// all pairs by parallel Dijkstra: same as Floyd-Warshall, also where
+	// paths tie (hop count, small weights), with self loops and removed
+	// nodes; zero weights: same distances
+	{
+		const int maxws[4] = { 1, 3, 1000, 4 };
+		for( int k = 0; k < 4; ++k ) {
+			CGraph<int, int> g( 150, -1 );
+			test_random_graph( g, 150, 600, maxws[k], 11 + k, false );
+			g.insert_e_byi( 5, 5, 2 );
+			g.insert_e_byi( 6, 6, 100 );
+			bool same = true, same_d = true;
+			vector<int> p0, d0;
+			if( k < 3 ) {
+				floyd_warshall_allsp( g, plus_one(), 1 << 20, p0, d0 );
+			} else {
+				floyd_warshall_allsp( g, afl::pointer2value<int>(), 1 << 20, p0, d0 );
+			}
+			for( int nt = 1; nt <= 4; nt *= 2 ) {
+				vector<int> p1, d1;
+				bool b = k < 3 ? dijkstra_allsp( g, plus_one(), 1 << 20, p1, d1, nt )
+						 : dijkstra_allsp( g, afl::pointer2value<int>(), 1 << 20, p1, d1, nt );
+				same = same && b && p0 == p1 && d0 == d1;
+				same_d = same_d && b && d0 == d1;
+			}
+			int n = g.range();
+			cout << "all pairs, weights [" << ( k < 3 ? 1 : 0 ) << ", " << maxws[k] - ( k < 3 ? 0 : 1 )
+				 << "]: ";
+			if( k < 3 ) {
+				cout << "same as floyd_warshall_allsp " << same << ", ";
+			}
+			cout << "same distances " << same_d
+				 << ", self loops " << d0[5 * n + 5] << "/" << p0[5 * n + 5] << " "
+				 << d0[6 * n + 6] << "/" << p0[6 * n + 6] << endl;
+		}
+	}
+
+	// blocked Floyd-Warshall: same distances over several (and partial)
+	// tiles, predecessors on shortest paths; in one tile, same as
+	// floyd_warshall_allsp
+	{
+		const int ns[3] = { 50, 64, 200 };
+		for( int k = 0; k < 3; ++k ) {
+			CGraph<int, int> g( ns[k], -1 );
+			test_random_graph( g, ns[k], 4 * ns[k], 20, 21 + k, false );
+			int n = g.range();
+			vector<int> p0, d0, pq0;
+			vector<double> dd0;
+			floyd_warshall_allsp( g, plus_one(), 1 << 20, p0, d0 );
+			floyd_warshall_allsp( g, quarter_w(), 1e9, pq0, dd0 );
+			bool same = true, same_p = true, valid = true;
+			for( int nt = 1; nt <= 4; nt *= 3 ) {
+				vector<int> p1, d1, pq1;
+				vector<double> dd1;
+				bool b = floyd_warshall_blocked( g, plus_one(), 1 << 20, p1, d1, nt )
+						 && floyd_warshall_blocked( g, quarter_w(), 1e9, pq1, dd1, nt );
+				same = same && b && d0 == d1 && dd0 == dd1;
+				same_p = same_p && b && p0 == p1 && pq0 == pq1;
+				valid = valid && b && valid_pred( n, 1 << 20, p1, d1 )
+						&& valid_pred( n, 1e9, pq1, dd1 );
+			}
+			cout << "blocked Floyd-Warshall, " << n << " nodes: same distances "
+				 << same << ", valid predecessors " << valid;
+			if( n <= fw_block ) {
+				cout << ", same predecessors " << same_p;
+			}
+			cout << endl;
+		}
+	}
+
+	// batch of pairs: same paths as one dijkstra_t( ) per pair, in input
+	// order, on one thread and on several; pairs repeat and share sources,
+	// some have a removed node (no path) or a node to itself
+	{
+		CGraph<int, int> g( 300, -1 );
+		test_random_graph( g, 300, 1200, 20, 31, false );
+		vector< pair<int, int> > pairs;
+		unsigned long long r = 5;
+		for( int q = 0; q < 400; ++q ) {
+			r = r * 6364136223846793005ULL + 1442695040888963407ULL;
+			int s = ( int )(( r >> 33 ) % 12 ) * 7;
+			r = r * 6364136223846793005ULL + 1442695040888963407ULL;
+			pairs.push_back( make_pair( s, ( int )(( r >> 33 ) % 300 ) ) );
+		}
+		pairs.push_back( make_pair( 10, 10 ) );
+		pairs.push_back( make_pair( 3, 10 ) );
+		pairs.push_back( make_pair( 10, 3 ) );
+		pairs.push_back( make_pair( 10, 300 ) );
+		CSPWorkspace<int> ws;
+		vector<CPath> vp0( pairs.size() );
+		vector<int> vd0( pairs.size() );
+		int nfound0 = 0;
+		for( size_t q = 0; q < pairs.size(); ++q ) {
+			vd0[q] = dijkstra_t( g, pairs[q].first, pairs[q].second, afl::pointer2value<int>(),
+								 1 << 30, vp0[q], ws, sp_options::sp_early_exit );
+			nfound0 += vd0[q] < ( 1 << 30 );
+		}
+		bool same = true;
+		int nfound = 0;
+		for( int nt = 1; nt <= 3; nt += 2 ) {
+			vector<CPath> vp;
+			vector<int> vd;
+			nfound = dijkstra_batch( g, afl::pointer2value<int>(), 1 << 30, pairs, vp, vd, nt );
+			same = same && nfound == nfound0 && vp == vp0 && vd == vd0;
+		}
+		size_t q = pairs.size() - 4;
+		cout << "batch, " << pairs.size() << " pairs: " << nfound << " paths, same as dijkstra_t "
+			 << same << ", " << vd0[q] << " [" << vp0[q] << "] " << vd0[q + 1] << " "
+			 << vd0[q + 2] << " " << vd0[q + 3] << endl;
+	}
+
 	return 0;
 }
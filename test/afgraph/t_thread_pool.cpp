@@ -0,0 +1,96 @@
+/*@copyright
+
+Copyright (c) 2012 Aiguo Fei
+All rights reserved.
+
+Permission to use and re-distribute this code in source and binary forms
+with or without modifications is therefore granted provided that
+the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Information regarding where to obtain the original source code must be
+      included with the redistrbution.
+
+*NO WARRANTY*
+THIS CODE OR PROGRAM IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S)
+"AS IS" WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE. THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S) MUST NOT BE
+HELD RESPONSIBLE FOR ANY DAMAGE OR UNDESIRED EFFECT CAUSED DIRECTLY OR
+INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
+
+*/
+
+
+/* t_thread_pool.cpp
+
+  test afl::thread_pool (afl/thread_pool.hpp): every iteration runs once,
+  on a valid thread number, exceptions are passed on, a pool can run
+  loop after loop.
+
+*/
+
+#include <iostream>
+#include <vector>
+#include <stdexcept>
+#include <mutex>
+
+#include "afl/thread_pool.hpp"
+
+using namespace std;
+
+int main()
+{
+	const int nthreads[] = { 1, 2, 4 };
+	for( int k = 0; k < 3; ++k ) {
+		afl::thread_pool pool( nthreads[k] );
+		bool once = true, tvalid = true;
+		for( int round = 0; round < 20; ++round ) {
+			int n = 1000 + round * 37;
+			vector<int> vcount( n, 0 );
+			vector<long> vsum( pool.size(), 0 );
+			pool.parallel_for( n, [&]( int i, int t ) {
+				++vcount[i];
+				if( t < 0 || t >= pool.size() ) {
+					tvalid = false;
+				} else {
+					vsum[t] += i;
+				}
+			}, round % 4 + 1 );
+			long sum = 0;
+			for( int t = 0; t < pool.size(); ++t ) {
+				sum += vsum[t];
+			}
+			for( int i = 0; i < n; ++i ) {
+				once = once && vcount[i] == 1;
+			}
+			once = once && sum == ( long )n * ( n - 1 ) / 2;
+		}
+
+		string err;
+		try {
+			pool.parallel_for( 100, [&]( int i, int ) {
+				if( i == 42 ) {
+					throw runtime_error( "iteration 42" );
+				}
+			} );
+		} catch( runtime_error &e ) {
+			err = e.what();
+		}
+		int nafter = 0;
+		pool.parallel_for( 10, [&]( int, int ) {
+			static std::mutex m;
+			std::lock_guard<std::mutex> lk( m );
+			++nafter;
+		} );
+		cout << "threads " << pool.size() << ": each iteration once " << once
+			 << ", thread numbers valid " << tvalid << ", exception \"" << err
+			 << "\", loop after it " << nafter << endl;
+	}
+	afl::thread_pool pool0;
+	cout << "default pool has threads: " << ( pool0.size() >= 1 ) << endl;
+	return 0;
+}
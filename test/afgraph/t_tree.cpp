@@ -28,6 +28,7 @@ INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
 
 
 #include <iostream>
+#include <vector>
 
 #include "afgraph/rtree.h"
 
@@ -65,5 +66,31 @@ int main( void )
 	tree0.copy_vertices(( CrTree<int, double>::GT )tree2 );
 	cout << "tree0: " << endl << tree0 << endl;
 
+	// pack: parents and root follow the remap table
+	CrTree<int, double> tree3( 8, -1 );
+	for( int i = 0; i < 8; ++i ) {
+		tree3.insert_v( 200 + i );
+	}
+	tree3.insert_e( 203, 201, 1.0 );
+	tree3.insert_e( 203, 205, 2.0 );
+	tree3.insert_e( 205, 206, 3.0 );
+	tree3.insert_e( 205, 207, 4.0 );
+	tree3.root() = 3;
+	tree3.remove_v( 200 );
+	tree3.remove_v( 202 );
+	tree3.remove_v( 204 );
+	vector<int> vremap;
+	tree3.pack( 0, &vremap );
+	cout << "tree3 after pack: " << endl << tree3 << "root: " << tree3.root()
+		 << ", parents: ";
+	for( int i = 0; i < tree3.size(); ++i ) {
+		cout << tree3.parent_byi( i ) << " ";
+	}
+	cout << endl << "remap: ";
+	for( size_t k = 0; k < vremap.size(); ++k ) {
+		cout << vremap[k] << " ";
+	}
+	cout << endl;
+
 	return 0;
 }
@@ -0,0 +1,144 @@
+/*@copyright
+
+Copyright (c) 2012 Aiguo Fei
+All rights reserved.
+
+Permission to use and re-distribute this code in source and binary forms
+with or without modifications is therefore granted provided that
+the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Information regarding where to obtain the original source code must be
+      included with the redistrbution.
+
+*NO WARRANTY*
+THIS CODE OR PROGRAM IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S)
+"AS IS" WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE. THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S) MUST NOT BE
+HELD RESPONSIBLE FOR ANY DAMAGE OR UNDESIRED EFFECT CAUSED DIRECTLY OR
+INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
+
+*/
+
+
+
+
+/* t_ugraph.cpp
+
+  test CuGraph (ugraph.h): links stored once, seen from both ends;
+  algorithms give the same distances as on a symmetric CGraph.
+
+*/
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+
+#include "afl/util_tl.hpp"
+
+#include "afgraph/graph.h"
+#include "afgraph/ugraph.h"
+#include "afgraph/gtypes.h"
+#include "afgraph/graph_gen.h"
+#include "afgraph/graph_input.h"
+#include "afgraph/graph_alg.h"
+#include "afgraph/shortest_path.h"
+
+using namespace std;
+using namespace afg;
+
+int main()
+{
+	typedef CuGraph<char, int> UT;
+
+	UT ug( 4, 'z' );
+	ug.insert_v( 'a' );
+	ug.insert_v( 'b' );
+	ug.insert_v( 'c' );
+	ug.insert_v( 'd' );
+	ug.insert_v( 'e' );
+	ug.insert_2e( 'a', 'b', 2 );
+	ug.insert_2e( 'b', 'c', 3 );
+	ug.insert_2e( 'c', 'd', 4 );
+	ug.insert_2e( 'd', 'a', 5 );
+	ug.insert_e( 'c', 'a', 9 );
+	ug.insert_2e( 'e', 'e', 1 ); // self loop
+	ug.insert_2e( 'b', 'a', 7 ); // replaces (a, b)
+	cout << "graph: size " << ug.size() << ", range " << ug.range()
+		 << ", links " << ug.n_links() << endl << ug;
+	cout << "edge a-b: " << *ug.get_edge( 'a', 'b' ) << ", b-a: "
+		 << *ug.get_edge( 'b', 'a' ) << ", same data: "
+		 << ( ug.get_edge( 'a', 'b' ) == ug.get_edge( 'b', 'a' ) )
+		 << ", b-d exists: " << ( ug.get_edge( 'b', 'd' ) != NULL ) << endl;
+
+	// bulk weight update through the links
+	int k;
+	for( k = 0; k < ug.n_links(); ++k ) {
+		ug.link( k ).edge *= 10;
+	}
+	cout << "weights x10: " << endl << ug;
+
+	ug.remove_2e( 'a', 'd' );
+	ug.remove_e( 'c', 'b' );
+	cout << "removed a-d, b-c: " << ug.n_links() << " links" << endl << ug;
+	ug.remove_v( 'a' );
+	ug.insert_v( 'f' );
+	ug.insert_2e( 'f', 'c', 8 );
+	cout << "removed a, added f: " << ug.n_links() << " links" << endl << ug;
+	vector<int> vremap;
+	ug.remove_v( 'b' );
+	ug.pack( 0, &vremap );
+	cout << "after pack, remap:";
+	for( k = 0; k < ( int )vremap.size(); ++k ) {
+		cout << " " << vremap[k];
+	}
+	cout << endl << ug;
+
+	// a grid as CuGraph and as CGraph
+	CuGraph<xyVertex<int>, int> ugrid( 20, xyVertex<int>( -1, -1 ) );
+	T_xynGraph grid( 20, xyVertex<int>( -1, -1 ) );
+	grid_graph_gen( ugrid, 5, 4 );
+	grid_graph_gen( grid, 5, 4 );
+	cout << "grid: " << ugrid.size() << " nodes, " << ugrid.n_links() << " links, "
+		 << "cost " << graph_cost( ugrid, afl::pointer2value<int>() ) << " "
+		 << graph_cost( grid, afl::pointer2value<int>() ) << ", connected "
+		 << is_connected( ugrid ) << endl;
+	vector<int> vpred, vdist, vpred2, vdist2;
+	dijkstra( ugrid, 0, afl::pointer2value<int>(), 1000, vpred, vdist );
+	dijkstra( grid, 0, afl::pointer2value<int>(), 1000, vpred2, vdist2 );
+	cout << "grid dijkstra, same distances: " << ( vdist == vdist2 ) << endl;
+
+	// graph input: each link in both directions goes to one link
+	CuGraph<string, int> umb( 10, "" );
+	CGraph<string, int> mb( 10, "" );
+	ifstream fs1( "mbone-us-199405.vve" ), fs2( "mbone-us-199405.vve" );
+	if( fs1 && fs2 ) {
+		input_gra_vve< CuGraph<string, int>, string >( umb, fs1 );
+		input_gra_vve< CGraph<string, int>, string >( mb, fs2 );
+		int ne = 0;
+		bool bok = true;
+		for( k = 0; k < mb.range(); ++k ) {
+			ne += mb[k].out_degree();
+			bok = bok && ( umb.out_degree( k ) == mb[k].out_degree() );
+			for( CGraph<string, int>::const_e_iterator it = mb.e_begin( k );
+				 it != mb.e_end( k ); ++it ) {
+				const int *pe = umb.get_edge_byi( k, ( *it ).to() );
+				bok = bok && pe != NULL && *pe == ( *it ).edge_d();
+			}
+		}
+		cout << "mbone: " << umb.size() << " nodes, " << umb.n_links()
+			 << " links, CGraph edges " << ne << ", same links: " << bok << endl;
+		dijkstra( umb, 0, afl::pointer2value<int>(), 100000, vpred, vdist );
+		dijkstra( mb, 0, afl::pointer2value<int>(), 100000, vpred2, vdist2 );
+		cout << "mbone dijkstra, same distances: " << ( vdist == vdist2 ) << endl;
+	} else {
+		cout << "failed to open graph data file: mbone-us-199405.vve" << endl;
+	}
+
+	return 0;
+}
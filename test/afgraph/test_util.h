@@ -0,0 +1,67 @@
+/*@copyright
+
+Copyright (c) 2012 Aiguo Fei
+All rights reserved.
+
+Permission to use and re-distribute this code in source and binary forms
+with or without modifications is therefore granted provided that
+the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Information regarding where to obtain the original source code must be
+      included with the redistrbution.
+
+*NO WARRANTY*
+THIS CODE OR PROGRAM IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S)
+"AS IS" WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING,
+BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE. THE COPYRIGHT HOLDER(S) AND CONTRIBUTOR(S) MUST NOT BE
+HELD RESPONSIBLE FOR ANY DAMAGE OR UNDESIRED EFFECT CAUSED DIRECTLY OR
+INDIRECTLY BY USE, MISUSE OR ABUSE OF THIS CODE OR PROGRAM.
+
+*/
+
+
+
+/* test_util.h
+
+  helpers shared by the test programs: a reproducible random graph
+  generator.
+
+*/
+
+#ifndef _AFG_TEST_UTIL_H_
+#define _AFG_TEST_UTIL_H_
+
+/** generate a random directed graph of n nodes, node i at index i, then
+  remove nodes 3, 20, 37, ... (every 17th). m edges u->v are drawn by a
+  linear congruential generator from seed r, so the graph is the same on
+  every platform; parallel edges are kept, self loops only if bloops.
+  Weights are within [0, maxw - 1].
+*/
+template<class GraphT>
+void test_random_graph( GraphT &g, int n, int m, int maxw, unsigned long long r,
+						bool bloops = true )
+{
+	g.clear();
+	for( int i = 0; i < n; ++i ) {
+		g.insert_v_ati( i, i );
+	}
+	for( int k = 0; k < m; ++k ) {
+		r = r * 6364136223846793005ULL + 1442695040888963407ULL;
+		int u = ( int )(( r >> 33 ) % n );
+		r = r * 6364136223846793005ULL + 1442695040888963407ULL;
+		int v = ( int )(( r >> 33 ) % n );
+		if( bloops || u != v ) {
+			g.insert_e_byi( u, v, ( typename GraphT::EDT )(( r >> 20 ) % maxw ) );
+		}
+	}
+	for( int i = 3; i < n; i += 17 ) {
+		g.remove_v_byi( i );
+	}
+}
+
+#endif